@@ -13,6 +13,9 @@
 #include <librevenge/librevenge.h>
 #include <librevenge-stream/librevenge-stream.h>
 
+#include "DRAWIOHeader.h"
+#include "DRAWIOOptions.h"
+
 #ifdef DLL_EXPORT
 #ifdef LIBDRAWIO_BUILD
 #define DRAWIOAPI __declspec(dllexport)
@@ -56,7 +59,12 @@ public:
     RESULT_PASSWORD_MISMATCH, //< problem with given password
     RESULT_UNSUPPORTED_ENCRYPTION, //< unsupported encryption
     RESULT_UNSUPPORTED_FORMAT, //< unsupported file format
-    RESULT_UNKNOWN_ERROR //< an unspecified error
+    RESULT_UNKNOWN_ERROR, //< an unspecified error
+    RESULT_INPUT_TOO_LARGE, //< DRAWIOLimits::maxInputBytes exceeded
+    RESULT_TOO_MANY_CELLS, //< DRAWIOLimits::maxCellsPerPage exceeded
+    RESULT_TOO_MANY_POINTS, //< DRAWIOLimits::maxPointsPerArray exceeded
+    RESULT_LABEL_TOO_LARGE, //< DRAWIOLimits::maxLabelBytes exceeded
+    RESULT_TIME_LIMIT_EXCEEDED //< DRAWIOLimits::maxTime exceeded
   };
 
   /** Type of document.
@@ -79,6 +87,54 @@ public:
   static DRAWIOAPI Confidence isSupported(librevenge::RVNGInputStream *input, Type *type = 0);
   static DRAWIOAPI Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *document, const char *password = 0);
   static DRAWIOAPI Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *document, Type type, const char *password = 0);
+
+  /** Parse the document once and send the result to each of the \c count painters in \c documents.
+    */
+  static DRAWIOAPI Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *const *documents, unsigned count, const char *password = 0);
+
+  /** Parse the document with non-default \c options.
+    */
+  static DRAWIOAPI Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *document, const DRAWIOOptions &options);
+  static DRAWIOAPI Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *const *documents, unsigned count, const DRAWIOOptions &options);
+
+  /** Convert the document straight to SVG, one document per page in \c output.
+    *
+    * The result matches parsing into librevenge's SVG generator, but the
+    * markup is written without building property lists.
+    */
+  static DRAWIOAPI Result parseToSVG(librevenge::RVNGInputStream *input, librevenge::RVNGStringVector &output);
+
+  /** Convert the document straight to SVG with non-default \c options.
+    *
+    * The limits, statistics and tracing apply as they do to parse();
+    * the cache directory is not used, as the cache records painter calls.
+    */
+  static DRAWIOAPI Result parseToSVG(librevenge::RVNGInputStream *input, librevenge::RVNGStringVector &output, const DRAWIOOptions &options);
+
+  /** Read the mxfile attributes without converting the document.
+    *
+    * If \c diagrams is true, the id, name and a content hash of every
+    * diagram are read too, which means scanning the whole file.
+    */
+  static DRAWIOAPI Result readHeader(librevenge::RVNGInputStream *input, DRAWIOHeader &header, bool diagrams = false);
+
+  /** Whether a result converted from the file described by \c previous is still valid for \c header.
+    *
+    * Files are compared by etag, or by their diagram hashes if either has no etag.
+    */
+  static DRAWIOAPI bool isUnchanged(const DRAWIOHeader &header, const DRAWIOHeader &previous);
+
+  /** Whether the page converted from the diagram of \c previous with the same id as diagram \c index of \c header is still valid.
+    */
+  static DRAWIOAPI bool isDiagramUnchanged(const DRAWIOHeader &header, unsigned index, const DRAWIOHeader &previous);
+
+  /** SHA-256 of the whole input, in 64 lowercase hex digits.
+    *
+    * Unlike the diagram hashes of the header, collisions cannot
+    * practically be made, so it can key converted results of untrusted
+    * documents.
+    */
+  static DRAWIOAPI librevenge::RVNGString getDigest(librevenge::RVNGInputStream *input);
 };
 
 } // namespace libdrawio
@@ -0,0 +1,65 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDED_LIBDRAWIO_DRAWIOHEADER_H
+#define INCLUDED_LIBDRAWIO_DRAWIOHEADER_H
+
+#include <vector>
+
+#include <librevenge/librevenge.h>
+
+namespace libdrawio
+{
+
+/** Identity of one diagram (page) of a file.
+  */
+struct DRAWIODiagramInfo
+{
+  DRAWIODiagramInfo()
+    : id()
+    , name()
+    , hash(0)
+  {
+  }
+
+  librevenge::RVNGString id;
+  librevenge::RVNGString name;
+  /** Hash of the diagram content, 0 if it was not computed.
+    */
+  unsigned long long hash;
+};
+
+/** Attributes of the mxfile element, as read by DRAWIODocument::readHeader.
+  *
+  * All fields are plain values, so a header can be stored next to a
+  * converted result and compared with a fresh one later.
+  */
+struct DRAWIOHeader
+{
+  DRAWIOHeader()
+    : etag()
+    , modified()
+    , version()
+    , diagrams()
+  {
+  }
+
+  librevenge::RVNGString etag;
+  librevenge::RVNGString modified;
+  librevenge::RVNGString version;
+  /** Diagrams in document order; only filled in on request.
+    */
+  std::vector<DRAWIODiagramInfo> diagrams;
+};
+
+} // namespace libdrawio
+
+#endif // INCLUDED_LIBDRAWIO_DRAWIOHEADER_H
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDED_LIBDRAWIO_DRAWIOINCREMENTALDOCUMENT_H
+#define INCLUDED_LIBDRAWIO_DRAWIOINCREMENTALDOCUMENT_H
+
+#include <memory>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "DRAWIODocument.h"
+#include "DRAWIOLimits.h"
+
+namespace libdrawio
+{
+
+struct DRAWIOIncrementalState;
+
+/** Converter for successive revisions of one document.
+  *
+  * The layout of every cell of the last revision is kept. Cells of the
+  * next revision are matched to it by page and cell id, and only those
+  * whose value, style or geometry changed, together with the edges and
+  * children attached to them, are laid out again. Cells moved by an
+  * insertion or deletion before them keep their layout too, and only the
+  * styles that changed are parsed again.
+  */
+class DRAWIOAPI DRAWIOIncrementalDocument
+{
+public:
+  DRAWIOIncrementalDocument();
+  ~DRAWIOIncrementalDocument();
+
+  /** Convert the next revision of the document and send all of it to \c document.
+    */
+  DRAWIODocument::Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *document);
+
+  /** Convert the next revision of the document within \c limits, as
+    * DRAWIODocument::parse does with DRAWIOOptions::limits.
+    *
+    * If a limit is exceeded, the matching result is returned and the
+    * previous revision is kept for the next call.
+    */
+  DRAWIODocument::Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *document, const DRAWIOLimits &limits);
+
+  /** Number of cells laid out by the last call to parse().
+    */
+  unsigned getLayoutCount() const;
+
+  /** Forget the previous revision.
+    */
+  void reset();
+
+private:
+  DRAWIOIncrementalDocument(const DRAWIOIncrementalDocument &);
+  DRAWIOIncrementalDocument &operator=(const DRAWIOIncrementalDocument &);
+
+  std::unique_ptr<DRAWIOIncrementalState> m_state;
+};
+
+} // namespace libdrawio
+
+#endif // INCLUDED_LIBDRAWIO_DRAWIOINCREMENTALDOCUMENT_H
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,53 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDED_LIBDRAWIO_DRAWIOLIMITS_H
+#define INCLUDED_LIBDRAWIO_DRAWIOLIMITS_H
+
+namespace libdrawio
+{
+
+/** Bounds on the resources one conversion may use, for documents that
+  * are not trusted.
+  *
+  * They are checked while the document is read, and the conversion is
+  * abandoned with the matching DRAWIODocument::Result as soon as one is
+  * exceeded. 0 means no limit, which is the default for all of them.
+  */
+struct DRAWIOLimits
+{
+  DRAWIOLimits()
+    : maxInputBytes(0)
+    , maxCellsPerPage(0)
+    , maxPointsPerArray(0)
+    , maxLabelBytes(0)
+    , maxTime(0)
+  {
+  }
+
+  /** Bytes of the document, as read from the stream.
+    */
+  unsigned long maxInputBytes;
+  unsigned long maxCellsPerPage;
+  /** Waypoints in the points array of one geometry.
+    */
+  unsigned long maxPointsPerArray;
+  /** Bytes of the UTF-8 label (value attribute) of one cell.
+    */
+  unsigned long maxLabelBytes;
+  /** Wall time of the whole conversion, in seconds.
+    */
+  double maxTime;
+};
+
+} // namespace libdrawio
+
+#endif // INCLUDED_LIBDRAWIO_DRAWIOLIMITS_H
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
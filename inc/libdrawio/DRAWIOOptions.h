@@ -0,0 +1,65 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDED_LIBDRAWIO_DRAWIOOPTIONS_H
+#define INCLUDED_LIBDRAWIO_DRAWIOOPTIONS_H
+
+#include "DRAWIOLimits.h"
+
+namespace libdrawio
+{
+
+struct DRAWIOStatistics;
+
+/** Optional settings for DRAWIODocument::parse.
+  */
+struct DRAWIOOptions
+{
+  DRAWIOOptions()
+    : cacheDirectory(0)
+    , statistics(0)
+    , traceFile(0)
+    , traceThreshold(100)
+    , limits()
+  {
+  }
+
+  /** Directory in which converted documents are cached, keyed by a hash of
+    * the input and the library version. 0 disables the cache.
+    */
+  const char *cacheDirectory;
+
+  /** Receives the timings, counters and peak memory of the conversion,
+    * which are only measured if this is set. Documents replayed from the
+    * cache are only timed, as nothing else is done for them.
+    */
+  DRAWIOStatistics *statistics;
+
+  /** File to write a Chrome trace_event trace of the conversion to, for
+    * chrome://tracing or Perfetto. It has spans for the document, the XML
+    * read loop, each page and the edges whose routing is slow, named by
+    * their ids. 0 falls back to the DRAWIO_TRACE environment variable;
+    * nothing is traced if neither is set.
+    */
+  const char *traceFile;
+
+  /** Time in microseconds an edge takes to route before it is traced.
+    */
+  unsigned traceThreshold;
+
+  /** Bounds on the resources the conversion may use.
+    */
+  DRAWIOLimits limits;
+};
+
+} // namespace libdrawio
+
+#endif // INCLUDED_LIBDRAWIO_DRAWIOOPTIONS_H
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,147 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDED_LIBDRAWIO_DRAWIOSTATISTICS_H
+#define INCLUDED_LIBDRAWIO_DRAWIOSTATISTICS_H
+
+namespace libdrawio
+{
+
+/** Timings and counters of one conversion.
+  *
+  * Filled in by DRAWIODocument::parse when DRAWIOOptions::statistics
+  * points to it. Nothing is measured otherwise.
+  */
+struct DRAWIOStatistics
+{
+  /** Parts of a conversion. The time of a phase does not include the
+    * phases nested in it, so the times add up to the whole conversion.
+    */
+  enum Phase
+  {
+    PHASE_READ, //< reading the XML, libxml2 included
+    PHASE_STYLE, //< parsing cell styles
+    PHASE_ROUTE, //< resolving the end points and waypoints of edges
+    PHASE_LAYOUT, //< laying the pages out into painter calls
+    PHASE_EMIT, //< calling the painters
+    PHASE_COUNT
+  };
+
+  /** What the memory held by a conversion is used for.
+    */
+  enum Memory
+  {
+    MEMORY_XML, //< the libxml2 reader, estimated
+    MEMORY_CELLS, //< cells, in the pages and the id map
+    MEMORY_STYLES, //< style strings and parsed styles of the cells
+    MEMORY_POINTS, //< waypoints of the cells
+    MEMORY_PROPERTIES, //< property lists and paths of the display list
+    MEMORY_COUNT
+  };
+
+  DRAWIOStatistics()
+    : bytesRead(0)
+    , xmlNodes(0)
+    , cells(0)
+    , edges(0)
+    , styles(0)
+    , routingIterations(0)
+    , pathSteps(0)
+    , painterCalls(0)
+    , peakMemory(0)
+  {
+    for (unsigned i = 0; i < PHASE_COUNT; ++i)
+      time[i] = 0;
+    for (unsigned i = 0; i < MEMORY_COUNT; ++i)
+    {
+      memory[i] = 0;
+      peakMemoryOf[i] = 0;
+    }
+  }
+
+  static const char *getPhaseName(const Phase phase)
+  {
+    switch (phase)
+    {
+    case PHASE_READ:
+      return "read";
+    case PHASE_STYLE:
+      return "style";
+    case PHASE_ROUTE:
+      return "route";
+    case PHASE_LAYOUT:
+      return "layout";
+    case PHASE_EMIT:
+      return "emit";
+    default:
+      return "";
+    }
+  }
+
+  static const char *getMemoryName(const Memory memory)
+  {
+    switch (memory)
+    {
+    case MEMORY_XML:
+      return "xml";
+    case MEMORY_CELLS:
+      return "cells";
+    case MEMORY_STYLES:
+      return "styles";
+    case MEMORY_POINTS:
+      return "points";
+    case MEMORY_PROPERTIES:
+      return "properties";
+    default:
+      return "";
+    }
+  }
+
+  /** Wall time of each phase, in seconds.
+    */
+  double time[PHASE_COUNT];
+  unsigned long long bytesRead;
+  unsigned long long xmlNodes;
+  unsigned long long cells;
+  unsigned long long edges;
+  /** Distinct style strings.
+    */
+  unsigned long long styles;
+  /** Steps taken by the orthogonal edge router.
+    */
+  unsigned long long routingIterations;
+  /** Path steps (move, line, curve, close) in the drawn shapes.
+    */
+  unsigned long long pathSteps;
+  /** Calls made to the painters, all of them together.
+    */
+  unsigned long long painterCalls;
+
+  /** Most bytes held by the library at once during the conversion.
+    *
+    * Containers are accounted for by their size when they change, so this
+    * is an estimate of the heap use rather than a count of allocations.
+    * The XML reader is estimated from its read-ahead input and the depth
+    * of the current node.
+    */
+  unsigned long long peakMemory;
+  /** Bytes held in each category when peakMemory was reached.
+    */
+  unsigned long long memory[MEMORY_COUNT];
+  /** Most bytes held in each category at once, not necessarily at the
+    * same time.
+    */
+  unsigned long long peakMemoryOf[MEMORY_COUNT];
+};
+
+} // namespace libdrawio
+
+#endif // INCLUDED_LIBDRAWIO_DRAWIOSTATISTICS_H
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
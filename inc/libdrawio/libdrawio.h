@@ -11,6 +11,11 @@
 #define INCLUDED_LIBDRAWIO_LIBDRAWIO_H
 
 #include "DRAWIODocument.h"
+#include "DRAWIOHeader.h"
+#include "DRAWIOIncrementalDocument.h"
+#include "DRAWIOLimits.h"
+#include "DRAWIOOptions.h"
+#include "DRAWIOStatistics.h"
 
 #endif // INCLUDED_LIBDRAWIO_LIBDRAWIO_H
 
@@ -0,0 +1,451 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "DiagramGenerator.h"
+
+namespace bench
+{
+
+namespace
+{
+
+// splitmix64, so that the output is the same with every standard library
+class Random
+{
+public:
+  explicit Random(unsigned long long seed)
+    : m_state(seed)
+  {
+  }
+
+  uint64_t next()
+  {
+    uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  unsigned below(unsigned bound)
+  {
+    return bound ? unsigned(next() % bound) : 0;
+  }
+
+private:
+  uint64_t m_state;
+};
+
+struct Placement
+{
+  double x, y; //< absolute
+  double width, height;
+};
+
+const char *const PALETTE[] =
+{
+  "#dae8fc", "#d5e8d4", "#ffe6cc", "#fff2cc", "#f8cecc", "#e1d5e7", "#f5f5f5", "#ffffff"
+};
+
+const char *const STROKES[] =
+{
+  "#6c8ebf", "#82b366", "#d79b00", "#d6b656", "#b85450", "#9673a6", "#666666", "#000000"
+};
+
+const double ANCHORS[] = { 0, 0.25, 0.5, 0.75, 1 };
+
+std::string shapeStyle(const std::string &shape)
+{
+  if (shape == "rectangle")
+    return "rounded=0;whiteSpace=wrap;html=1;";
+  if (shape == "ellipse" || shape == "triangle" || shape == "rhombus")
+    return shape + ";whiteSpace=wrap;html=1;";
+
+  std::string style = "shape=" + shape + ";whiteSpace=wrap;html=1;";
+  const char *const perimeters[][2] =
+  {
+    { "callout", "calloutPerimeter" },
+    { "parallelogram", "parallelogramPerimeter" },
+    { "hexagon", "hexagonPerimeter2" },
+    { "step", "stepPerimeter" },
+    { "trapezoid", "trapezoidPerimeter" }
+  };
+  for (const auto &perimeter : perimeters)
+  {
+    if (shape == perimeter[0])
+      style += std::string("perimeter=") + perimeter[1] + ";";
+  }
+  return style;
+}
+
+std::string variantStyle(unsigned variant)
+{
+  std::string style = "fillColor=";
+  style += PALETTE[variant % 8];
+  style += ";strokeColor=";
+  style += STROKES[(variant / 8) % 8];
+  style += ";fontSize=" + std::to_string(10 + variant % 7) + ";";
+  if (variant % 5 == 4)
+    style += "rotation=" + std::to_string(15 * (variant % 3 + 1)) + ";";
+  return style;
+}
+
+std::string number(double value)
+{
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%g", value);
+  return buffer;
+}
+
+void appendEscaped(std::string &out, const std::string &text)
+{
+  for (const char c : text)
+  {
+    switch (c)
+    {
+    case '&':
+      out += "&amp;";
+      break;
+    case '<':
+      out += "&lt;";
+      break;
+    case '>':
+      out += "&gt;";
+      break;
+    case '"':
+      out += "&quot;";
+      break;
+    default:
+      out += c;
+    }
+  }
+}
+
+void appendAnchor(std::string &style, const char *prefix, Random &random)
+{
+  style += prefix;
+  style += "X=" + number(ANCHORS[random.below(5)]) + ";";
+  style += prefix;
+  style += "Y=" + number(ANCHORS[random.below(5)]) + ";";
+  style += prefix;
+  style += "Dx=0;";
+  style += prefix;
+  style += "Dy=0;";
+}
+
+std::string generateModel(const GeneratorOptions &options, unsigned page, Random &random)
+{
+  const std::vector<std::string> &shapes = options.shapes.empty() ? getKnownShapes() : options.shapes;
+  const unsigned styles = std::max(1u, options.styles);
+  const unsigned run = options.depth + 1;
+  const unsigned runs = (options.vertices + run - 1) / run;
+  const unsigned columns = std::max(1u, unsigned(std::ceil(std::sqrt(double(runs)))));
+  const double cellWidth = 240;
+  const double cellHeight = 180;
+  const double pageWidth = std::max(827.0, columns * cellWidth + 40);
+  const double pageHeight = std::max(1169.0, ((runs + columns - 1) / columns) * cellHeight + 40);
+  const std::string prefix = std::to_string(page + 1) + "-";
+
+  std::string xml = "<mxGraphModel dx=\"1350\" dy=\"949\" grid=\"1\" gridSize=\"10\" guides=\"1\""
+                    " tooltips=\"1\" connect=\"1\" arrows=\"1\" fold=\"1\" page=\"1\" pageScale=\"1\""
+                    " pageWidth=\"" + number(pageWidth) + "\" pageHeight=\"" + number(pageHeight) + "\""
+                    " math=\"0\" shadow=\"0\"><root><mxCell id=\"0\" /><mxCell id=\"1\" parent=\"0\" />";
+
+  std::vector<Placement> placements;
+  placements.reserve(options.vertices);
+  for (unsigned i = 0; i < options.vertices; ++i)
+  {
+    const unsigned level = i % run;
+    Placement placement;
+    double x, y;
+    std::string parent = "1";
+    if (level == 0)
+    {
+      const unsigned slot = i / run;
+      x = 20 + (slot % columns) * cellWidth;
+      y = 20 + (slot / columns) * cellHeight;
+      placement.width = 160;
+      placement.height = 100;
+      placement.x = x;
+      placement.y = y;
+    }
+    else
+    {
+      // inside the previous vertex, relative to it
+      const Placement &outer = placements.back();
+      x = 10;
+      y = 20;
+      placement.width = std::max(40.0, outer.width - 20);
+      placement.height = std::max(30.0, outer.height - 15);
+      placement.x = outer.x + x;
+      placement.y = outer.y + y;
+      parent = "v" + prefix + std::to_string(i - 1);
+    }
+    placements.push_back(placement);
+
+    std::string value;
+    if (options.labels)
+      value = "Node " + std::to_string(i + 1);
+    xml += "<mxCell id=\"v" + prefix + std::to_string(i) + "\" value=\"";
+    appendEscaped(xml, value);
+    xml += "\" style=\"" + shapeStyle(shapes[random.below(unsigned(shapes.size()))])
+           + variantStyle(random.below(styles)) + "\" parent=\"" + parent + "\" vertex=\"1\">";
+    xml += "<mxGeometry x=\"" + number(x) + "\" y=\"" + number(y) + "\" width=\"" + number(placement.width)
+           + "\" height=\"" + number(placement.height) + "\" as=\"geometry\" /></mxCell>";
+  }
+
+  for (unsigned i = 0; i < options.edges; ++i)
+  {
+    std::string style;
+    switch (random.below(4))
+    {
+    case 0:
+      style = "rounded=0;orthogonalLoop=1;jettySize=auto;html=1;";
+      break;
+    default:
+      style = "edgeStyle=orthogonalEdgeStyle;rounded=0;orthogonalLoop=1;jettySize=auto;html=1;";
+    }
+    if (random.below(2))
+      appendAnchor(style, "exit", random);
+    if (random.below(2))
+      appendAnchor(style, "entry", random);
+
+    xml += "<mxCell id=\"e" + prefix + std::to_string(i) + "\" style=\"" + style + "\" parent=\"1\"";
+    Placement from = { 0, 0, 0, 0 };
+    Placement to = { 200, 200, 0, 0 };
+    if (options.vertices)
+    {
+      const unsigned source = random.below(options.vertices);
+      unsigned target = random.below(options.vertices);
+      if (target == source && options.vertices > 1)
+        target = (target + 1) % options.vertices;
+      from = placements[source];
+      to = placements[target];
+      xml += " source=\"v" + prefix + std::to_string(source) + "\" target=\"v" + prefix + std::to_string(target) + "\"";
+    }
+    xml += " edge=\"1\"><mxGeometry relative=\"1\" as=\"geometry\">";
+    if (!options.vertices)
+    {
+      xml += "<mxPoint x=\"" + number(from.x) + "\" y=\"" + number(from.y) + "\" as=\"sourcePoint\" />";
+      xml += "<mxPoint x=\"" + number(to.x) + "\" y=\"" + number(to.y) + "\" as=\"targetPoint\" />";
+    }
+    if (options.waypoints)
+    {
+      // evenly spread between the centres of the ends, zigzagging around the line
+      const double x0 = from.x + from.width / 2;
+      const double y0 = from.y + from.height / 2;
+      const double x1 = to.x + to.width / 2;
+      const double y1 = to.y + to.height / 2;
+      xml += "<Array as=\"points\">";
+      for (unsigned j = 0; j < options.waypoints; ++j)
+      {
+        const double t = double(j + 1) / double(options.waypoints + 1);
+        const double offset = j % 2 ? 20 : -20;
+        xml += "<mxPoint x=\"" + number(std::round(x0 + (x1 - x0) * t)) + "\" y=\""
+               + number(std::round(y0 + (y1 - y0) * t + offset)) + "\" />";
+      }
+      xml += "</Array>";
+    }
+    xml += "</mxGeometry></mxCell>";
+  }
+
+  xml += "</root></mxGraphModel>";
+  return xml;
+}
+
+// encodeURIComponent
+std::string encodeURI(const std::string &text)
+{
+  static const char hex[] = "0123456789ABCDEF";
+  std::string out;
+  out.reserve(text.size() * 2);
+  for (const char c : text)
+  {
+    const unsigned char u = (unsigned char) c;
+    if ((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || strchr("-_.!~*'()", c))
+      out += c;
+    else
+    {
+      out += '%';
+      out += hex[u >> 4];
+      out += hex[u & 0xf];
+    }
+  }
+  return out;
+}
+
+// raw deflate made of stored blocks, which any inflater accepts
+std::string deflateStored(const std::string &data)
+{
+  std::string out;
+  size_t pos = 0;
+  do
+  {
+    const size_t len = std::min<size_t>(data.size() - pos, 0xffff);
+    const bool last = pos + len == data.size();
+    out += char(last ? 1 : 0);
+    out += char(len & 0xff);
+    out += char(len >> 8);
+    out += char(~len & 0xff);
+    out += char((~len >> 8) & 0xff);
+    out.append(data, pos, len);
+    pos += len;
+  }
+  while (pos < data.size());
+  return out;
+}
+
+std::string encodeBase64(const std::string &data)
+{
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  out.reserve((data.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < data.size(); i += 3)
+  {
+    const size_t left = data.size() - i;
+    uint32_t chunk = uint32_t((unsigned char) data[i]) << 16;
+    if (left > 1)
+      chunk |= uint32_t((unsigned char) data[i + 1]) << 8;
+    if (left > 2)
+      chunk |= uint32_t((unsigned char) data[i + 2]);
+    out += alphabet[(chunk >> 18) & 0x3f];
+    out += alphabet[(chunk >> 12) & 0x3f];
+    out += left > 1 ? alphabet[(chunk >> 6) & 0x3f] : '=';
+    out += left > 2 ? alphabet[chunk & 0x3f] : '=';
+  }
+  return out;
+}
+
+}
+
+GeneratorOptions::GeneratorOptions()
+  : vertices(100)
+  , edges(100)
+  , pages(1)
+  , waypoints(0)
+  , shapes()
+  , styles(8)
+  , depth(0)
+  , labels(true)
+  , compressed(false)
+  , seed(1)
+{
+}
+
+const std::vector<std::string> &getKnownShapes()
+{
+  static const std::vector<std::string> shapes =
+  {
+    "rectangle", "ellipse", "triangle", "rhombus", "callout", "process", "parallelogram",
+    "hexagon", "step", "trapezoid", "card", "internalStorage", "or", "xor", "document",
+    "tape", "dataStorage"
+  };
+  return shapes;
+}
+
+std::string generateDiagram(const GeneratorOptions &options)
+{
+  Random random(options.seed);
+  char etag[32];
+  snprintf(etag, sizeof(etag), "%016llx", (unsigned long long) Random(options.seed ^ 0x5eed).next());
+
+  std::string xml = "<mxfile host=\"libdrawio\" modified=\"2000-01-01T00:00:00.000Z\" agent=\"drawiogen\" etag=\"";
+  xml += etag;
+  xml += "\" compressed=\"";
+  xml += options.compressed ? "true" : "false";
+  xml += "\" version=\"21.6.8\" type=\"device\" pages=\"" + std::to_string(options.pages) + "\">\n";
+  for (unsigned page = 0; page < options.pages; ++page)
+  {
+    xml += "  <diagram id=\"page-" + std::to_string(page + 1) + "\" name=\"Page-" + std::to_string(page + 1) + "\">";
+    const std::string model = generateModel(options, page, random);
+    if (options.compressed)
+      xml += encodeBase64(deflateStored(encodeURI(model)));
+    else
+      xml += model;
+    xml += "</diagram>\n";
+  }
+  xml += "</mxfile>\n";
+  return xml;
+}
+
+const char *const GENERATOR_OPTION_HELP =
+  "\t--vertices N    vertices per page (default: 100)\n"
+  "\t--edges N       edges per page (default: 100)\n"
+  "\t--pages N       number of pages (default: 1)\n"
+  "\t--waypoints N   waypoints per edge (default: 0)\n"
+  "\t--shapes LIST   comma separated shapes to pick from (default: all)\n"
+  "\t--styles N      distinct styles per shape (default: 8)\n"
+  "\t--depth N       nesting depth of vertices (default: 0)\n"
+  "\t--no-labels     leave vertices without text\n"
+  "\t--compressed    deflate and base64 encode the diagrams\n"
+  "\t--seed N        seed of the random choices (default: 1)\n";
+
+bool parseGeneratorOption(GeneratorOptions &options, int argc, char *argv[], int &i)
+{
+  const char *const arg = argv[i];
+  const bool hasValue = i + 1 < argc;
+  unsigned *target = nullptr;
+  if (!strcmp(arg, "--vertices"))
+    target = &options.vertices;
+  else if (!strcmp(arg, "--edges"))
+    target = &options.edges;
+  else if (!strcmp(arg, "--pages"))
+    target = &options.pages;
+  else if (!strcmp(arg, "--waypoints"))
+    target = &options.waypoints;
+  else if (!strcmp(arg, "--styles"))
+    target = &options.styles;
+  else if (!strcmp(arg, "--depth"))
+    target = &options.depth;
+  else if (!strcmp(arg, "--no-labels"))
+  {
+    options.labels = false;
+    return true;
+  }
+  else if (!strcmp(arg, "--compressed"))
+  {
+    options.compressed = true;
+    return true;
+  }
+  else if (!strcmp(arg, "--seed") && hasValue)
+  {
+    options.seed = strtoull(argv[++i], nullptr, 10);
+    return true;
+  }
+  else if (!strcmp(arg, "--shapes") && hasValue)
+  {
+    options.shapes.clear();
+    const std::string list = argv[++i];
+    size_t start = 0;
+    for (size_t end = list.find(','); ; end = list.find(',', start))
+    {
+      const std::string shape = list.substr(start, end == std::string::npos ? std::string::npos : end - start);
+      if (!shape.empty())
+        options.shapes.push_back(shape);
+      if (end == std::string::npos)
+        break;
+      start = end + 1;
+    }
+    return true;
+  }
+  if (!target || !hasValue)
+    return false;
+  *target = unsigned(strtoul(argv[++i], nullptr, 10));
+  return true;
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
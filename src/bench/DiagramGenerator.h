@@ -0,0 +1,56 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DIAGRAMGENERATOR_H
+#define DIAGRAMGENERATOR_H
+
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+struct GeneratorOptions
+{
+  GeneratorOptions();
+
+  unsigned vertices; //< per page
+  unsigned edges; //< per page
+  unsigned pages;
+  unsigned waypoints; //< per edge
+  std::vector<std::string> shapes; //< style keywords to pick from, all known shapes if empty
+  unsigned styles; //< distinct styles per shape
+  unsigned depth; //< of vertices nested in other vertices
+  bool labels;
+  bool compressed; //< diagrams deflated and base64 encoded, like draw.io does
+  unsigned long long seed;
+};
+
+/* Writes an mxfile document with the requested mix of content.
+ *
+ * The output only depends on the options, so a document can be
+ * reproduced from its description alone.
+ */
+std::string generateDiagram(const GeneratorOptions &options);
+
+// the shapes used by default
+const std::vector<std::string> &getKnownShapes();
+
+/* Handles a generator option from the command line at argv[i], moving i
+ * past its argument. Returns false if it is not a generator option.
+ */
+bool parseGeneratorOption(GeneratorOptions &options, int argc, char *argv[], int &i);
+
+extern const char *const GENERATOR_OPTION_HELP;
+
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
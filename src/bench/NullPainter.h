@@ -0,0 +1,79 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef NULLPAINTER_H
+#define NULLPAINTER_H
+
+#include <librevenge/librevenge.h>
+
+namespace bench
+{
+
+/* Painter that ignores everything, so that only the library is measured.
+ */
+class NullPainter : public librevenge::RVNGDrawingInterface
+{
+public:
+  void startDocument(const librevenge::RVNGPropertyList &) override {}
+  void endDocument() override {}
+  void setDocumentMetaData(const librevenge::RVNGPropertyList &) override {}
+  void defineEmbeddedFont(const librevenge::RVNGPropertyList &) override {}
+  void startPage(const librevenge::RVNGPropertyList &) override {}
+  void endPage() override {}
+  void startMasterPage(const librevenge::RVNGPropertyList &) override {}
+  void endMasterPage() override {}
+  void startLayer(const librevenge::RVNGPropertyList &) override {}
+  void endLayer() override {}
+  void startEmbeddedGraphics(const librevenge::RVNGPropertyList &) override {}
+  void endEmbeddedGraphics() override {}
+  void openGroup(const librevenge::RVNGPropertyList &) override {}
+  void closeGroup() override {}
+  void setStyle(const librevenge::RVNGPropertyList &) override {}
+  void drawRectangle(const librevenge::RVNGPropertyList &) override {}
+  void drawEllipse(const librevenge::RVNGPropertyList &) override {}
+  void drawPolyline(const librevenge::RVNGPropertyList &) override {}
+  void drawPolygon(const librevenge::RVNGPropertyList &) override {}
+  void drawPath(const librevenge::RVNGPropertyList &) override {}
+  void drawGraphicObject(const librevenge::RVNGPropertyList &) override {}
+  void drawConnector(const librevenge::RVNGPropertyList &) override {}
+  void startTextObject(const librevenge::RVNGPropertyList &) override {}
+  void endTextObject() override {}
+  void startTableObject(const librevenge::RVNGPropertyList &) override {}
+  void openTableRow(const librevenge::RVNGPropertyList &) override {}
+  void closeTableRow() override {}
+  void openTableCell(const librevenge::RVNGPropertyList &) override {}
+  void closeTableCell() override {}
+  void insertCoveredTableCell(const librevenge::RVNGPropertyList &) override {}
+  void endTableObject() override {}
+  void insertTab() override {}
+  void insertSpace() override {}
+  void insertText(const librevenge::RVNGString &) override {}
+  void insertLineBreak() override {}
+  void insertField(const librevenge::RVNGPropertyList &) override {}
+  void openOrderedListLevel(const librevenge::RVNGPropertyList &) override {}
+  void openUnorderedListLevel(const librevenge::RVNGPropertyList &) override {}
+  void closeOrderedListLevel() override {}
+  void closeUnorderedListLevel() override {}
+  void openListElement(const librevenge::RVNGPropertyList &) override {}
+  void closeListElement() override {}
+  void defineParagraphStyle(const librevenge::RVNGPropertyList &) override {}
+  void openParagraph(const librevenge::RVNGPropertyList &) override {}
+  void closeParagraph() override {}
+  void defineCharacterStyle(const librevenge::RVNGPropertyList &) override {}
+  void openSpan(const librevenge::RVNGPropertyList &) override {}
+  void closeSpan() override {}
+  void openLink(const librevenge::RVNGPropertyList &) override {}
+  void closeLink() override {}
+};
+
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,227 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DRAWIOBase64.h"
+
+namespace
+{
+
+using libdrawio::Base64Decoder;
+
+typedef std::chrono::steady_clock Clock;
+
+const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// as much as DRAWIOImageCache decodes at once
+const unsigned long CHUNK_SIZE = 65536;
+
+int printUsage()
+{
+  printf("`base64bench' compares the base64 decoders used for embedded images.\n");
+  printf("\n");
+  printf("Usage: base64bench [OPTION]\n");
+  printf("\n");
+  printf("Random data is encoded and then decoded in chunks of 64 kB, as data URIs\n");
+  printf("are, by a naive decoder and by every kernel of Base64Decoder that this\n");
+  printf("build and CPU support. Results are written as JSON.\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t-s MB           size of the decoded data (default: 16)\n");
+  printf("\t-w N            break lines after N characters, 0 for none (default: 0)\n");
+  printf("\t-r N            repetitions (default: 5)\n");
+  printf("\t--seed N        seed of the random data (default: 1)\n");
+  printf("\t--help          show this help message\n");
+  return -1;
+}
+
+double since(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string encode(const std::vector<unsigned char> &data, unsigned lineWidth)
+{
+  std::string encoded;
+  const std::size_t size = (data.size() + 2) / 3 * 4;
+  encoded.reserve(lineWidth ? size + size / lineWidth : size);
+  unsigned column = 0;
+  for (std::size_t i = 0; i < data.size(); i += 3)
+  {
+    unsigned bits = unsigned(data[i]) << 16;
+    if (i + 1 < data.size())
+      bits |= unsigned(data[i + 1]) << 8;
+    if (i + 2 < data.size())
+      bits |= data[i + 2];
+    for (unsigned j = 0; j < 4; ++j)
+    {
+      if (j > 1 && i + j > data.size())
+        encoded += '=';
+      else
+        encoded += ALPHABET[(bits >> (18 - 6 * j)) & 0x3f];
+      if (lineWidth && ++column == lineWidth)
+      {
+        encoded += '\n';
+        column = 0;
+      }
+    }
+  }
+  return encoded;
+}
+
+// the textbook decoder: a search of the alphabet for every character
+bool decodeNaive(const std::string &encoded, std::vector<unsigned char> &out)
+{
+  out.clear();
+  unsigned bits = 0;
+  unsigned count = 0;
+  for (const char c : encoded)
+  {
+    if (c == '\n' || c == '\r' || c == ' ' || c == '\t')
+      continue;
+    if (c == '=')
+      break;
+    const char *const pos = strchr(ALPHABET, c);
+    if (!pos || !c)
+      return false;
+    bits = bits << 6 | unsigned(pos - ALPHABET);
+    if (++count == 4)
+    {
+      out.push_back((unsigned char)(bits >> 16));
+      out.push_back((unsigned char)(bits >> 8));
+      out.push_back((unsigned char) bits);
+      bits = 0;
+      count = 0;
+    }
+  }
+  if (count > 1)
+    out.push_back((unsigned char)(bits >> (6 * count - 8)));
+  if (count > 2)
+    out.push_back((unsigned char)(bits >> (6 * count - 16)));
+  return true;
+}
+
+bool decodeKernel(Base64Decoder::Kernel kernel, const std::string &encoded, std::vector<unsigned char> &out)
+{
+  Base64Decoder decoder(kernel);
+  std::vector<unsigned char> buffer(Base64Decoder::getMaxDecodedSize(CHUNK_SIZE));
+  out.clear();
+  for (std::size_t pos = 0; pos < encoded.size(); pos += CHUNK_SIZE)
+  {
+    const unsigned long length = (unsigned long) std::min<std::size_t>(CHUNK_SIZE, encoded.size() - pos);
+    const unsigned long decoded = decoder.decode(encoded.data() + pos, length, buffer.data());
+    if (decoder.failed())
+      return false;
+    out.insert(out.end(), buffer.begin(), buffer.begin() + decoded);
+  }
+  return decoder.finish();
+}
+
+struct Result
+{
+  const char *name;
+  std::vector<double> samples;
+};
+
+void printResult(const Result &result, double megabytes, bool last)
+{
+  std::vector<double> times = result.samples;
+  std::sort(times.begin(), times.end());
+  double sum = 0;
+  for (const double time : times)
+    sum += time;
+  const double median = times[times.size() / 2];
+  printf("    \"%s\": {\"min_ms\": %.3f, \"median_ms\": %.3f, \"mean_ms\": %.3f, \"mb_per_s\": %.1f}%s\n",
+         result.name, times.front(), median, sum / double(times.size()),
+         median > 0 ? megabytes * 1000 / median : 0.0, last ? "" : ",");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned megabytes = 16;
+  unsigned lineWidth = 0;
+  unsigned repetitions = 5;
+  unsigned long seed = 1;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "-s") && i + 1 < argc)
+      megabytes = std::max(1, atoi(argv[++i]));
+    else if (!strcmp(argv[i], "-w") && i + 1 < argc)
+      lineWidth = (unsigned) std::max(0, atoi(argv[++i]));
+    else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+      repetitions = std::max(1, atoi(argv[++i]));
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+      seed = strtoul(argv[++i], nullptr, 10);
+    else
+      return printUsage();
+  }
+
+  std::vector<unsigned char> data(std::size_t(megabytes) << 20);
+  std::mt19937 random((std::mt19937::result_type) seed);
+  for (auto &byte : data)
+    byte = (unsigned char) random();
+  const std::string encoded = encode(data, lineWidth);
+
+  std::vector<Result> results;
+  results.push_back(Result {"naive", std::vector<double>()});
+  std::vector<Base64Decoder::Kernel> kernels;
+  for (int kernel = Base64Decoder::KERNEL_SCALAR; kernel < Base64Decoder::KERNEL_COUNT; ++kernel)
+  {
+    if (Base64Decoder::isSupported(Base64Decoder::Kernel(kernel)))
+    {
+      kernels.push_back(Base64Decoder::Kernel(kernel));
+      results.push_back(Result {Base64Decoder::getKernelName(Base64Decoder::Kernel(kernel)), std::vector<double>()});
+    }
+  }
+
+  std::vector<unsigned char> out;
+  out.reserve(data.size());
+  // the first run only warms up
+  for (unsigned i = 0; i <= repetitions; ++i)
+  {
+    for (std::size_t j = 0; j < results.size(); ++j)
+    {
+      const Clock::time_point start = Clock::now();
+      const bool ok = j ? decodeKernel(kernels[j - 1], encoded, out) : decodeNaive(encoded, out);
+      const double time = since(start);
+      if (!ok || out != data)
+      {
+        fprintf(stderr, "ERROR: the %s decoder got the data wrong\n", results[j].name);
+        return 1;
+      }
+      if (i > 0)
+        results[j].samples.push_back(time);
+    }
+  }
+
+  printf("{\n");
+  printf("  \"decoded_bytes\": %lu,\n", (unsigned long) data.size());
+  printf("  \"encoded_bytes\": %lu,\n", (unsigned long) encoded.size());
+  printf("  \"line_width\": %u,\n", lineWidth);
+  printf("  \"repetitions\": %u,\n", repetitions);
+  printf("  \"best\": \"%s\",\n", Base64Decoder::getKernelName(Base64Decoder::getBestKernel()));
+  printf("  \"decoders\": {\n");
+  for (std::size_t j = 0; j < results.size(); ++j)
+    printResult(results[j], double(data.size()) / (1 << 20), j + 1 == results.size());
+  printf("  }\n");
+  printf("}\n");
+  return 0;
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,254 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "DRAWIOConnections.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOParser.h"
+#include "MXCell.h"
+
+#include "DiagramGenerator.h"
+#include "NullPainter.h"
+
+namespace
+{
+
+using libdrawio::DRAWIODisplayList;
+using libdrawio::DRAWIOParser;
+using libdrawio::MXCell;
+
+typedef std::chrono::steady_clock Clock;
+
+enum Phase
+{
+  PHASE_READ,
+  PHASE_SET_STYLE,
+  PHASE_SET_END_POINTS,
+  PHASE_SET_WAYPOINTS,
+  PHASE_LAYOUT,
+  PHASE_EMIT,
+  PHASE_TOTAL,
+  PHASE_COUNT
+};
+
+// read includes parsing the style of every cell, which setStyle repeats on its own
+const char *const PHASE_NAMES[PHASE_COUNT] =
+{
+  "read", "setStyle", "setEndPoints", "setWaypoints", "layout", "emit", "total"
+};
+
+int printUsage()
+{
+  printf("`drawiobench' times the phases of converting a draw.io diagram.\n");
+  printf("\n");
+  printf("Usage: drawiobench [OPTION] [FILE]\n");
+  printf("\n");
+  printf("Without FILE, a document is generated from the generator options.\n");
+  printf("The phases are: reading the XML (which parses styles too), setStyle,\n");
+  printf("setEndPoints and setWaypoints of every edge, laying out all cells into\n");
+  printf("a display list, emitting it to a null painter, and the whole conversion.\n");
+  printf("Results are written as JSON.\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("%s", bench::GENERATOR_OPTION_HELP);
+  printf("\t-r N            repetitions (default: 5)\n");
+  printf("\t--help          show this help message\n");
+  return -1;
+}
+
+double since(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool run(const std::string &data, std::vector<double> (&samples)[PHASE_COUNT], unsigned long &cellCount, unsigned long &edgeCount)
+{
+  const unsigned char *const bytes = reinterpret_cast<const unsigned char *>(data.data());
+  bench::NullPainter painter;
+
+  librevenge::RVNGStringStream input(bytes, (unsigned) data.size());
+  Clock::time_point start = Clock::now();
+  DRAWIOParser parser(&input, nullptr);
+  if (!parser.parseModel())
+    return false;
+  samples[PHASE_READ].push_back(since(start));
+
+  const std::map<librevenge::RVNGString, MXCell> &cells = parser.getCells();
+  std::vector<MXCell> copies;
+  std::vector<MXCell> edges;
+  copies.reserve(cells.size());
+  for (const auto &cell : cells)
+  {
+    copies.push_back(cell.second);
+    if (cell.second.edge)
+      edges.push_back(cell.second);
+  }
+  cellCount = copies.size();
+  edgeCount = edges.size();
+
+  // a fresh cache, so that images are decoded again as in a conversion
+  libdrawio::DRAWIOImageCache images;
+  start = Clock::now();
+  for (auto &cell : copies)
+    cell.setStyle(images);
+  samples[PHASE_SET_STYLE].push_back(since(start));
+
+  libdrawio::DRAWIOConnectionCache connections(cells);
+  start = Clock::now();
+  for (auto &edge : edges)
+    edge.setEndPoints(connections);
+  samples[PHASE_SET_END_POINTS].push_back(since(start));
+
+  start = Clock::now();
+  for (auto &edge : edges)
+    edge.setWaypoints(connections);
+  samples[PHASE_SET_WAYPOINTS].push_back(since(start));
+
+  DRAWIODisplayList list;
+  start = Clock::now();
+  list.append(DRAWIODisplayList::START_DOCUMENT);
+  int number = 0;
+  for (auto page : parser.getPages()) {
+    page.draw(list, cells, number);
+    number += (int)page.getCells().size();
+  }
+  list.append(DRAWIODisplayList::END_DOCUMENT);
+  samples[PHASE_LAYOUT].push_back(since(start));
+
+  start = Clock::now();
+  list.replay(&painter);
+  samples[PHASE_EMIT].push_back(since(start));
+
+  librevenge::RVNGStringStream again(bytes, (unsigned) data.size());
+  start = Clock::now();
+  DRAWIOParser full(&again, &painter);
+  if (!full.parseMain())
+    return false;
+  samples[PHASE_TOTAL].push_back(since(start));
+  return true;
+}
+
+void printString(const char *str)
+{
+  putchar('"');
+  for (; *str; ++str)
+  {
+    if (*str == '"' || *str == '\\')
+      putchar('\\');
+    if ((unsigned char) *str >= 0x20)
+      putchar(*str);
+  }
+  putchar('"');
+}
+
+void printGenerator(const bench::GeneratorOptions &options)
+{
+  printf("  \"generator\": {\"vertices\": %u, \"edges\": %u, \"pages\": %u, \"waypoints\": %u, "
+         "\"shapes\": %u, \"styles\": %u, \"depth\": %u, \"labels\": %s, \"compressed\": %s, \"seed\": %llu},\n",
+         options.vertices, options.edges, options.pages, options.waypoints,
+         unsigned(options.shapes.empty() ? bench::getKnownShapes().size() : options.shapes.size()),
+         options.styles, options.depth, options.labels ? "true" : "false",
+         options.compressed ? "true" : "false", options.seed);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  bench::GeneratorOptions options;
+  unsigned repetitions = 5;
+  const char *file = nullptr;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "-r") && i + 1 < argc)
+      repetitions = std::max(1, atoi(argv[++i]));
+    else if (bench::parseGeneratorOption(options, argc, argv, i))
+      continue;
+    else if (argv[i][0] == '-' || file)
+      return printUsage();
+    else
+      file = argv[i];
+  }
+
+  std::string data;
+  if (file)
+  {
+    std::ifstream in(file, std::ios::in | std::ios::binary);
+    if (!in)
+    {
+      fprintf(stderr, "ERROR: cannot read %s\n", file);
+      return 1;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    data = buffer.str();
+  }
+  else
+    data = bench::generateDiagram(options);
+
+  std::vector<double> samples[PHASE_COUNT];
+  unsigned long cells = 0;
+  unsigned long edges = 0;
+  // the first run only warms up
+  for (unsigned i = 0; i <= repetitions; ++i)
+  {
+    if (!run(data, samples, cells, edges))
+    {
+      fprintf(stderr, "ERROR: cannot parse the document\n");
+      return 1;
+    }
+    if (i == 0)
+    {
+      for (auto &phase : samples)
+        phase.clear();
+    }
+  }
+
+  printf("{\n");
+  if (file)
+  {
+    printf("  \"input\": ");
+    printString(file);
+    printf(",\n");
+  }
+  else
+    printGenerator(options);
+  printf("  \"bytes\": %lu,\n", (unsigned long) data.size());
+  printf("  \"cells\": %lu,\n", cells);
+  printf("  \"edges\": %lu,\n", edges);
+  printf("  \"repetitions\": %u,\n", repetitions);
+  printf("  \"phases\": {\n");
+  for (unsigned phase = 0; phase < PHASE_COUNT; ++phase)
+  {
+    std::vector<double> &times = samples[phase];
+    std::sort(times.begin(), times.end());
+    double sum = 0;
+    for (const double time : times)
+      sum += time;
+    printf("    \"%s\": {\"min_ms\": %.3f, \"median_ms\": %.3f, \"mean_ms\": %.3f}%s\n",
+           PHASE_NAMES[phase], times.front(), times[times.size() / 2], sum / double(times.size()),
+           phase + 1 < PHASE_COUNT ? "," : "");
+  }
+  printf("  }\n");
+  printf("}\n");
+  return 0;
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "DiagramGenerator.h"
+
+namespace
+{
+
+int printUsage()
+{
+  printf("`drawiogen' is a tool that writes synthetic draw.io diagrams.\n");
+  printf("\n");
+  printf("Usage: drawiogen [OPTION]\n");
+  printf("\n");
+  printf("The same options always give the same document.\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("%s", bench::GENERATOR_OPTION_HELP);
+  printf("\t-o FILE         write to FILE instead of standard output\n");
+  printf("\t--help          show this help message\n");
+  return -1;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  bench::GeneratorOptions options;
+  const char *output = nullptr;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "-o") && i + 1 < argc)
+      output = argv[++i];
+    else if (!bench::parseGeneratorOption(options, argc, argv, i))
+      return printUsage();
+  }
+
+  const std::string diagram = bench::generateDiagram(options);
+  FILE *const out = output ? fopen(output, "wb") : stdout;
+  if (!out)
+  {
+    fprintf(stderr, "ERROR: cannot write %s\n", output);
+    return 1;
+  }
+  const bool ok = fwrite(diagram.data(), 1, diagram.size(), out) == diagram.size();
+  if (output)
+    fclose(out);
+  return ok ? 0 : 1;
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,251 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "Batch.h"
+#include "CellCounter.h"
+
+namespace conv
+{
+
+namespace
+{
+
+bool makeDirectories(const std::string &path)
+{
+  for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+  {
+    if (mkdir(path.substr(0, pos).c_str(), 0777) != 0 && errno != EEXIST)
+      return false;
+  }
+  return true;
+}
+
+std::string outputPath(const Converter &converter, const Job &job, const std::string &outDir, unsigned index, unsigned count)
+{
+  std::string base = outDir.empty() ? job.path : outDir + "/" + job.relative;
+  const size_t slash = base.rfind('/');
+  const size_t dot = base.rfind('.');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    base.erase(dot);
+  if (count > 1)
+    base += "-" + std::to_string(index + 1);
+  return base + "." + converter.extension;
+}
+
+bool writeOutput(const std::string &path, const std::string &data)
+{
+  std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+  out.write(data.data(), std::streamsize(data.size()));
+  return bool(out);
+}
+
+void appendJSONString(std::string &out, const std::string &str)
+{
+  out += '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out += '\\';
+      out += c;
+    }
+    else if ((unsigned char) c < 0x20)
+    {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned) c);
+      out += escaped;
+    }
+    else
+      out += c;
+  }
+  out += '"';
+}
+
+}
+
+Settings::Settings()
+  : outDir()
+  , manifest()
+  , workers(std::thread::hardware_concurrency())
+  , isolate(false)
+  , timeout(60)
+  , maxRss(0)
+{
+}
+
+Outcome::Outcome()
+  : status("ok")
+  , signal(0)
+  , time(0)
+  , bytes(0)
+  , cells(0)
+  , peak(0)
+{
+}
+
+Reporter::Reporter(const std::string &manifest)
+  : m_mutex()
+  , m_manifest(nullptr)
+  , m_failedToOpen(false)
+  , m_files(0)
+  , m_failed(0)
+  , m_bytes(0)
+  , m_cells(0)
+{
+  if (!manifest.empty())
+  {
+    m_manifest = fopen(manifest.c_str(), "w");
+    m_failedToOpen = !m_manifest;
+  }
+}
+
+Reporter::~Reporter()
+{
+  if (m_manifest)
+    fclose(m_manifest);
+}
+
+bool Reporter::isOpen() const
+{
+  return !m_failedToOpen;
+}
+
+void Reporter::report(const Job &job, const Outcome &outcome)
+{
+  const double rate = outcome.time > 0 ? 1.0 / outcome.time : 0;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  printf("%s: %s %.2f ms %.2f MB/s %lu cells %.0f cells/s",
+         job.path.c_str(), outcome.status.c_str(), outcome.time * 1e3,
+         double(outcome.bytes) * rate / 1e6, outcome.cells, double(outcome.cells) * rate);
+  if (outcome.peak)
+    printf(" %lu kB peak", outcome.peak);
+  printf("\n");
+  fflush(stdout);
+
+  ++m_files;
+  if (outcome.status != "ok")
+    ++m_failed;
+  m_bytes += outcome.bytes;
+  m_cells += outcome.cells;
+
+  if (m_manifest)
+  {
+    // one JSON object per line
+    std::string line = "{\"path\":";
+    appendJSONString(line, job.path);
+    line += ",\"status\":";
+    appendJSONString(line, outcome.status);
+    if (outcome.signal)
+      line += ",\"signal\":" + std::to_string(outcome.signal);
+    char numbers[128];
+    snprintf(numbers, sizeof(numbers), ",\"ms\":%.3f,\"bytes\":%llu,\"cells\":%lu",
+             outcome.time * 1e3, outcome.bytes, outcome.cells);
+    line += numbers;
+    if (outcome.peak)
+      line += ",\"peak_rss_kb\":" + std::to_string(outcome.peak);
+    line += "}\n";
+    fwrite(line.data(), 1, line.size(), m_manifest);
+    fflush(m_manifest);
+  }
+}
+
+int Reporter::finish(double time, unsigned workers, const char *kind)
+{
+  const double rate = time > 0 ? 1.0 / time : 0;
+  printf("%u files, %u failed, %.2f MB in %.2f ms on %u %s: %.2f MB/s %llu cells %.0f cells/s\n",
+         m_files, m_failed, double(m_bytes) / 1e6, time * 1e3, workers, kind,
+         double(m_bytes) * rate / 1e6, m_cells, double(m_cells) * rate);
+  return m_failed ? 1 : 0;
+}
+
+unsigned long long fileSize(const std::string &path)
+{
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 ? (unsigned long long) st.st_size : 0;
+}
+
+Outcome convertJob(const Converter &converter, const Job &job, const std::string &outDir,
+                   CellCounter &counter, std::vector<std::string> &output)
+{
+  Outcome outcome;
+  outcome.bytes = fileSize(job.path);
+
+  counter.reset();
+  output.clear();
+  const auto start = std::chrono::steady_clock::now();
+  bool ok;
+  {
+    librevenge::RVNGFileStream input(job.path.c_str());
+    ok = converter.convert(input, counter, libdrawio::DRAWIOOptions(), converter.extension ? &output : nullptr);
+  }
+  outcome.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  outcome.cells = counter.getCount();
+
+  if (!ok)
+  {
+    outcome.status = "unsupported";
+    return outcome;
+  }
+  for (unsigned page = 0; page < output.size(); ++page)
+  {
+    const std::string path = outputPath(converter, job, outDir, page, unsigned(output.size()));
+    if (!makeDirectories(path) || !writeOutput(path, output[page]))
+    {
+      outcome.status = "write-failed";
+      break;
+    }
+  }
+  return outcome;
+}
+
+int runThreads(const Converter &converter, const std::vector<Job> &jobs, const Settings &settings)
+{
+  Reporter reporter(settings.manifest);
+  if (!reporter.isOpen())
+  {
+    fprintf(stderr, "ERROR: cannot write %s\n", settings.manifest.c_str());
+    return 1;
+  }
+  std::atomic<size_t> next(0);
+
+  const auto work = [&]()
+  {
+    CellCounter counter;
+    std::vector<std::string> output;
+    for (size_t i = next++; i < jobs.size(); i = next++)
+      reporter.report(jobs[i], convertJob(converter, jobs[i], settings.outDir, counter, output));
+  };
+
+  const unsigned threads = std::max(1u, std::min(settings.workers, unsigned(jobs.size())));
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (unsigned i = 1; i < threads; ++i)
+    pool.push_back(std::thread(work));
+  work();
+  for (auto &thread : pool)
+    thread.join();
+  const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return reporter.finish(time, threads, "threads");
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Converter.h"
+
+namespace conv
+{
+
+class CellCounter;
+
+struct Job
+{
+  std::string path;
+  std::string relative; //< path below -o
+};
+
+struct Settings
+{
+  Settings();
+
+  std::string outDir;
+  std::string manifest;
+  unsigned workers;
+  bool isolate; //< one process per worker instead of one thread
+  double timeout; //< seconds per file, isolated workers only
+  unsigned long maxRss; //< kB per worker, 0 for no limit, isolated workers only
+};
+
+// what became of one job
+struct Outcome
+{
+  Outcome();
+
+  std::string status; //< ok, unsupported, write-failed, crashed, timeout or memory
+  int signal; //< that ended a crashed worker
+  double time; //< seconds
+  unsigned long long bytes;
+  unsigned long cells;
+  unsigned long peak; //< peak resident memory in kB, 0 if unknown
+};
+
+/* Prints one line per job and a summary, and writes the manifest.
+ */
+class Reporter
+{
+public:
+  explicit Reporter(const std::string &manifest);
+  ~Reporter();
+
+  bool isOpen() const;
+  void report(const Job &job, const Outcome &outcome);
+  int finish(double time, unsigned workers, const char *kind);
+
+private:
+  Reporter(const Reporter &);
+  Reporter &operator=(const Reporter &);
+
+  std::mutex m_mutex;
+  FILE *m_manifest;
+  bool m_failedToOpen;
+  unsigned m_files;
+  unsigned m_failed;
+  unsigned long long m_bytes;
+  unsigned long long m_cells;
+};
+
+unsigned long long fileSize(const std::string &path);
+
+// converts one job and writes its output
+Outcome convertJob(const Converter &converter, const Job &job, const std::string &outDir,
+                   CellCounter &counter, std::vector<std::string> &output);
+
+int runThreads(const Converter &converter, const std::vector<Job> &jobs, const Settings &settings);
+int runProcesses(const Converter &converter, const std::vector<Job> &jobs, const Settings &settings);
+
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
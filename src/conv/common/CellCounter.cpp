@@ -0,0 +1,37 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "CellCounter.h"
+
+namespace conv
+{
+
+CellCounter::CellCounter()
+  : m_count(0)
+{
+}
+
+unsigned long CellCounter::getCount() const
+{
+  return m_count;
+}
+
+void CellCounter::reset()
+{
+  m_count = 0;
+}
+
+void CellCounter::openGroup(const librevenge::RVNGPropertyList &)
+{
+  ++m_count;
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
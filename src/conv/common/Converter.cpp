@@ -0,0 +1,250 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "Batch.h"
+#include "CellCounter.h"
+#include "Converter.h"
+
+namespace conv
+{
+
+namespace
+{
+
+int printUsage(const Converter &converter)
+{
+  printf("`%s' %s.\n", converter.name, converter.description);
+  printf("\n");
+  printf("Usage: %s [OPTION] INPUT\n", converter.name);
+  printf("       %s [OPTION] --batch [-j N] [-o DIR] [--list FILE] [--manifest FILE] INPUT...\n", converter.name);
+  printf("\n");
+  printf("A single input file is converted to standard output. With more inputs,\n");
+  printf("a directory or --batch, every file is converted on its own and written\n");
+  printf("next to the input (or below DIR), and timings are printed per file.\n");
+  printf("Directories are searched for .drawio, .dio and .xml files.\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t--batch         convert in batch mode even for a single file\n");
+  printf("\t-j N            use N worker threads (default: one per core)\n");
+  printf("\t-o DIR          write batch output below DIR\n");
+  printf("\t--list FILE     read input paths from FILE, one per line\n");
+  printf("\t--manifest FILE write the outcome of every file to FILE as JSON lines\n");
+  printf("\t--isolate       convert in N worker processes instead of threads, so\n");
+  printf("\t                that a file that crashes or hangs fails on its own\n");
+  printf("\t--timeout SEC   with --isolate, fail files taking longer (default: 60)\n");
+  printf("\t--max-rss MB    with --isolate, fail files using more memory\n");
+  printf("\t--stats         print the timings and counters of a single conversion\n");
+  printf("\t                to standard error, as JSON\n");
+  printf("\t--trace FILE    write a Chrome trace of a single conversion to FILE\n");
+  if (converter.optionHelp)
+    printf("%s", converter.optionHelp);
+  printf("\t--help          show this help message\n");
+  printf("\n");
+  printf("Report bugs to <https://bugs.documentfoundation.org/>.\n");
+  return -1;
+}
+
+bool hasExtension(const std::string &name)
+{
+  const char *const extensions[] = { ".drawio", ".dio", ".xml" };
+  for (const char *extension : extensions)
+  {
+    const size_t len = strlen(extension);
+    if (name.size() > len && name.compare(name.size() - len, len, extension) == 0)
+      return true;
+  }
+  return false;
+}
+
+void collect(const std::string &dir, const std::string &relative, std::vector<Job> &jobs)
+{
+  DIR *const handle = opendir(dir.c_str());
+  if (!handle)
+  {
+    fprintf(stderr, "ERROR: cannot open directory %s\n", dir.c_str());
+    return;
+  }
+  std::vector<std::string> names;
+  while (const struct dirent *entry = readdir(handle))
+  {
+    if (entry->d_name[0] != '.')
+      names.push_back(entry->d_name);
+  }
+  closedir(handle);
+  std::sort(names.begin(), names.end());
+
+  for (const auto &name : names)
+  {
+    const std::string path = dir + "/" + name;
+    const std::string rel = relative.empty() ? name : relative + "/" + name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+      continue;
+    if (S_ISDIR(st.st_mode))
+      collect(path, rel, jobs);
+    else if (S_ISREG(st.st_mode) && hasExtension(name))
+      jobs.push_back(Job{path, rel});
+  }
+}
+
+void addInput(const std::string &path, std::vector<Job> &jobs, bool &sawDirectory)
+{
+  struct stat st;
+  if (stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+  {
+    sawDirectory = true;
+    collect(path, std::string(), jobs);
+    return;
+  }
+  const size_t slash = path.rfind('/');
+  jobs.push_back(Job{path, slash == std::string::npos ? path : path.substr(slash + 1)});
+}
+
+void printStatistics(const libdrawio::DRAWIOStatistics &statistics)
+{
+  fprintf(stderr, "{\"phases\": {");
+  for (unsigned phase = 0; phase < libdrawio::DRAWIOStatistics::PHASE_COUNT; ++phase)
+  {
+    fprintf(stderr, "%s\"%s\": %.6f", phase ? ", " : "",
+            libdrawio::DRAWIOStatistics::getPhaseName(libdrawio::DRAWIOStatistics::Phase(phase)),
+            statistics.time[phase]);
+  }
+  fprintf(stderr, "}, \"bytes_read\": %llu, \"xml_nodes\": %llu, \"cells\": %llu, \"edges\": %llu, "
+          "\"styles\": %llu, \"routing_iterations\": %llu, \"path_steps\": %llu, \"painter_calls\": %llu, "
+          "\"peak_memory\": %llu, \"memory_at_peak\": {",
+          statistics.bytesRead, statistics.xmlNodes, statistics.cells, statistics.edges, statistics.styles,
+          statistics.routingIterations, statistics.pathSteps, statistics.painterCalls, statistics.peakMemory);
+  for (unsigned memory = 0; memory < libdrawio::DRAWIOStatistics::MEMORY_COUNT; ++memory)
+  {
+    fprintf(stderr, "%s\"%s\": %llu", memory ? ", " : "",
+            libdrawio::DRAWIOStatistics::getMemoryName(libdrawio::DRAWIOStatistics::Memory(memory)),
+            statistics.memory[memory]);
+  }
+  fprintf(stderr, "}, \"peak_memory_of\": {");
+  for (unsigned memory = 0; memory < libdrawio::DRAWIOStatistics::MEMORY_COUNT; ++memory)
+  {
+    fprintf(stderr, "%s\"%s\": %llu", memory ? ", " : "",
+            libdrawio::DRAWIOStatistics::getMemoryName(libdrawio::DRAWIOStatistics::Memory(memory)),
+            statistics.peakMemoryOf[memory]);
+  }
+  fprintf(stderr, "}}\n");
+}
+
+int runSingle(const Converter &converter, const char *path, const bool printStats, const char *traceFile)
+{
+  librevenge::RVNGFileStream input(path);
+  CellCounter counter;
+  std::vector<std::string> output;
+  libdrawio::DRAWIOStatistics statistics;
+  libdrawio::DRAWIOOptions options;
+  if (printStats)
+    options.statistics = &statistics;
+  options.traceFile = traceFile;
+  if (!converter.convert(input, counter, options, &output))
+  {
+    fprintf(stderr, "ERROR: Unsupported file format!\n");
+    return 1;
+  }
+  for (const auto &document : output)
+    fwrite(document.data(), 1, document.size(), stdout);
+  if (printStats)
+    printStatistics(statistics);
+  return 0;
+}
+
+}
+
+int run(const Converter &converter, int argc, char *argv[])
+{
+  bool batch = false;
+  bool sawDirectory = false;
+  bool printStats = false;
+  const char *traceFile = nullptr;
+  Settings settings;
+  std::vector<Job> jobs;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *const arg = argv[i];
+    if (!strcmp(arg, "--batch"))
+      batch = true;
+    else if (!strcmp(arg, "-j") && i + 1 < argc)
+      settings.workers = unsigned(std::max(1, atoi(argv[++i])));
+    else if (!strcmp(arg, "-o") && i + 1 < argc)
+      settings.outDir = argv[++i];
+    else if (!strcmp(arg, "--list") && i + 1 < argc)
+    {
+      std::ifstream list(argv[++i]);
+      if (!list)
+      {
+        fprintf(stderr, "ERROR: cannot read %s\n", argv[i]);
+        return 1;
+      }
+      for (std::string line; std::getline(list, line);)
+      {
+        if (!line.empty())
+          addInput(line, jobs, sawDirectory);
+      }
+      batch = true;
+    }
+    else if (!strcmp(arg, "--manifest") && i + 1 < argc)
+    {
+      settings.manifest = argv[++i];
+      batch = true;
+    }
+    else if (!strcmp(arg, "--isolate"))
+      settings.isolate = batch = true;
+    else if (!strcmp(arg, "--timeout") && i + 1 < argc)
+      settings.timeout = atof(argv[++i]);
+    else if (!strcmp(arg, "--max-rss") && i + 1 < argc)
+      settings.maxRss = strtoul(argv[++i], nullptr, 10) * 1024;
+    else if (!strcmp(arg, "--stats"))
+      printStats = true;
+    else if (!strcmp(arg, "--trace") && i + 1 < argc)
+      traceFile = argv[++i];
+    else if (!strcmp(arg, "--help"))
+      return printUsage(converter);
+    else if (arg[0] == '-' && arg[1] != '\0')
+    {
+      if (!converter.option || !converter.option(arg))
+        return printUsage(converter);
+    }
+    else
+      addInput(arg, jobs, sawDirectory);
+  }
+
+  if (jobs.empty())
+    return sawDirectory ? 0 : printUsage(converter);
+  if (settings.workers == 0)
+    settings.workers = 1;
+  if (settings.timeout <= 0)
+    settings.timeout = 60;
+
+  if (!batch && !sawDirectory && jobs.size() == 1)
+    return runSingle(converter, jobs.front().path.c_str(), printStats, traceFile);
+  if (settings.isolate)
+    return runProcesses(converter, jobs, settings);
+  return runThreads(converter, jobs, settings);
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,57 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CONVERTER_H
+#define CONVERTER_H
+
+#include <string>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+namespace libdrawio
+{
+struct DRAWIOOptions;
+}
+
+namespace conv
+{
+
+/* Description of one conversion tool, driven by run().
+ *
+ * convert() gets the opened input, a painter that must be passed to the
+ * library alongside the tool's own one, the options to parse with, and
+ * the list to append the converted documents to. The list is null if the output is not kept,
+ * which only happens in batch mode for tools without an extension.
+ */
+struct Converter
+{
+  const char *name;
+  const char *extension; //< of the output files, or null if batch output is discarded
+  const char *description;
+  const char *optionHelp; //< tool specific options, or null
+  bool (*option)(const char *arg); //< returns true if the option is known, may be null
+  bool (*convert)(librevenge::RVNGInputStream &input, librevenge::RVNGDrawingInterface &counter,
+                  const libdrawio::DRAWIOOptions &options, std::vector<std::string> *output);
+};
+
+/* Runs the tool.
+ *
+ * A single input is converted to stdout. More inputs, a directory or
+ * --batch convert every file on a pool of worker threads, write each
+ * result next to its input (or below -o) and print timings per file.
+ */
+int run(const Converter &converter, int argc, char *argv[]);
+
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
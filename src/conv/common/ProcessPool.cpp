@@ -0,0 +1,419 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Batch.h"
+#include "CellCounter.h"
+
+namespace conv
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+/* Worker processes get job indices on a socket, one per line, and answer
+ * each with "STATUS SECONDS BYTES CELLS PEAK". A worker that dies or
+ * overruns its limits is replaced, and its job is reported as failed.
+ */
+struct Worker
+{
+  Worker()
+    : pid(-1)
+    , fd(-1)
+    , job(-1)
+    , start()
+    , buffer()
+  {
+  }
+
+  pid_t pid;
+  int fd;
+  long job; //< being converted, or -1 if idle
+  Clock::time_point start;
+  std::string buffer;
+};
+
+// a field of /proc/self/status in kB, 0 if unknown
+unsigned long readStatus(const char *const name)
+{
+  const size_t length = strlen(name);
+  unsigned long value = 0;
+  if (FILE *const status = fopen("/proc/self/status", "r"))
+  {
+    char line[256];
+    while (fgets(line, sizeof(line), status))
+    {
+      if (!strncmp(line, name, length) && line[length] == ':')
+      {
+        value = strtoul(line + length + 1, nullptr, 10);
+        break;
+      }
+    }
+    fclose(status);
+  }
+  return value;
+}
+
+// peak resident memory since the last reset, in kB
+void resetPeak()
+{
+  if (FILE *const refs = fopen("/proc/self/clear_refs", "w"))
+  {
+    fputs("5", refs);
+    fclose(refs);
+  }
+}
+
+unsigned long readPeak()
+{
+  unsigned long peak = readStatus("VmHWM");
+  if (!peak)
+  {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+      peak = (unsigned long) usage.ru_maxrss;
+  }
+  return peak;
+}
+
+// set when an allocation of the worker fails
+bool allocationFailed = false;
+
+void onAllocationFailure()
+{
+  allocationFailed = true;
+  throw std::bad_alloc();
+}
+
+/* The parent only polls the resident memory of a worker now and then, and
+ * a runaway conversion can allocate a lot in between. So the worker also
+ * gets a hard limit, on top of what it inherited, that makes its own
+ * allocations fail.
+ */
+void limitMemory(const unsigned long maxRss)
+{
+  struct rlimit limit;
+  limit.rlim_cur = limit.rlim_max = rlim_t(readStatus("VmData") + maxRss) * 1024;
+  setrlimit(RLIMIT_DATA, &limit);
+  std::set_new_handler(onAllocationFailure);
+}
+
+// current resident memory of a child in kB, 0 if unknown
+unsigned long readRss(pid_t pid)
+{
+  unsigned long rss = 0;
+  const std::string path = "/proc/" + std::to_string(pid) + "/statm";
+  if (FILE *const statm = fopen(path.c_str(), "r"))
+  {
+    unsigned long size, pages;
+    if (fscanf(statm, "%lu %lu", &size, &pages) == 2)
+      rss = pages * (unsigned long)(sysconf(_SC_PAGESIZE) / 1024);
+    fclose(statm);
+  }
+  return rss;
+}
+
+bool writeAll(int fd, const std::string &data)
+{
+  for (size_t done = 0; done < data.size();)
+  {
+    const ssize_t count = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0)
+      return false;
+    done += size_t(count);
+  }
+  return true;
+}
+
+void serveJobs(const Converter &converter, const std::vector<Job> &jobs, const std::string &outDir, int fd)
+{
+  CellCounter counter;
+  std::vector<std::string> output;
+  std::string buffer;
+  char data[256];
+  for (;;)
+  {
+    const size_t end = buffer.find('\n');
+    if (end == std::string::npos)
+    {
+      const ssize_t count = read(fd, data, sizeof(data));
+      if (count < 0 && errno == EINTR)
+        continue;
+      if (count <= 0)
+        return;
+      buffer.append(data, size_t(count));
+      continue;
+    }
+    const unsigned long index = strtoul(buffer.c_str(), nullptr, 10);
+    buffer.erase(0, end + 1);
+    if (index >= jobs.size())
+      return;
+
+    resetPeak();
+    allocationFailed = false;
+    Outcome outcome;
+    const auto start = Clock::now();
+    try
+    {
+      outcome = convertJob(converter, jobs[index], outDir, counter, output);
+    }
+    catch (const std::bad_alloc &)
+    {
+      allocationFailed = true;
+      outcome.time = std::chrono::duration<double>(Clock::now() - start).count();
+      outcome.bytes = fileSize(jobs[index].path);
+    }
+    // the library may have caught the failure and given up on the file
+    if (allocationFailed)
+      outcome.status = "memory";
+    char reply[256];
+    snprintf(reply, sizeof(reply), "%s %.9f %llu %lu %lu\n", outcome.status.c_str(), outcome.time,
+             outcome.bytes, outcome.cells, readPeak());
+    if (!writeAll(fd, reply))
+      return;
+  }
+}
+
+bool spawn(Worker &worker, const std::vector<Worker> &workers,
+           const Converter &converter, const std::vector<Job> &jobs, const Settings &settings)
+{
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    return false;
+  fflush(stdout);
+  fflush(stderr);
+  const pid_t pid = fork();
+  if (pid < 0)
+  {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid == 0)
+  {
+    // the other workers must see EOF when the parent closes their sockets
+    close(fds[0]);
+    for (const auto &other : workers)
+    {
+      if (other.fd >= 0)
+        close(other.fd);
+    }
+    if (settings.maxRss)
+      limitMemory(settings.maxRss);
+    serveJobs(converter, jobs, settings.outDir, fds[1]);
+    _exit(0);
+  }
+  close(fds[1]);
+  worker.pid = pid;
+  worker.fd = fds[0];
+  worker.job = -1;
+  worker.buffer.clear();
+  return true;
+}
+
+// ends a worker and tells how it ended
+int reap(Worker &worker, bool kill)
+{
+  if (kill)
+    ::kill(worker.pid, SIGKILL);
+  close(worker.fd);
+  int status = 0;
+  while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR)
+    ;
+  worker.pid = -1;
+  worker.fd = -1;
+  worker.job = -1;
+  worker.buffer.clear();
+  return WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+}
+
+bool parseReply(const std::string &line, Outcome &outcome)
+{
+  char status[64];
+  double time;
+  unsigned long long bytes;
+  unsigned long cells, peak;
+  if (sscanf(line.c_str(), "%63s %lf %llu %lu %lu", status, &time, &bytes, &cells, &peak) != 5)
+    return false;
+  outcome.status = status;
+  outcome.time = time;
+  outcome.bytes = bytes;
+  outcome.cells = cells;
+  outcome.peak = peak;
+  return true;
+}
+
+}
+
+int runProcesses(const Converter &converter, const std::vector<Job> &jobs, const Settings &settings)
+{
+  Reporter reporter(settings.manifest);
+  if (!reporter.isOpen())
+  {
+    fprintf(stderr, "ERROR: cannot write %s\n", settings.manifest.c_str());
+    return 1;
+  }
+
+  const unsigned count = std::max(1u, std::min(settings.workers, unsigned(jobs.size())));
+  std::vector<Worker> workers(count);
+  for (auto &worker : workers)
+  {
+    if (!spawn(worker, workers, converter, jobs, settings))
+    {
+      fprintf(stderr, "ERROR: cannot start worker: %s\n", strerror(errno));
+      for (auto &started : workers)
+      {
+        if (started.pid >= 0)
+          reap(started, true);
+      }
+      return 1;
+    }
+  }
+
+  // a worker's job is reported as failed, and a new worker takes its place
+  const auto fail = [&](Worker &worker, const char *status, bool kill)
+  {
+    Outcome outcome;
+    const Job &job = jobs[size_t(worker.job)];
+    outcome.status = status;
+    outcome.time = std::chrono::duration<double>(Clock::now() - worker.start).count();
+    outcome.bytes = fileSize(job.path);
+    const int signal = reap(worker, kill);
+    if (outcome.status == "crashed")
+      outcome.signal = signal;
+    reporter.report(job, outcome);
+    return spawn(worker, workers, converter, jobs, settings);
+  };
+
+  const auto start = Clock::now();
+  size_t next = 0;
+  size_t done = 0;
+  bool broken = false;
+  while (done < jobs.size() && !broken)
+  {
+    for (auto &worker : workers)
+    {
+      if (worker.fd < 0 || worker.job >= 0 || next >= jobs.size())
+        continue;
+      if (writeAll(worker.fd, std::to_string(next) + "\n"))
+      {
+        worker.job = long(next++);
+        worker.start = Clock::now();
+      }
+      else
+      {
+        reap(worker, true);
+        broken |= !spawn(worker, workers, converter, jobs, settings);
+      }
+    }
+
+    // wake up in time for the nearest deadline, and often enough to watch memory
+    std::vector<pollfd> fds;
+    std::vector<Worker *> busy;
+    double wait = settings.maxRss ? 0.05 : 1.0;
+    for (auto &worker : workers)
+    {
+      if (worker.job < 0)
+        continue;
+      const pollfd fd = { worker.fd, POLLIN, 0 };
+      fds.push_back(fd);
+      busy.push_back(&worker);
+      const double elapsed = std::chrono::duration<double>(Clock::now() - worker.start).count();
+      wait = std::min(wait, std::max(0.0, settings.timeout - elapsed));
+    }
+    if (fds.empty())
+      break;
+    if (poll(fds.data(), fds.size(), int(wait * 1000) + 1) < 0 && errno != EINTR)
+    {
+      fprintf(stderr, "ERROR: poll failed: %s\n", strerror(errno));
+      broken = true;
+      break;
+    }
+
+    for (size_t i = 0; i < busy.size(); ++i)
+    {
+      Worker &worker = *busy[i];
+      if (fds[i].revents)
+      {
+        char data[256];
+        const ssize_t got = read(worker.fd, data, sizeof(data));
+        if (got < 0 && errno == EINTR)
+          continue;
+        if (got <= 0)
+        {
+          broken |= !fail(worker, "crashed", false);
+          ++done;
+          continue;
+        }
+        worker.buffer.append(data, size_t(got));
+        const size_t end = worker.buffer.find('\n');
+        if (end != std::string::npos)
+        {
+          Outcome outcome;
+          if (!parseReply(worker.buffer.substr(0, end), outcome))
+          {
+            broken |= !fail(worker, "crashed", true);
+            ++done;
+            continue;
+          }
+          reporter.report(jobs[size_t(worker.job)], outcome);
+          worker.buffer.erase(0, end + 1);
+          worker.job = -1;
+          ++done;
+          continue;
+        }
+      }
+      if (std::chrono::duration<double>(Clock::now() - worker.start).count() > settings.timeout)
+      {
+        broken |= !fail(worker, "timeout", true);
+        ++done;
+      }
+      else if (settings.maxRss && readRss(worker.pid) > settings.maxRss)
+      {
+        broken |= !fail(worker, "memory", true);
+        ++done;
+      }
+    }
+  }
+
+  for (auto &worker : workers)
+  {
+    if (worker.pid >= 0)
+      reap(worker, worker.job >= 0);
+  }
+  if (broken)
+  {
+    fprintf(stderr, "ERROR: cannot restart worker: %s\n", strerror(errno));
+    return 1;
+  }
+  const double time = std::chrono::duration<double>(Clock::now() - start).count();
+  return reporter.finish(time, count, "processes");
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
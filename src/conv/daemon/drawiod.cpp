@@ -0,0 +1,729 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <librevenge-generators/librevenge-generators.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libdrawio/libdrawio.h>
+
+namespace
+{
+
+volatile sig_atomic_t stopRequested = 0;
+
+void handleSignal(int)
+{
+  stopRequested = 1;
+}
+
+int printUsage()
+{
+  printf("`drawiod' is a daemon that converts draw.io diagrams for clients on a Unix socket.\n");
+  printf("\n");
+  printf("Usage: drawiod [OPTION] SOCKET\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t-j N            serve N connections at a time (default: one per core)\n");
+  printf("\t-c DIR          keep laid out documents in DIR across restarts\n");
+  printf("\t-m MB           memory for converted results (default: 64)\n");
+  printf("\t-s MB           largest document accepted (default: 64)\n");
+  printf("\t-d N            documents kept for incremental conversion (default: 32)\n");
+  printf("\t-t SECONDS      longest time a conversion may take (default: no limit)\n");
+  printf("\t--help          show this help message\n");
+  printf("\n");
+  printf("Requests are lines of tab separated fields:\n");
+  printf("\tconvert FORMAT INPUT OUTPUT\n");
+  printf("\tstats\n");
+  printf("FORMAT is svg, svg-direct or text. INPUT is a path, or - for a file\n");
+  printf("descriptor sent with the request (SCM_RIGHTS). OUTPUT is a path, or -\n");
+  printf("to get the result back on the socket. Multi-page results are written\n");
+  printf("to OUTPUT with -N before the extension. The answer is one line,\n");
+  printf("\tok PAGES MICROSECONDS CACHED\n");
+  printf("followed, for OUTPUT -, by every page as a line with its length in bytes\n");
+  printf("and the data; or\n");
+  printf("\terror MESSAGE\n");
+  printf("\n");
+  printf("Report bugs to <https://bugs.documentfoundation.org/>.\n");
+  return -1;
+}
+
+// longest request line; longer ones end the connection
+const size_t MAX_LINE_BYTES = 65536;
+// file descriptors held for one connection before more are closed unused
+const size_t MAX_PENDING_FDS = 16;
+
+typedef std::vector<std::string> Pages;
+
+/* Converted results by format and content, least recently used first out.
+ */
+class ResultCache
+{
+public:
+  explicit ResultCache(unsigned long long capacity)
+    : m_mutex()
+    , m_entries()
+    , m_index()
+    , m_capacity(capacity)
+    , m_size(0)
+  {
+  }
+
+  bool find(const std::string &key, Pages &pages)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_index.find(key);
+    if (it == m_index.end())
+      return false;
+    m_entries.splice(m_entries.end(), m_entries, it->second);
+    pages = it->second->pages;
+    return true;
+  }
+
+  void insert(const std::string &key, const Pages &pages)
+  {
+    unsigned long long size = key.size();
+    for (const auto &page : pages)
+      size += page.size();
+    if (size > m_capacity)
+      return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_index.count(key))
+      return;
+    while (m_size + size > m_capacity)
+    {
+      m_size -= m_entries.front().size;
+      m_index.erase(m_entries.front().key);
+      m_entries.pop_front();
+    }
+    m_entries.push_back(Entry{key, pages, size});
+    m_index[key] = std::prev(m_entries.end());
+    m_size += size;
+  }
+
+private:
+  struct Entry
+  {
+    std::string key;
+    Pages pages;
+    unsigned long long size;
+  };
+
+  std::mutex m_mutex;
+  std::list<Entry> m_entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+  const unsigned long long m_capacity;
+  unsigned long long m_size;
+};
+
+/* Last revision converted from the most recently used input paths, so
+ * that a changed file only needs its changed cells laid out again.
+ */
+class DocumentCache
+{
+public:
+  struct Document
+  {
+    Document()
+      : mutex()
+      , document()
+    {
+    }
+
+    std::mutex mutex;
+    libdrawio::DRAWIOIncrementalDocument document;
+  };
+
+  explicit DocumentCache(size_t capacity)
+    : m_mutex()
+    , m_paths()
+    , m_documents()
+    , m_capacity(capacity)
+  {
+  }
+
+  // null if no documents are kept; an evicted document lives on while in use
+  std::shared_ptr<Document> get(const std::string &path)
+  {
+    if (!m_capacity)
+      return std::shared_ptr<Document>();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_documents.find(path);
+    if (it != m_documents.end())
+    {
+      m_paths.splice(m_paths.end(), m_paths, it->second.second);
+      return it->second.first;
+    }
+    while (m_documents.size() >= m_capacity)
+    {
+      m_documents.erase(m_paths.front());
+      m_paths.pop_front();
+    }
+    std::shared_ptr<Document> document(new Document());
+    m_paths.push_back(path);
+    m_documents[path] = std::make_pair(document, std::prev(m_paths.end()));
+    return document;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::list<std::string> m_paths; //< least recently used first
+  std::unordered_map<std::string, std::pair<std::shared_ptr<Document>, std::list<std::string>::iterator>> m_documents;
+  const size_t m_capacity;
+};
+
+struct Server
+{
+  Server(unsigned long long cacheSize, const char *cacheDirectory, const libdrawio::DRAWIOLimits &limits,
+         size_t documentCount)
+    : options()
+    , results(cacheSize)
+    , documents(documentCount)
+    , requests(0)
+    , hits(0)
+    , layouts(0)
+  {
+    options.cacheDirectory = cacheDirectory;
+    options.limits = limits;
+  }
+
+  libdrawio::DRAWIOOptions options;
+  ResultCache results;
+  DocumentCache documents;
+  std::atomic<unsigned long> requests;
+  std::atomic<unsigned long> hits;
+  std::atomic<unsigned long> layouts;
+};
+
+/* Reads request lines from a client, along with any file descriptors
+ * sent with them.
+ */
+class Connection
+{
+public:
+  explicit Connection(int fd)
+    : m_fd(fd)
+    , m_buffer()
+    , m_fds()
+  {
+  }
+
+  ~Connection()
+  {
+    for (const int fd : m_fds)
+      close(fd);
+  }
+
+  bool readLine(std::string &line)
+  {
+    for (;;)
+    {
+      const size_t end = m_buffer.find('\n');
+      if (end != std::string::npos)
+      {
+        line.assign(m_buffer, 0, end);
+        m_buffer.erase(0, end + 1);
+        return true;
+      }
+      if (m_buffer.size() > MAX_LINE_BYTES)
+        return false;
+
+      char data[4096];
+      char control[CMSG_SPACE(sizeof(int) * 4)];
+      iovec iov = { data, sizeof(data) };
+      msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      const ssize_t count = recvmsg(m_fd, &msg, 0);
+      if (count < 0 && errno == EINTR)
+        continue;
+      if (count <= 0)
+        return false;
+      for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+      {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+          continue;
+        const size_t fds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < fds; ++i)
+        {
+          int fd;
+          memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+          if (m_fds.size() < MAX_PENDING_FDS)
+            m_fds.push_back(fd);
+          else
+            close(fd);
+        }
+      }
+      m_buffer.append(data, size_t(count));
+    }
+  }
+
+  // the oldest descriptor received and not yet used, or -1
+  int takeFd()
+  {
+    if (m_fds.empty())
+      return -1;
+    const int fd = m_fds.front();
+    m_fds.pop_front();
+    return fd;
+  }
+
+  bool write(const std::string &data)
+  {
+    for (size_t done = 0; done < data.size();)
+    {
+      const ssize_t count = send(m_fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+      if (count < 0 && errno == EINTR)
+        continue;
+      if (count <= 0)
+        return false;
+      done += size_t(count);
+    }
+    return true;
+  }
+
+private:
+  const int m_fd;
+  std::string m_buffer;
+  std::deque<int> m_fds;
+};
+
+// reads all of fd, unless it has more than maxBytes (0 for no limit)
+const char *readFile(int fd, std::string &data, unsigned long maxBytes)
+{
+  char buffer[65536];
+  for (;;)
+  {
+    const ssize_t count = read(fd, buffer, sizeof(buffer));
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count < 0)
+      return "cannot read";
+    if (count == 0)
+      return nullptr;
+    if (maxBytes && data.size() + size_t(count) > maxBytes)
+      return "input too large";
+    data.append(buffer, size_t(count));
+  }
+}
+
+std::vector<std::string> split(const std::string &line)
+{
+  std::vector<std::string> fields;
+  size_t start = 0;
+  for (size_t end = line.find('\t'); end != std::string::npos; end = line.find('\t', start))
+  {
+    fields.push_back(line.substr(start, end - start));
+    start = end + 1;
+  }
+  fields.push_back(line.substr(start));
+  return fields;
+}
+
+const char *describe(libdrawio::DRAWIODocument::Result result)
+{
+  switch (result)
+  {
+  case libdrawio::DRAWIODocument::RESULT_OK:
+    return "ok";
+  case libdrawio::DRAWIODocument::RESULT_FILE_ACCESS_ERROR:
+    return "file access error";
+  case libdrawio::DRAWIODocument::RESULT_PACKAGE_ERROR:
+    return "package error";
+  case libdrawio::DRAWIODocument::RESULT_PARSE_ERROR:
+    return "parse error";
+  case libdrawio::DRAWIODocument::RESULT_PASSWORD_MISMATCH:
+    return "password mismatch";
+  case libdrawio::DRAWIODocument::RESULT_UNSUPPORTED_ENCRYPTION:
+    return "unsupported encryption";
+  case libdrawio::DRAWIODocument::RESULT_UNSUPPORTED_FORMAT:
+    return "unsupported format";
+  case libdrawio::DRAWIODocument::RESULT_INPUT_TOO_LARGE:
+    return "input too large";
+  case libdrawio::DRAWIODocument::RESULT_TOO_MANY_CELLS:
+    return "too many cells";
+  case libdrawio::DRAWIODocument::RESULT_TOO_MANY_POINTS:
+    return "too many points";
+  case libdrawio::DRAWIODocument::RESULT_LABEL_TOO_LARGE:
+    return "label too large";
+  case libdrawio::DRAWIODocument::RESULT_TIME_LIMIT_EXCEEDED:
+    return "time limit exceeded";
+  case libdrawio::DRAWIODocument::RESULT_UNKNOWN_ERROR:
+  default:
+    return "unknown error";
+  }
+}
+
+// converts through the last revision of path if there is one
+libdrawio::DRAWIODocument::Result convert(Server &server, const std::string &format, const std::string &path,
+                                          const std::string &data, Pages &pages)
+{
+  librevenge::RVNGStringStream input(reinterpret_cast<const unsigned char *>(data.data()), (unsigned) data.size());
+  std::shared_ptr<DocumentCache::Document> document;
+  if (!path.empty() && format != "svg-direct")
+    document = server.documents.get(path);
+
+  libdrawio::DRAWIODocument::Result result;
+  if (format == "svg-direct")
+  {
+    librevenge::RVNGStringVector output;
+    result = libdrawio::DRAWIODocument::parseToSVG(&input, output, server.options);
+    for (unsigned i = 0; i < output.size(); ++i)
+      pages.push_back(output[i].cstr());
+  }
+  else if (format == "svg")
+  {
+    librevenge::RVNGStringVector output;
+    librevenge::RVNGSVGDrawingGenerator generator(output, "");
+    if (document)
+    {
+      std::lock_guard<std::mutex> lock(document->mutex);
+      result = document->document.parse(&input, &generator, server.options.limits);
+      server.layouts += document->document.getLayoutCount();
+    }
+    else
+      result = libdrawio::DRAWIODocument::parse(&input, &generator, server.options);
+    for (unsigned i = 0; i < output.size(); ++i)
+      pages.push_back(output[i].cstr());
+  }
+  else
+  {
+    librevenge::RVNGString output;
+    librevenge::RVNGTextDrawingGenerator generator(output);
+    if (document)
+    {
+      std::lock_guard<std::mutex> lock(document->mutex);
+      result = document->document.parse(&input, &generator, server.options.limits);
+      server.layouts += document->document.getLayoutCount();
+    }
+    else
+      result = libdrawio::DRAWIODocument::parse(&input, &generator, server.options);
+    pages.push_back(output.cstr());
+  }
+  if (format != "text")
+  {
+    for (auto &page : pages)
+      page.insert(0, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n");
+  }
+  return result;
+}
+
+bool writeOutput(const std::string &path, const Pages &pages)
+{
+  for (size_t i = 0; i < pages.size(); ++i)
+  {
+    std::string name = path;
+    if (pages.size() > 1)
+    {
+      const size_t slash = name.rfind('/');
+      size_t dot = name.rfind('.');
+      if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        dot = name.size();
+      name.insert(dot, "-" + std::to_string(i + 1));
+    }
+    std::ofstream out(name.c_str(), std::ios::out | std::ios::binary);
+    out.write(pages[i].data(), std::streamsize(pages[i].size()));
+    if (!out)
+      return false;
+  }
+  return true;
+}
+
+std::string handleConvert(Server &server, Connection &connection, const std::vector<std::string> &fields)
+{
+  if (fields.size() != 4)
+    return "error expected convert FORMAT INPUT OUTPUT\n";
+  const std::string &format = fields[1];
+  if (format != "svg" && format != "svg-direct" && format != "text")
+    return "error unknown format " + format + "\n";
+
+  const auto start = std::chrono::steady_clock::now();
+  std::string path;
+  std::string data;
+  int fd;
+  if (fields[2] == "-")
+  {
+    fd = connection.takeFd();
+    if (fd < 0)
+      return "error no file descriptor received\n";
+  }
+  else
+  {
+    path = fields[2];
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return "error cannot open " + path + "\n";
+  }
+  const char *const error = readFile(fd, data, server.options.limits.maxInputBytes);
+  close(fd);
+  if (error)
+    return std::string("error ") + error + "\n";
+
+  ++server.requests;
+  librevenge::RVNGStringStream input(reinterpret_cast<const unsigned char *>(data.data()), (unsigned) data.size());
+  const std::string key = format + ":" + libdrawio::DRAWIODocument::getDigest(&input).cstr();
+  Pages pages;
+  const bool cached = server.results.find(key, pages);
+  if (cached)
+    ++server.hits;
+  else
+  {
+    const libdrawio::DRAWIODocument::Result result = convert(server, format, path, data, pages);
+    if (result != libdrawio::DRAWIODocument::RESULT_OK)
+      return std::string("error ") + describe(result) + "\n";
+    server.results.insert(key, pages);
+  }
+
+  const bool inlined = fields[3] == "-";
+  if (!inlined && !writeOutput(fields[3], pages))
+    return "error cannot write " + fields[3] + "\n";
+  const long long time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  std::string reply = "ok " + std::to_string(pages.size()) + " " + std::to_string(time) + " " + (cached ? "1" : "0") + "\n";
+  if (inlined)
+  {
+    for (const auto &page : pages)
+    {
+      reply += std::to_string(page.size()) + "\n";
+      reply += page;
+    }
+  }
+  return reply;
+}
+
+void serve(Server &server, int fd)
+{
+  Connection connection(fd);
+  std::string line;
+  while (!stopRequested && connection.readLine(line))
+  {
+    const std::vector<std::string> fields = split(line);
+    std::string reply;
+    if (fields[0] == "convert")
+      reply = handleConvert(server, connection, fields);
+    else if (fields[0] == "stats")
+      reply = "ok requests=" + std::to_string(server.requests.load())
+              + " hits=" + std::to_string(server.hits.load())
+              + " layouts=" + std::to_string(server.layouts.load()) + "\n";
+    else
+      reply = "error unknown request\n";
+    if (!connection.write(reply))
+      break;
+  }
+}
+
+/* Connections waiting for a worker.
+ */
+class Queue
+{
+public:
+  Queue()
+    : m_mutex()
+    , m_ready()
+    , m_fds()
+    , m_active()
+    , m_closed(false)
+  {
+  }
+
+  void push(int fd)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fds.push_back(fd);
+    m_ready.notify_one();
+  }
+
+  // -1 once the queue is closed
+  int pop()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_fds.empty() && !m_closed)
+      m_ready.wait(lock);
+    if (m_fds.empty())
+      return -1;
+    const int fd = m_fds.front();
+    m_fds.pop_front();
+    m_active.insert(fd);
+    return fd;
+  }
+
+  void done(int fd)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_active.erase(fd);
+    ::close(fd);
+  }
+
+  // wakes all workers and ends the connections being served
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    for (const int fd : m_fds)
+      ::close(fd);
+    m_fds.clear();
+    for (const int fd : m_active)
+      shutdown(fd, SHUT_RDWR);
+    m_ready.notify_all();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_ready;
+  std::deque<int> m_fds;
+  std::set<int> m_active;
+  bool m_closed;
+};
+
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned threads = std::thread::hardware_concurrency();
+  unsigned long long cacheSize = 64;
+  const char *cacheDirectory = nullptr;
+  const char *socketPath = nullptr;
+  libdrawio::DRAWIOLimits limits;
+  limits.maxInputBytes = 64ul << 20;
+  size_t documentCount = 32;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *const arg = argv[i];
+    if (!strcmp(arg, "-j") && i + 1 < argc)
+      threads = unsigned(atoi(argv[++i]));
+    else if (!strcmp(arg, "-c") && i + 1 < argc)
+      cacheDirectory = argv[++i];
+    else if (!strcmp(arg, "-m") && i + 1 < argc)
+      cacheSize = strtoull(argv[++i], nullptr, 10);
+    else if (!strcmp(arg, "-s") && i + 1 < argc)
+      limits.maxInputBytes = strtoul(argv[++i], nullptr, 10) << 20;
+    else if (!strcmp(arg, "-d") && i + 1 < argc)
+      documentCount = size_t(strtoul(argv[++i], nullptr, 10));
+    else if (!strcmp(arg, "-t") && i + 1 < argc)
+      limits.maxTime = atof(argv[++i]);
+    else if (arg[0] == '-' || socketPath)
+      return printUsage();
+    else
+      socketPath = arg;
+  }
+  if (!socketPath)
+    return printUsage();
+  if (threads == 0)
+    threads = 1;
+
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(socketPath) >= sizeof(address.sun_path))
+  {
+    fprintf(stderr, "ERROR: socket path too long\n");
+    return 1;
+  }
+  strcpy(address.sun_path, socketPath);
+
+  // a stale socket is replaced, but nothing else is
+  struct stat info;
+  if (lstat(socketPath, &info) == 0)
+  {
+    if (!S_ISSOCK(info.st_mode))
+    {
+      fprintf(stderr, "ERROR: %s exists and is not a socket\n", socketPath);
+      return 1;
+    }
+    unlink(socketPath);
+  }
+
+  // clients make the daemon read and write paths as its user, so only
+  // that user may connect
+  const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  const mode_t mask = umask(0177);
+  const bool bound = listener >= 0
+                     && bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+  umask(mask);
+  if (!bound || listen(listener, 64) != 0)
+  {
+    fprintf(stderr, "ERROR: cannot listen on %s: %s\n", socketPath, strerror(errno));
+    return 1;
+  }
+
+  // no SA_RESTART, so that accept() returns on a signal
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = handleSignal;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+  signal(SIGPIPE, SIG_IGN);
+
+  Server server(cacheSize << 20, cacheDirectory, limits, documentCount);
+  Queue queue;
+  std::vector<std::thread> pool;
+  for (unsigned i = 0; i < threads; ++i)
+  {
+    pool.push_back(std::thread([&server, &queue]()
+    {
+      for (int fd = queue.pop(); fd >= 0; fd = queue.pop())
+      {
+        serve(server, fd);
+        queue.done(fd);
+      }
+    }));
+  }
+
+  while (!stopRequested)
+  {
+    const int fd = accept(listener, nullptr, nullptr);
+    if (fd >= 0)
+      queue.push(fd);
+    else if (errno != EINTR && errno != ECONNABORTED)
+    {
+      fprintf(stderr, "ERROR: accept failed: %s\n", strerror(errno));
+      break;
+    }
+  }
+
+  close(listener);
+  unlink(socketPath);
+  queue.close();
+  for (auto &thread : pool)
+    thread.join();
+  return 0;
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,127 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+
+#include <libodfgen/libodfgen.hxx>
+
+#include <libdrawio/libdrawio.h>
+
+#include "Converter.h"
+
+namespace
+{
+
+// collects the flat ODF XML into a string
+class StringDocumentHandler : public OdfDocumentHandler
+{
+public:
+  explicit StringDocumentHandler(std::string &data)
+    : m_data(data)
+    , m_isTagOpened(false)
+  {
+  }
+
+  void startDocument() override
+  {
+    m_data += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+  }
+
+  void endDocument() override
+  {
+    closeTag();
+  }
+
+  void startElement(const char *psName, const librevenge::RVNGPropertyList &xPropList) override
+  {
+    closeTag();
+    m_data += "<";
+    m_data += psName;
+    librevenge::RVNGPropertyList::Iter i(xPropList);
+    for (i.rewind(); i.next();)
+    {
+      // filter out librevenge properties
+      if (strncmp(i.key(), "librevenge", 10) != 0)
+      {
+        m_data += " ";
+        m_data += i.key();
+        m_data += "=\"";
+        m_data += i()->getStr().cstr();
+        m_data += "\"";
+      }
+    }
+    m_isTagOpened = true;
+  }
+
+  void endElement(const char *psName) override
+  {
+    if (m_isTagOpened)
+    {
+      m_data += "/>";
+      m_isTagOpened = false;
+      return;
+    }
+    m_data += "</";
+    m_data += psName;
+    m_data += ">";
+  }
+
+  void characters(const librevenge::RVNGString &sCharacters) override
+  {
+    closeTag();
+    librevenge::RVNGString escaped;
+    escaped.appendEscapedXML(sCharacters);
+    m_data += escaped.cstr();
+  }
+
+private:
+  void closeTag()
+  {
+    if (m_isTagOpened)
+    {
+      m_data += ">";
+      m_isTagOpened = false;
+    }
+  }
+
+  std::string &m_data;
+  bool m_isTagOpened;
+};
+
+bool convert(librevenge::RVNGInputStream &input, librevenge::RVNGDrawingInterface &counter,
+             const libdrawio::DRAWIOOptions &options, std::vector<std::string> *output)
+{
+  std::string data;
+  StringDocumentHandler handler(data);
+  OdgGenerator generator;
+  generator.addDocumentHandler(&handler, ODF_FLAT_XML);
+  librevenge::RVNGDrawingInterface *const painters[] = { &generator, &counter };
+  if (libdrawio::DRAWIODocument::RESULT_OK != libdrawio::DRAWIODocument::parse(&input, painters, 2, options))
+    return false;
+  output->push_back(data);
+  return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  const conv::Converter converter =
+  {
+    "drawio2odg",
+    "fodg",
+    "is a tool that converts draw.io diagrams to flat ODF drawings",
+    nullptr,
+    nullptr,
+    convert
+  };
+  return conv::run(converter, argc, argv);
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
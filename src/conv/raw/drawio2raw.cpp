@@ -0,0 +1,59 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+
+#include <librevenge-generators/librevenge-generators.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "Converter.h"
+
+namespace
+{
+
+bool printCallgraph = false;
+
+bool option(const char *arg)
+{
+  if (strcmp(arg, "--callgraph"))
+    return false;
+  printCallgraph = true;
+  return true;
+}
+
+// the raw generator prints straight to stdout, so a batch run only parses
+bool convert(librevenge::RVNGInputStream &input, librevenge::RVNGDrawingInterface &counter,
+             const libdrawio::DRAWIOOptions &options, std::vector<std::string> *output)
+{
+  if (!output)
+    return libdrawio::DRAWIODocument::RESULT_OK == libdrawio::DRAWIODocument::parse(&input, &counter, options);
+
+  librevenge::RVNGRawDrawingGenerator generator(printCallgraph);
+  librevenge::RVNGDrawingInterface *const painters[] = { &generator, &counter };
+  return libdrawio::DRAWIODocument::RESULT_OK == libdrawio::DRAWIODocument::parse(&input, painters, 2, options);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  const conv::Converter converter =
+  {
+    "drawio2raw",
+    nullptr,
+    "is a tool that prints the calls made by libdrawio to a painter",
+    "\t--callgraph     display the call graph nesting level\n",
+    option,
+    convert
+  };
+  return conv::run(converter, argc, argv);
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
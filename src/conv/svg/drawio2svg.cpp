@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+
+#include <librevenge-generators/librevenge-generators.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "Converter.h"
+
+namespace
+{
+
+bool direct = false;
+
+bool option(const char *arg)
+{
+  if (strcmp(arg, "--direct"))
+    return false;
+  direct = true;
+  return true;
+}
+
+// one standalone SVG document per page
+bool convert(librevenge::RVNGInputStream &input, librevenge::RVNGDrawingInterface &counter,
+             const libdrawio::DRAWIOOptions &options, std::vector<std::string> *output)
+{
+  librevenge::RVNGStringVector pages;
+  if (direct)
+  {
+    if (libdrawio::DRAWIODocument::RESULT_OK != libdrawio::DRAWIODocument::parseToSVG(&input, pages))
+      return false;
+  }
+  else
+  {
+    librevenge::RVNGSVGDrawingGenerator generator(pages, "");
+    librevenge::RVNGDrawingInterface *const painters[] = { &generator, &counter };
+    if (libdrawio::DRAWIODocument::RESULT_OK != libdrawio::DRAWIODocument::parse(&input, painters, 2, options))
+      return false;
+  }
+  for (unsigned i = 0; i < pages.size(); ++i)
+  {
+    output->push_back("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n");
+    output->back() += pages[i].cstr();
+  }
+  return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  const conv::Converter converter =
+  {
+    "drawio2svg",
+    "svg",
+    "is a tool that converts draw.io diagrams to SVG",
+    "\t--direct        write SVG straight from the display list (cells are not counted)\n",
+    option,
+    convert
+  };
+  return conv::run(converter, argc, argv);
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
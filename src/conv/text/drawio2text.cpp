@@ -0,0 +1,47 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <librevenge-generators/librevenge-generators.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "Converter.h"
+
+namespace
+{
+
+bool convert(librevenge::RVNGInputStream &input, librevenge::RVNGDrawingInterface &counter,
+             const libdrawio::DRAWIOOptions &options, std::vector<std::string> *output)
+{
+  librevenge::RVNGString text;
+  librevenge::RVNGTextDrawingGenerator generator(text);
+  librevenge::RVNGDrawingInterface *const painters[] = { &generator, &counter };
+  if (libdrawio::DRAWIODocument::RESULT_OK != libdrawio::DRAWIODocument::parse(&input, painters, 2, options))
+    return false;
+  output->push_back(text.cstr());
+  return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  const conv::Converter converter =
+  {
+    "drawio2text",
+    "txt",
+    "is a tool that extracts the text of a draw.io diagram",
+    nullptr,
+    nullptr,
+    convert
+  };
+  return conv::run(converter, argc, argv);
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <unistd.h>
+
+#include <libxml/xmlmemory.h>
+
+#include "FuzzBudget.h"
+
+namespace
+{
+
+unsigned long allocations = 0;
+
+void *countMalloc(size_t size)
+{
+    ++allocations;
+    return malloc(size);
+}
+
+void *countRealloc(void *ptr, size_t size)
+{
+    ++allocations;
+    return realloc(ptr, size);
+}
+
+char *countStrdup(const char *str)
+{
+    ++allocations;
+    return strdup(str);
+}
+
+void freeMemory(void *ptr)
+{
+    free(ptr);
+}
+
+struct Limits
+{
+    Limits()
+        : time(100)
+        , allocations(64)
+    {
+        if (const char *const value = getenv("DRAWIO_FUZZ_TIME_BUDGET"))
+            time = atof(value);
+        if (const char *const value = getenv("DRAWIO_FUZZ_ALLOC_BUDGET"))
+            allocations = strtoul(value, nullptr, 10);
+        xmlMemSetup(freeMemory, countMalloc, countRealloc, countStrdup);
+    }
+
+    double time; //< ms, and ms per kB
+    unsigned long allocations; //< per byte
+};
+
+const Limits &getLimits()
+{
+    static const Limits limits;
+    return limits;
+}
+
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *const ptr = malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+namespace fuzz
+{
+
+Budget::Budget(const size_t size)
+    : m_size(size)
+    , m_allocations(allocations)
+    , m_start(std::chrono::steady_clock::now())
+{
+    // installs the counting allocator of libxml2 before the first conversion
+    getLimits();
+}
+
+void Budget::check(const uint8_t *const data) const
+{
+    const Limits &limits = getLimits();
+    const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    const unsigned long count = allocations - m_allocations;
+    const double timeBudget = limits.time * (1 + double(m_size) / 1024);
+    const unsigned long allocationBudget = 10000 + limits.allocations * m_size;
+    if (time <= timeBudget && count <= allocationBudget)
+        return;
+
+    fprintf(stderr, "==%d== ERROR: input of %lu bytes over budget: %.1f ms (budget %.1f ms), %lu allocations (budget %lu)\n",
+            int(getpid()), (unsigned long) m_size, time, timeBudget, count, allocationBudget);
+    fprintf(stderr, "==%d== input starts with: %.*s\n", int(getpid()), int(m_size < 256 ? m_size : 256),
+            reinterpret_cast<const char *>(data));
+    abort();
+}
+
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
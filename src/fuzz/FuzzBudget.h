@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FUZZBUDGET_H
+#define FUZZBUDGET_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace fuzz
+{
+
+/* Time and allocations one input may take, growing with its size.
+ *
+ * An input that overruns its budget is reported and the fuzzer is aborted,
+ * so the input is kept as a finding like a crash would be: routing that
+ * barely terminates and quadratic lookups are bugs too. The budget is
+ * DRAWIO_FUZZ_TIME_BUDGET milliseconds (default 100) plus as many per kB
+ * of input, and DRAWIO_FUZZ_ALLOC_BUDGET allocations (default 64) per
+ * byte plus 10000. Allocations are counted through operator new and
+ * libxml2's allocator. Inputs that never finish are left to libFuzzer's
+ * -timeout and -rss_limit_mb.
+ */
+class Budget
+{
+public:
+    explicit Budget(size_t size);
+
+    // aborts if the input went over budget
+    void check(const uint8_t *data) const;
+
+private:
+    const size_t m_size;
+    const unsigned long m_allocations;
+    const std::chrono::steady_clock::time_point m_start;
+};
+
+}
+
+#endif
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,815 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include "ModelMutator.h"
+
+extern "C" size_t LLVMFuzzerMutate(uint8_t *data, size_t size, size_t maxSize);
+
+namespace fuzz
+{
+
+namespace
+{
+
+typedef std::mt19937 Random;
+
+struct Element
+{
+    Element()
+        : name()
+        , attributes()
+        , children()
+    {
+    }
+
+    explicit Element(const char *elementName)
+        : name(elementName)
+        , attributes()
+        , children()
+    {
+    }
+
+    const std::string *get(const char *key) const;
+    void set(const char *key, const std::string &value);
+    void erase(const char *key);
+
+    std::string name;
+    std::vector<std::pair<std::string, std::string> > attributes;
+    std::vector<Element> children;
+};
+
+// an element together with where it is, so it can be removed
+struct Site
+{
+    Element *parent;
+    size_t index;
+
+    Element &get() const
+    {
+        return parent->children[index];
+    }
+};
+
+const char *const STYLE_KEYS[] =
+{
+    "shape", "perimeter", "direction", "edgeStyle", "rotation", "fixedSize", "size", "base",
+    "position", "position2", "dx", "dy", "entryX", "entryY", "exitX", "exitY", "entryDx",
+    "entryDy", "exitDx", "exitDy", "sourcePortConstraint", "targetPortConstraint",
+    "portConstraint", "startArrow", "startFill", "startSize", "endArrow", "endFill", "endSize",
+    "fillColor", "strokeColor", "fontFamily", "fontSize", "fontStyle", "fontColor",
+    "labelBackgroundColor", "labelBorderColor", "align", "verticalAlign", "labelPosition",
+    "verticalLabelPosition", "whiteSpace", "html", "rounded"
+};
+
+// style tokens without a value
+const char *const STYLE_NAMES[] =
+{
+    "ellipse", "triangle", "rhombus", "text", "edgeLabel", "swimlane", "group", ""
+};
+
+const char *const SHAPES[] =
+{
+    "rectangle", "ellipse", "triangle", "rhombus", "callout", "process", "parallelogram",
+    "hexagon", "step", "trapezoid", "card", "internalStorage", "or", "xor", "document",
+    "tape", "dataStorage", "image", "mxgraph.unknown"
+};
+
+const char *const PERIMETERS[] =
+{
+    "rectanglePerimeter", "ellipsePerimeter", "trianglePerimeter", "calloutPerimeter",
+    "rhombusPerimeter", "parallelogramPerimeter", "hexagonPerimeter2", "stepPerimeter",
+    "trapezoidPerimeter"
+};
+
+const char *const DIRECTIONS[] =
+{
+    "north", "east", "south", "west", "eastwest", "northsouth"
+};
+
+const char *const EDGE_STYLES[] =
+{
+    "orthogonalEdgeStyle", "elbowEdgeStyle", "entityRelationEdgeStyle", "none"
+};
+
+const char *const ARROWS[] =
+{
+    "classic", "classicThin", "block", "blockThin", "open", "openThin", "oval", "diamond",
+    "diamondThin", "none"
+};
+
+const char *const COLORS[] =
+{
+    "#000000", "#FFFFFF", "#dae8fc", "#abc", "none", "default", "swimlane", "#"
+};
+
+const char *const ALIGNMENTS[] =
+{
+    "left", "center", "right", "top", "middle", "bottom"
+};
+
+const char *const NUMBERS[] =
+{
+    "0", "1", "-1", "0.5", "20", "-20", "40", "1e-300", "1e300", "-1e300", "1e308",
+    "2147483648", "-2147483649", "nan", "inf", "-inf", "", "0x10", "1.5.5", "abc"
+};
+
+const char *const LABELS[] =
+{
+    "", "label", "&lt;b&gt;bold&lt;/b&gt;", "<div>a<br>b</div>", "<span style=\"color:red\">x</span>",
+    "&amp;nbsp;&#1234;&#x1F600;", "\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80", "line\nbreak\ttab"
+};
+
+const char *const FLAGS[] =
+{
+    "vertex", "edge", "connectable", "visible", "collapsed"
+};
+
+const char *const EDGE_POINTS[] =
+{
+    "sourcePoint", "targetPoint"
+};
+
+enum Mutation
+{
+    MUTATE_STYLE,
+    MUTATE_GEOMETRY,
+    MUTATE_REFERENCE,
+    MUTATE_ID,
+    ADD_CELL,
+    REMOVE_CELL,
+    DUPLICATE_CELL,
+    MUTATE_WAYPOINTS,
+    MUTATE_FLAGS,
+    MUTATE_LABEL,
+    MUTATE_PAGES,
+    MUTATION_COUNT
+};
+
+const std::string *Element::get(const char *const key) const
+{
+    for (const auto &attribute : attributes)
+    {
+        if (attribute.first == key)
+            return &attribute.second;
+    }
+    return nullptr;
+}
+
+void Element::set(const char *const key, const std::string &value)
+{
+    for (auto &attribute : attributes)
+    {
+        if (attribute.first == key)
+        {
+            attribute.second = value;
+            return;
+        }
+    }
+    attributes.push_back(std::make_pair(std::string(key), value));
+}
+
+void Element::erase(const char *const key)
+{
+    for (auto it = attributes.begin(); it != attributes.end(); ++it)
+    {
+        if (it->first == key)
+        {
+            attributes.erase(it);
+            return;
+        }
+    }
+}
+
+size_t pick(Random &random, const size_t count)
+{
+    return std::uniform_int_distribution<size_t>(0, count - 1)(random);
+}
+
+bool chance(Random &random, const unsigned in)
+{
+    return pick(random, in) == 0;
+}
+
+template<size_t N>
+const char *pickFrom(Random &random, const char *const (&values)[N])
+{
+    return values[pick(random, N)];
+}
+
+std::string freshId(Random &random)
+{
+    return "f" + std::to_string(random() % 100000);
+}
+
+bool isCell(const Element &element)
+{
+    return element.name == "mxCell" || element.name == "UserObject" || element.name == "object";
+}
+
+void collect(Element &element, bool (*match)(const Element &), std::vector<Site> &sites)
+{
+    for (size_t i = 0; i < element.children.size(); ++i)
+    {
+        if (match(element.children[i]))
+        {
+            const Site site = { &element, i };
+            sites.push_back(site);
+        }
+        collect(element.children[i], match, sites);
+    }
+}
+
+void collectNamed(Element &element, const char *const name, std::vector<Site> &sites)
+{
+    for (size_t i = 0; i < element.children.size(); ++i)
+    {
+        if (element.children[i].name == name)
+        {
+            const Site site = { &element, i };
+            sites.push_back(site);
+        }
+        collectNamed(element.children[i], name, sites);
+    }
+}
+
+std::vector<std::string> collectIds(Element &document)
+{
+    std::vector<Site> cells;
+    collect(document, isCell, cells);
+    std::vector<std::string> ids;
+    for (const auto &site : cells)
+    {
+        if (const std::string *const id = site.get().get("id"))
+            ids.push_back(*id);
+    }
+    return ids;
+}
+
+// an id of the document, or now and then one that is not there
+std::string pickId(Random &random, const std::vector<std::string> &ids)
+{
+    if (ids.empty() || chance(random, 16))
+        return chance(random, 2) ? freshId(random) : std::string();
+    return ids[pick(random, ids.size())];
+}
+
+const char *pickValue(Random &random, const std::string &key)
+{
+    // a value of the wrong kind now and then
+    if (chance(random, 8))
+        return pickFrom(random, NUMBERS);
+    if (key == "shape")
+        return pickFrom(random, SHAPES);
+    if (key == "perimeter")
+        return pickFrom(random, PERIMETERS);
+    if (key == "direction")
+        return pickFrom(random, DIRECTIONS);
+    if (key == "edgeStyle")
+        return pickFrom(random, EDGE_STYLES);
+    if (key.find("Arrow") != std::string::npos)
+        return pickFrom(random, ARROWS);
+    if (key.find("Color") != std::string::npos)
+        return pickFrom(random, COLORS);
+    if (key.find("lign") != std::string::npos || key.find("Position") != std::string::npos)
+        return pickFrom(random, ALIGNMENTS);
+    return pickFrom(random, NUMBERS);
+}
+
+std::string mutateStyle(Random &random, const std::string &style)
+{
+    std::vector<std::string> tokens;
+    for (size_t start = 0; start < style.size();)
+    {
+        size_t end = style.find(';', start);
+        if (end == std::string::npos)
+            end = style.size();
+        if (end > start)
+            tokens.push_back(style.substr(start, end - start));
+        start = end + 1;
+    }
+
+    switch (pick(random, 4))
+    {
+    case 0:
+        if (!tokens.empty())
+        {
+            tokens.erase(tokens.begin() + long(pick(random, tokens.size())));
+            break;
+        }
+    // fall through
+    case 1:
+        tokens.insert(tokens.begin() + long(pick(random, tokens.size() + 1)), pickFrom(random, STYLE_NAMES));
+        break;
+    default:
+    {
+        const std::string key = pickFrom(random, STYLE_KEYS);
+        const std::string token = key + "=" + pickValue(random, key);
+        bool replaced = false;
+        for (auto &existing : tokens)
+        {
+            if (existing.compare(0, key.size() + 1, key + "=") == 0)
+            {
+                existing = token;
+                replaced = true;
+            }
+        }
+        if (!replaced)
+            tokens.push_back(token);
+        break;
+    }
+    }
+
+    std::string result;
+    for (const auto &token : tokens)
+        result += token + ";";
+    return result;
+}
+
+std::string randomStyle(Random &random, const bool edge)
+{
+    std::string style = edge && chance(random, 2) ? "edgeStyle=orthogonalEdgeStyle;" : "";
+    if (!edge)
+        style += std::string("shape=") + pickFrom(random, SHAPES) + ";";
+    for (size_t i = pick(random, 3); i > 0; --i)
+        style = mutateStyle(random, style);
+    return style;
+}
+
+Element makePoint(Random &random, const char *const as)
+{
+    Element point("mxPoint");
+    point.set("x", std::to_string(int(random() % 2000) - 500));
+    point.set("y", std::to_string(int(random() % 2000) - 500));
+    if (as)
+        point.set("as", as);
+    return point;
+}
+
+Element makeCell(Random &random, const std::vector<std::string> &ids, const bool edge)
+{
+    Element cell("mxCell");
+    cell.set("id", freshId(random));
+    cell.set("value", chance(random, 2) ? std::string() : pickFrom(random, LABELS));
+    cell.set("style", randomStyle(random, edge));
+    cell.set("parent", ids.size() > 1 && chance(random, 4) ? pickId(random, ids) : "1");
+    Element geometry("mxGeometry");
+    if (edge)
+    {
+        cell.set("edge", "1");
+        if (!ids.empty())
+        {
+            cell.set("source", pickId(random, ids));
+            cell.set("target", pickId(random, ids));
+        }
+        geometry.set("relative", "1");
+        for (const char *const as : EDGE_POINTS)
+        {
+            if (chance(random, 2))
+                geometry.children.push_back(makePoint(random, as));
+        }
+        if (chance(random, 2))
+        {
+            Element points("Array");
+            points.set("as", "points");
+            for (size_t i = pick(random, 4); i > 0; --i)
+                points.children.push_back(makePoint(random, nullptr));
+            geometry.children.push_back(points);
+        }
+    }
+    else
+    {
+        cell.set("vertex", "1");
+        geometry.set("x", std::to_string(random() % 2000));
+        geometry.set("y", std::to_string(random() % 2000));
+        geometry.set("width", std::to_string(1 + random() % 300));
+        geometry.set("height", std::to_string(1 + random() % 300));
+    }
+    geometry.set("as", "geometry");
+    cell.children.push_back(geometry);
+    return cell;
+}
+
+Element makeDocument(Random &random)
+{
+    Element root("root");
+    Element layer0("mxCell");
+    layer0.set("id", "0");
+    root.children.push_back(layer0);
+    Element layer1("mxCell");
+    layer1.set("id", "1");
+    layer1.set("parent", "0");
+    root.children.push_back(layer1);
+
+    std::vector<std::string> ids;
+    for (size_t i = 2 + pick(random, 3); i > 0; --i)
+    {
+        root.children.push_back(makeCell(random, ids, false));
+        ids.push_back(*root.children.back().get("id"));
+    }
+    for (size_t i = 1 + pick(random, 3); i > 0; --i)
+        root.children.push_back(makeCell(random, ids, true));
+
+    Element model("mxGraphModel");
+    model.set("grid", "1");
+    model.set("pageWidth", "827");
+    model.set("pageHeight", "1169");
+    model.children.push_back(root);
+    Element diagram("diagram");
+    diagram.set("id", "fuzz");
+    diagram.set("name", "Page-1");
+    diagram.children.push_back(model);
+    Element document("mxfile");
+    document.set("host", "libdrawio");
+    document.set("compressed", "false");
+    document.children.push_back(diagram);
+    return document;
+}
+
+void convert(xmlNodePtr node, Element &element)
+{
+    element.name = reinterpret_cast<const char *>(node->name);
+    for (xmlAttrPtr attribute = node->properties; attribute; attribute = attribute->next)
+    {
+        xmlChar *const value = xmlNodeListGetString(node->doc, attribute->children, 1);
+        element.attributes.push_back(std::make_pair(std::string(reinterpret_cast<const char *>(attribute->name)),
+                                                    std::string(value ? reinterpret_cast<const char *>(value) : "")));
+        xmlFree(value);
+    }
+    for (xmlNodePtr child = node->children; child; child = child->next)
+    {
+        if (child->type != XML_ELEMENT_NODE)
+            continue;
+        element.children.push_back(Element());
+        convert(child, element.children.back());
+    }
+}
+
+bool read(const uint8_t *const data, const size_t size, Element &document)
+{
+    if (size > INT_MAX)
+        return false;
+    const xmlDocPtr doc = xmlReadMemory(reinterpret_cast<const char *>(data), int(size), nullptr, nullptr,
+                                        XML_PARSE_NONET | XML_PARSE_NOERROR | XML_PARSE_NOWARNING);
+    if (!doc)
+        return false;
+    const xmlNodePtr root = xmlDocGetRootElement(doc);
+    const bool ok = root && xmlStrEqual(root->name, BAD_CAST("mxfile"));
+    if (ok)
+        convert(root, document);
+    xmlFreeDoc(doc);
+    return ok;
+}
+
+void write(const Element &element, std::string &out)
+{
+    out += '<';
+    out += element.name;
+    for (const auto &attribute : element.attributes)
+    {
+        out += ' ';
+        out += attribute.first;
+        out += "=\"";
+        for (const char c : attribute.second)
+        {
+            switch (c)
+            {
+            case '&':
+                out += "&amp;";
+                break;
+            case '<':
+                out += "&lt;";
+                break;
+            case '>':
+                out += "&gt;";
+                break;
+            case '"':
+                out += "&quot;";
+                break;
+            default:
+                if ((unsigned char) c < 0x20)
+                    out += "&#" + std::to_string(unsigned(c)) + ";";
+                else
+                    out += c;
+            }
+        }
+        out += '"';
+    }
+    if (element.children.empty())
+    {
+        out += "/>";
+        return;
+    }
+    out += '>';
+    for (const auto &child : element.children)
+        write(child, out);
+    out += "</";
+    out += element.name;
+    out += '>';
+}
+
+// mutates an attribute value the way libFuzzer mutates bytes, keeping it ASCII
+std::string mutateBytes(const std::string &value)
+{
+    std::string buffer(value);
+    buffer.resize(value.size() + 64);
+    const size_t size = LLVMFuzzerMutate(reinterpret_cast<uint8_t *>(&buffer[0]), value.size(), buffer.size());
+    buffer.resize(size);
+    for (auto &c : buffer)
+    {
+        if ((unsigned char) c >= 0x80 || c == 0)
+            c = '?';
+    }
+    return buffer;
+}
+
+bool mutate(Random &random, Element &document, const Mutation mutation)
+{
+    std::vector<Site> cells;
+    collect(document, isCell, cells);
+
+    switch (mutation)
+    {
+    case MUTATE_STYLE:
+    {
+        if (cells.empty())
+            return false;
+        Element &cell = cells[pick(random, cells.size())].get();
+        const std::string *const style = cell.get("style");
+        cell.set("style", mutateStyle(random, style ? *style : std::string()));
+        return true;
+    }
+    case MUTATE_GEOMETRY:
+    {
+        std::vector<Site> shapes;
+        collectNamed(document, "mxGeometry", shapes);
+        collectNamed(document, "mxPoint", shapes);
+        if (shapes.empty())
+            return false;
+        Element &shape = shapes[pick(random, shapes.size())].get();
+        if (shape.name == "mxGeometry" && chance(random, 8))
+        {
+            shape.set("relative", chance(random, 2) ? "1" : "0");
+            return true;
+        }
+        static const char *const EXTENTS[] = { "x", "y", "width", "height" };
+        const char *const key = shape.name == "mxPoint" ? EXTENTS[pick(random, 2)] : pickFrom(random, EXTENTS);
+        const std::string *const value = shape.get(key);
+        if (value && chance(random, 2))
+        {
+            // a small step away, which keeps most of the layout intact
+            const double old = atof(value->c_str());
+            shape.set(key, std::to_string(old + double(int(random() % 81) - 40)));
+        }
+        else
+            shape.set(key, pickFrom(random, NUMBERS));
+        return true;
+    }
+    case MUTATE_REFERENCE:
+    {
+        if (cells.empty())
+            return false;
+        static const char *const REFERENCES[] = { "parent", "source", "target" };
+        Element &cell = cells[pick(random, cells.size())].get();
+        const char *const key = pickFrom(random, REFERENCES);
+        const std::string *const id = cell.get("id");
+        if (id && chance(random, 4))
+            cell.set(key, *id);
+        else if (chance(random, 8))
+            cell.erase(key);
+        else
+            cell.set(key, pickId(random, collectIds(document)));
+        return true;
+    }
+    case MUTATE_ID:
+    {
+        if (cells.empty())
+            return false;
+        Element &cell = cells[pick(random, cells.size())].get();
+        if (chance(random, 8))
+            cell.erase("id");
+        else
+            cell.set("id", pickId(random, collectIds(document)));
+        return true;
+    }
+    case ADD_CELL:
+    {
+        std::vector<Site> roots;
+        collectNamed(document, "root", roots);
+        if (roots.empty())
+            return false;
+        const std::vector<std::string> ids = collectIds(document);
+        Element &root = roots[pick(random, roots.size())].get();
+        root.children.push_back(makeCell(random, ids, chance(random, 2)));
+        return true;
+    }
+    case REMOVE_CELL:
+    {
+        if (cells.empty())
+            return false;
+        const Site &site = cells[pick(random, cells.size())];
+        site.parent->children.erase(site.parent->children.begin() + long(site.index));
+        return true;
+    }
+    case DUPLICATE_CELL:
+    {
+        if (cells.empty())
+            return false;
+        const Site &site = cells[pick(random, cells.size())];
+        Element copy(site.get());
+        if (chance(random, 2))
+            copy.set("id", freshId(random));
+        site.parent->children.insert(site.parent->children.begin() + long(site.index) + 1, copy);
+        return true;
+    }
+    case MUTATE_WAYPOINTS:
+    {
+        std::vector<Site> edges;
+        for (const auto &site : cells)
+        {
+            const std::string *const edge = site.get().get("edge");
+            if (edge && *edge == "1")
+                edges.push_back(site);
+        }
+        if (edges.empty())
+            return false;
+        Element &edge = edges[pick(random, edges.size())].get();
+        if (edge.children.empty())
+        {
+            Element geometry("mxGeometry");
+            geometry.set("relative", "1");
+            geometry.set("as", "geometry");
+            edge.children.push_back(geometry);
+        }
+        Element &geometry = edge.children.front();
+        if (chance(random, 4))
+        {
+            geometry.children.push_back(makePoint(random, pickFrom(random, EDGE_POINTS)));
+            return true;
+        }
+        Element *points = nullptr;
+        for (auto &child : geometry.children)
+        {
+            if (child.name == "Array")
+                points = &child;
+        }
+        if (!points)
+        {
+            geometry.children.push_back(Element("Array"));
+            points = &geometry.children.back();
+            points->set("as", "points");
+        }
+        if (!points->children.empty() && chance(random, 3))
+            points->children.erase(points->children.begin() + long(pick(random, points->children.size())));
+        else
+            points->children.insert(points->children.begin() + long(pick(random, points->children.size() + 1)),
+                                    makePoint(random, nullptr));
+        return true;
+    }
+    case MUTATE_FLAGS:
+    {
+        if (cells.empty())
+            return false;
+        Element &cell = cells[pick(random, cells.size())].get();
+        const char *const flag = pickFrom(random, FLAGS);
+        if (chance(random, 4))
+            cell.erase(flag);
+        else
+            cell.set(flag, chance(random, 2) ? "1" : "0");
+        return true;
+    }
+    case MUTATE_LABEL:
+    {
+        if (cells.empty())
+            return false;
+        Element &cell = cells[pick(random, cells.size())].get();
+        const char *const key = cell.name == "mxCell" ? "value" : "label";
+        const std::string *const value = cell.get(key);
+        if (value && chance(random, 2))
+            cell.set(key, mutateBytes(*value));
+        else
+            cell.set(key, pickFrom(random, LABELS));
+        if (chance(random, 2))
+        {
+            const std::string *const style = cell.get("style");
+            cell.set("style", (style ? *style : std::string()) + "html=1;whiteSpace=wrap;");
+        }
+        return true;
+    }
+    case MUTATE_PAGES:
+    {
+        std::vector<Site> pages;
+        collectNamed(document, "diagram", pages);
+        if (pages.empty())
+            return false;
+        const Site &site = pages[pick(random, pages.size())];
+        if (pages.size() > 1 && chance(random, 3))
+            site.parent->children.erase(site.parent->children.begin() + long(site.index));
+        else
+        {
+            Element copy(site.get());
+            copy.set("id", freshId(random));
+            site.parent->children.insert(site.parent->children.begin() + long(site.index) + 1, copy);
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// writes the document to data if it fits, dropping cells until it does
+size_t store(Random &random, Element &document, uint8_t *const data, const size_t maxSize)
+{
+    for (unsigned attempt = 0; attempt < 16; ++attempt)
+    {
+        std::string out;
+        write(document, out);
+        if (out.size() <= maxSize)
+        {
+            memcpy(data, out.data(), out.size());
+            return out.size();
+        }
+        if (!mutate(random, document, REMOVE_CELL))
+            break;
+    }
+    return 0;
+}
+
+}
+
+size_t mutateModel(uint8_t *const data, const size_t size, const size_t maxSize, const unsigned seed)
+{
+    Random random(seed);
+    Element document;
+    if (!read(data, size, document) || chance(random, 256))
+    {
+        Element fresh = makeDocument(random);
+        const size_t written = store(random, fresh, data, maxSize);
+        return written ? written : size;
+    }
+
+    // without it the document is not taken as a diagram at all
+    if (!document.get("compressed"))
+        document.set("compressed", "false");
+    for (size_t count = 1 + pick(random, 3); count > 0;)
+    {
+        if (mutate(random, document, Mutation(pick(random, MUTATION_COUNT))))
+            --count;
+        else if (chance(random, 4))
+            break;
+    }
+    const size_t written = store(random, document, data, maxSize);
+    return written ? written : size;
+}
+
+size_t crossOverModels(const uint8_t *const data1, const size_t size1, const uint8_t *const data2, const size_t size2,
+                       uint8_t *const out, const size_t maxOutSize, const unsigned seed)
+{
+    Random random(seed);
+    Element first;
+    Element second;
+    if (!read(data1, size1, first) || !read(data2, size2, second))
+    {
+        const size_t size = size1 < maxOutSize ? size1 : maxOutSize;
+        memcpy(out, data1, size);
+        return size;
+    }
+
+    std::vector<Site> roots;
+    collectNamed(first, "root", roots);
+    std::vector<Site> cells;
+    collect(second, isCell, cells);
+    if (!roots.empty() && !cells.empty())
+    {
+        Element &root = roots[pick(random, roots.size())].get();
+        for (size_t count = 1 + pick(random, cells.size()); count > 0; --count)
+            root.children.push_back(cells[pick(random, cells.size())].get());
+    }
+    const size_t written = store(random, first, out, maxOutSize);
+    if (written)
+        return written;
+    const size_t size = size1 < maxOutSize ? size1 : maxOutSize;
+    memcpy(out, data1, size);
+    return size;
+}
+
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
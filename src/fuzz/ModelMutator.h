@@ -0,0 +1,39 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MODELMUTATOR_H
+#define MODELMUTATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fuzz
+{
+
+/* Mutates an mxfile document in place, keeping it well-formed.
+ *
+ * The document is read as a tree, one structural change is applied
+ * (a style, geometry or id reference edited, a cell added, removed or
+ * duplicated, waypoints changed, a page added or dropped) and the tree
+ * is written back. Input that is not an mxfile is replaced by a small
+ * generated diagram. Returns the new size, at most maxSize.
+ */
+size_t mutateModel(uint8_t *data, size_t size, size_t maxSize, unsigned seed);
+
+/* Writes to out the first document with cells taken over from the second.
+ * Returns the size written, at most maxOutSize.
+ */
+size_t crossOverModels(const uint8_t *data1, size_t size1, const uint8_t *data2, size_t size2,
+                       uint8_t *out, size_t maxOutSize, unsigned seed);
+
+}
+
+#endif
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
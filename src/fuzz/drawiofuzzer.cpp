@@ -9,17 +9,20 @@
 
 #include <cstdint>
 
-#include <librevenge-generators/librevenge-generators.h>
-
 #include <librevenge-stream/librevenge-stream.h>
 
 #include <libdrawio/libdrawio.h>
 
+#include "FuzzBudget.h"
+#include "NullPainter.h"
+
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
 {
     librevenge::RVNGStringStream input(data, size);
-    librevenge::RVNGRawTextGenerator generator(true);
-    DRAWIODocument::parse(input, &generator);
+    bench::NullPainter painter;
+    const fuzz::Budget budget(size);
+    libdrawio::DRAWIODocument::parse(&input, &painter);
+    budget.check(data);
     return 0;
 }
 
@@ -0,0 +1,46 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdint>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "FuzzBudget.h"
+#include "ModelMutator.h"
+#include "NullPainter.h"
+
+/* Like drawiofuzzer, but the inputs are always well-formed diagrams, so
+ * the time goes into styles, geometry, routing and drawing rather than
+ * into XML syntax errors.
+ */
+
+extern "C" size_t LLVMFuzzerCustomMutator(uint8_t *data, size_t size, size_t maxSize, unsigned int seed)
+{
+    return fuzz::mutateModel(data, size, maxSize, seed);
+}
+
+extern "C" size_t LLVMFuzzerCustomCrossOver(const uint8_t *data1, size_t size1, const uint8_t *data2, size_t size2,
+                                            uint8_t *out, size_t maxOutSize, unsigned int seed)
+{
+    return fuzz::crossOverModels(data1, size1, data2, size2, out, maxOutSize, seed);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    librevenge::RVNGStringStream input(data, size);
+    bench::NullPainter painter;
+    const fuzz::Budget budget(size);
+    libdrawio::DRAWIODocument::parse(&input, &painter);
+    budget.check(data);
+    return 0;
+}
+
+/* vim:set shiftwidth=4 softtabstop=4 noexpandtab: */
@@ -0,0 +1,373 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOBase64.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define DRAWIO_BASE64_SSE2 1
+#endif
+// AVX2 is chosen at run time, so it is built for a target of its own
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+#include <immintrin.h>
+#define DRAWIO_BASE64_AVX2 1
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DRAWIO_BASE64_NEON 1
+#endif
+
+namespace libdrawio {
+  namespace {
+    // values of characters that are not part of the alphabet; all of them
+    // have one of the two high bits set
+    const unsigned char INVALID = 0xff;
+    const unsigned char SPACE = 0xfe;
+    const unsigned char PAD = 0xfd;
+
+    struct DecodeTable {
+      unsigned char values[256];
+      DecodeTable() {
+        const char alphabet[] =
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (unsigned char &value : values)
+          value = INVALID;
+        for (unsigned i = 0; i < 64; i++)
+          values[(unsigned char)alphabet[i]] = (unsigned char)i;
+        values[(unsigned char)' '] = values[(unsigned char)'\t'] = SPACE;
+        values[(unsigned char)'\n'] = values[(unsigned char)'\r'] = SPACE;
+        values[(unsigned char)'='] = PAD;
+      }
+    };
+
+    const DecodeTable TABLE;
+
+    /* A kernel decodes whole blocks from in for as long as they hold
+     * nothing but the alphabet, advances in past them and returns the
+     * number of bytes written. It writes exactly 3 bytes for 4 characters,
+     * so it needs no room beyond what the input decodes to.
+     */
+    typedef unsigned long (*KernelFunction)(const unsigned char *&in,
+                                            const unsigned char *end,
+                                            unsigned char *out);
+
+    unsigned long decodeQuads(const unsigned char *&in, const unsigned char *end,
+                              unsigned char *out) {
+      unsigned char *o = out;
+      while (end - in >= 4) {
+        const unsigned a = TABLE.values[in[0]], b = TABLE.values[in[1]];
+        const unsigned c = TABLE.values[in[2]], d = TABLE.values[in[3]];
+        if ((a | b | c | d) & 0xc0)
+          break;
+        const unsigned bits = a << 18 | b << 12 | c << 6 | d;
+        o[0] = (unsigned char)(bits >> 16);
+        o[1] = (unsigned char)(bits >> 8);
+        o[2] = (unsigned char)bits;
+        o += 3;
+        in += 4;
+      }
+      return (unsigned long)(o - out);
+    }
+
+#ifdef DRAWIO_BASE64_SSE2
+    // SSE2 has no byte shuffle, so characters are classified by range
+    __m128i translateSSE2(const __m128i chars, __m128i &valid) {
+      const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+      const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+      const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+      const __m128i plus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+      const __m128i slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+      valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, plus)),
+                           slash);
+      __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-65));
+      shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+      shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(4)));
+      shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(19)));
+      shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(16)));
+      return _mm_add_epi8(chars, shift);
+    }
+
+    // 16 characters to 12 bytes at a time
+    unsigned long decodeSSE2(const unsigned char *&in, const unsigned char *end,
+                             unsigned char *out) {
+      unsigned char *o = out;
+      alignas(16) unsigned char bytes[16];
+      while (end - in >= 16) {
+        __m128i valid;
+        const __m128i values =
+          translateSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), valid);
+        if (_mm_movemask_epi8(valid) != 0xffff)
+          break;
+        // a b c d -> 16 bit (a << 6 | b), (c << 6 | d) -> 32 bit abcd
+        const __m128i pairs = _mm_or_si128(
+          _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x3f)), 6),
+          _mm_srli_epi16(values, 8));
+        const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        // into big endian order, then 6 bytes in each 64 bit half
+        const __m128i swapped = _mm_or_si128(
+          _mm_or_si128(_mm_and_si128(_mm_srli_epi32(groups, 16), _mm_set1_epi32(0xff)),
+                       _mm_and_si128(groups, _mm_set1_epi32(0xff00))),
+          _mm_slli_epi32(_mm_and_si128(groups, _mm_set1_epi32(0xff)), 16));
+        const __m128i packed = _mm_or_si128(
+          _mm_and_si128(swapped, _mm_set_epi32(0, -1, 0, -1)),
+          _mm_srli_epi64(_mm_and_si128(swapped, _mm_set_epi32(-1, 0, -1, 0)), 8));
+        _mm_store_si128(reinterpret_cast<__m128i *>(bytes), packed);
+        memcpy(o, bytes, 6);
+        memcpy(o + 6, bytes + 8, 6);
+        o += 12;
+        in += 16;
+      }
+      return (unsigned long)(o - out);
+    }
+#endif
+
+#ifdef DRAWIO_BASE64_AVX2
+    /* 32 characters to 24 bytes at a time. Characters are checked and
+     * translated with nibble lookups, as described by Muła and Lemire in
+     * "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+     */
+    __attribute__((target("avx2")))
+    unsigned long decodeAVX2(const unsigned char *&in, const unsigned char *end,
+                             unsigned char *out) {
+      // which high nibbles are valid with each low nibble, as bits
+      const __m256i lowMasks = _mm256_setr_epi8(
+        (char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+        (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54,
+        (char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+        (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54);
+      const __m256i highBits = _mm256_setr_epi8(
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0);
+      // value - character for each high nibble; '/' is fixed up on its own
+      const __m256i shifts = _mm256_setr_epi8(
+        0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m256i order = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+      const __m256i nibble = _mm256_set1_epi8(0x0f);
+      unsigned char *o = out;
+      while (end - in >= 32) {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi32(chars, 4), nibble);
+        const __m256i low = _mm256_and_si256(chars, nibble);
+        const __m256i allowed = _mm256_and_si256(_mm256_shuffle_epi8(lowMasks, low),
+                                                 _mm256_shuffle_epi8(highBits, high));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(allowed, _mm256_setzero_si256())))
+          break;
+        const __m256i shift = _mm256_blendv_epi8(
+          _mm256_shuffle_epi8(shifts, high), _mm256_set1_epi8(16),
+          _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/')));
+        const __m256i values = _mm256_add_epi8(chars, shift);
+        // a b c d -> 16 bit (a << 6 | b), (c << 6 | d) -> 32 bit abcd
+        const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_permutevar8x32_epi32(
+          _mm256_shuffle_epi8(groups, order), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(o), _mm256_castsi256_si128(packed));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(o + 16), _mm256_extracti128_si256(packed, 1));
+        o += 24;
+        in += 32;
+      }
+      return (unsigned long)(o - out);
+    }
+
+    bool hasAVX2() {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    }
+#endif
+
+#ifdef DRAWIO_BASE64_NEON
+    uint8x16_t translateNEON(const uint8x16_t chars, uint8x16_t &invalid) {
+      const uint8x16_t upper = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('A')),
+                                        vcleq_u8(chars, vdupq_n_u8('Z')));
+      const uint8x16_t lower = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('a')),
+                                        vcleq_u8(chars, vdupq_n_u8('z')));
+      const uint8x16_t digit = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('0')),
+                                        vcleq_u8(chars, vdupq_n_u8('9')));
+      const uint8x16_t plus = vceqq_u8(chars, vdupq_n_u8('+'));
+      const uint8x16_t slash = vceqq_u8(chars, vdupq_n_u8('/'));
+      const uint8x16_t valid = vorrq_u8(vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, plus)),
+                                        slash);
+      invalid = vorrq_u8(invalid, vmvnq_u8(valid));
+      uint8x16_t shift = vandq_u8(upper, vdupq_n_u8((unsigned char)-65));
+      shift = vorrq_u8(shift, vandq_u8(lower, vdupq_n_u8((unsigned char)-71)));
+      shift = vorrq_u8(shift, vandq_u8(digit, vdupq_n_u8(4)));
+      shift = vorrq_u8(shift, vandq_u8(plus, vdupq_n_u8(19)));
+      shift = vorrq_u8(shift, vandq_u8(slash, vdupq_n_u8(16)));
+      return vaddq_u8(chars, shift);
+    }
+
+    // 64 characters to 48 bytes at a time, deinterleaved by the loads
+    unsigned long decodeNEON(const unsigned char *&in, const unsigned char *end,
+                             unsigned char *out) {
+      unsigned char *o = out;
+      while (end - in >= 64) {
+        const uint8x16x4_t chars = vld4q_u8(in);
+        uint8x16_t invalid = vdupq_n_u8(0);
+        const uint8x16_t a = translateNEON(chars.val[0], invalid);
+        const uint8x16_t b = translateNEON(chars.val[1], invalid);
+        const uint8x16_t c = translateNEON(chars.val[2], invalid);
+        const uint8x16_t d = translateNEON(chars.val[3], invalid);
+        if (vmaxvq_u8(invalid))
+          break;
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+        vst3q_u8(o, bytes);
+        o += 48;
+        in += 64;
+      }
+      return (unsigned long)(o - out);
+    }
+#endif
+
+    // unsupported kernels never get picked, so any entry does for them
+    const KernelFunction KERNELS[Base64Decoder::KERNEL_COUNT] = {
+      decodeQuads,
+#ifdef DRAWIO_BASE64_SSE2
+      decodeSSE2,
+#else
+      decodeQuads,
+#endif
+#ifdef DRAWIO_BASE64_AVX2
+      decodeAVX2,
+#else
+      decodeQuads,
+#endif
+#ifdef DRAWIO_BASE64_NEON
+      decodeNEON
+#else
+      decodeQuads
+#endif
+    };
+  }
+
+  Base64Decoder::Base64Decoder()
+    : m_kernel(getBestKernel()), m_bits(0), m_count(0), m_padded(false),
+      m_failed(false) {}
+
+  Base64Decoder::Base64Decoder(Kernel kernel)
+    : m_kernel(isSupported(kernel) ? kernel : KERNEL_SCALAR), m_bits(0), m_count(0),
+      m_padded(false), m_failed(false) {}
+
+  unsigned long Base64Decoder::decode(const char *in, unsigned long size,
+                                      unsigned char *out) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(in);
+    const unsigned char *const end = p + size;
+    unsigned char *o = out;
+    while (p != end && !m_failed) {
+      // whole groups, for as long as there is nothing but the alphabet
+      if (!m_count && !m_padded) {
+        o += KERNELS[m_kernel](p, end, o);
+        o += decodeQuads(p, end, o);
+        if (p == end)
+          break;
+      }
+      o += decodeSlow(p, end, o);
+    }
+    return (unsigned long)(o - out);
+  }
+
+  // one character at a time, until the end of the group
+  unsigned long Base64Decoder::decodeSlow(const unsigned char *&in,
+                                          const unsigned char *end,
+                                          unsigned char *out) {
+    unsigned char *o = out;
+    while (in != end) {
+      const unsigned char value = TABLE.values[*in++];
+      if (value == SPACE)
+        continue;
+      if (value == INVALID || (value == PAD && m_count < 2)
+          || (value != PAD && m_padded)) {
+        m_failed = true;
+        break;
+      }
+      if (value == PAD) {
+        m_padded = true;
+      } else {
+        m_bits = m_bits << 6 | value;
+        // a byte is complete with the second, third and fourth character
+        if (m_count == 1)
+          *o++ = (unsigned char)(m_bits >> 4);
+        else if (m_count == 2)
+          *o++ = (unsigned char)(m_bits >> 2);
+        else if (m_count == 3)
+          *o++ = (unsigned char)m_bits;
+      }
+      if (++m_count == 4) {
+        m_count = 0;
+        m_bits = 0;
+        break;
+      }
+    }
+    return (unsigned long)(o - out);
+  }
+
+  bool Base64Decoder::finish() const {
+    return !m_failed && m_count != 1;
+  }
+
+  bool Base64Decoder::failed() const {
+    return m_failed;
+  }
+
+  unsigned long Base64Decoder::getMaxDecodedSize(unsigned long size) {
+    // a group started by an earlier call may be completed
+    return size / 4 * 3 + 3;
+  }
+
+  bool Base64Decoder::isSupported(Kernel kernel) {
+    switch (kernel) {
+    case KERNEL_SCALAR:
+      return true;
+#ifdef DRAWIO_BASE64_SSE2
+    case KERNEL_SSE2:
+      return true;
+#endif
+#ifdef DRAWIO_BASE64_AVX2
+    case KERNEL_AVX2: {
+      static const bool supported = hasAVX2();
+      return supported;
+    }
+#endif
+#ifdef DRAWIO_BASE64_NEON
+    case KERNEL_NEON:
+      return true;
+#endif
+    default:
+      return false;
+    }
+  }
+
+  Base64Decoder::Kernel Base64Decoder::getBestKernel() {
+    for (int kernel = KERNEL_COUNT - 1; kernel > KERNEL_SCALAR; kernel--) {
+      if (isSupported((Kernel)kernel))
+        return (Kernel)kernel;
+    }
+    return KERNEL_SCALAR;
+  }
+
+  const char *Base64Decoder::getKernelName(Kernel kernel) {
+    switch (kernel) {
+    case KERNEL_SCALAR:
+      return "scalar";
+    case KERNEL_SSE2:
+      return "sse2";
+    case KERNEL_AVX2:
+      return "avx2";
+    case KERNEL_NEON:
+      return "neon";
+    default:
+      return "";
+    }
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOBASE64_H
+#define DRAWIOBASE64_H
+
+namespace libdrawio {
+  /* Decodes base64 given in pieces of any size.
+   *
+   * Every byte is written as soon as its last character has been seen,
+   * so nothing is held back between calls. White space is skipped and the
+   * padding may be left out at the end; anything else that is not base64
+   * makes the decoder fail for good.
+   *
+   * Runs without white space are decoded by a SIMD kernel where the CPU
+   * has one; the rest goes through the scalar decoder.
+   */
+  class Base64Decoder {
+  public:
+    enum Kernel {
+      KERNEL_SCALAR,
+      KERNEL_SSE2,
+      KERNEL_AVX2,
+      KERNEL_NEON,
+      KERNEL_COUNT
+    };
+
+    // the fastest kernel that this build and CPU can run
+    Base64Decoder();
+    // kernel must be supported
+    explicit Base64Decoder(Kernel kernel);
+    // out must have room for getMaxDecodedSize(size) bytes; returns the
+    // number of bytes written
+    unsigned long decode(const char *in, unsigned long size, unsigned char *out);
+    // whether the input so far was valid and did not stop within a byte
+    bool finish() const;
+    bool failed() const;
+    static unsigned long getMaxDecodedSize(unsigned long size);
+
+    static bool isSupported(Kernel kernel);
+    static Kernel getBestKernel();
+    static const char *getKernelName(Kernel kernel);
+  private:
+    unsigned long decodeSlow(const unsigned char *&in, const unsigned char *end,
+                             unsigned char *out);
+    Kernel m_kernel;
+    unsigned m_bits; // of the current group of four characters
+    unsigned m_count; // characters of the group seen, padding included
+    bool m_padded; // padding was seen, so no more data may follow
+    bool m_failed;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
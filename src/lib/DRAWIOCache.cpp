@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOCache.h"
+#include "libdrawio_utils.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#else
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <thread>
+#endif
+
+#ifndef PACKAGE_VERSION
+#define PACKAGE_VERSION "unknown"
+#endif
+
+namespace libdrawio {
+  namespace {
+    // a strong digest, as entries in a shared directory are replayed unchecked
+    std::string hashInput(librevenge::RVNGInputStream *input, unsigned long maxBytes) {
+      SHA256 hash;
+      unsigned long total = 0;
+      input->seek(0, librevenge::RVNG_SEEK_SET);
+      while (!input->isEnd()) {
+        unsigned long numBytesRead = 0;
+        const unsigned char *data = input->read(65536, numBytesRead);
+        if (!data || !numBytesRead)
+          break;
+        total += numBytesRead;
+        // the limit holds before the input is read in full, not only while it is parsed
+        if (maxBytes && total > maxBytes)
+          throw LimitExceeded(LimitExceeded::INPUT_BYTES);
+        hash.update(data, numBytesRead);
+      }
+      input->seek(0, librevenge::RVNG_SEEK_SET);
+      const char version[] = PACKAGE_VERSION;
+      hash.update(version, sizeof(version));
+      return hash.hexDigest();
+    }
+
+#ifndef HAVE_UNISTD_H
+    // a name no other thread or process picks at the same time
+    std::string uniqueSuffix() {
+      static std::atomic<unsigned> counter(0);
+      std::random_device random;
+      std::ostringstream suffix;
+      suffix << '.' << std::this_thread::get_id() << '.' << counter++ << '.' << random();
+      return suffix.str();
+    }
+#endif
+  }
+
+  DRAWIOCache::DRAWIOCache(const char *directory,
+                           librevenge::RVNGInputStream *input, unsigned long maxInputBytes)
+    : m_path() {
+    m_path = directory;
+    if (!m_path.empty() && m_path.back() != '/')
+      m_path += '/';
+    m_path += hashInput(input, maxInputBytes);
+    m_path += ".dlist";
+  }
+
+  bool DRAWIOCache::replay(librevenge::RVNGDrawingInterface *const *painters,
+                           unsigned count) const {
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = open(m_path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+      close(fd);
+      return false;
+    }
+    void *data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+      return false;
+    const bool replayed =
+      DRAWIODisplayList::replay(static_cast<const unsigned char *>(data),
+                                (unsigned long)info.st_size, painters, count);
+    munmap(data, (size_t)info.st_size);
+    return replayed;
+#else
+    FILE *file = fopen(m_path.c_str(), "rb");
+    if (!file)
+      return false;
+    // doubles keep the buffer suitably aligned for the image
+    std::vector<double> buffer;
+    std::vector<unsigned char> bytes;
+    unsigned char chunk[65536];
+    size_t numBytesRead;
+    while ((numBytesRead = fread(chunk, 1, sizeof(chunk), file)) > 0)
+      bytes.insert(bytes.end(), chunk, chunk + numBytesRead);
+    fclose(file);
+    buffer.resize((bytes.size() + sizeof(double) - 1) / sizeof(double));
+    if (!bytes.empty())
+      memcpy(buffer.data(), bytes.data(), bytes.size());
+    return DRAWIODisplayList::replay(reinterpret_cast<const unsigned char *>(buffer.data()),
+                                     bytes.size(), painters, count);
+#endif
+  }
+
+  void DRAWIOCache::store(const DRAWIODisplayList &list) const {
+    std::vector<unsigned char> image;
+    list.serialize(image);
+    // write to a private name first, so readers never see a partial entry;
+    // threads storing the same entry each get their own
+    std::string tmpPath = m_path;
+#ifdef HAVE_UNISTD_H
+    tmpPath += ".XXXXXX";
+    const int fd = mkstemp(&tmpPath[0]);
+    if (fd < 0)
+      return;
+    // entries hold rendered documents, so they keep mkstemp's owner-only
+    // mode; who else may read them is up to the permissions of the directory
+    FILE *file = fdopen(fd, "wb");
+    if (!file) {
+      close(fd);
+      std::remove(tmpPath.c_str());
+      return;
+    }
+#else
+    tmpPath += uniqueSuffix() + ".tmp";
+    FILE *file = fopen(tmpPath.c_str(), "wb");
+    if (!file)
+      return;
+#endif
+    const bool written = fwrite(image.data(), 1, image.size(), file) == image.size();
+    if (fclose(file) != 0 || !written || std::rename(tmpPath.c_str(), m_path.c_str()) != 0)
+      std::remove(tmpPath.c_str());
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,34 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOCACHE_H
+#define DRAWIOCACHE_H
+
+#include "DRAWIODisplayList.h"
+#include "librevenge-stream/librevenge-stream.h"
+#include "librevenge/librevenge.h"
+#include <string>
+
+namespace libdrawio {
+  /* On-disk cache of display lists.
+   *
+   * Entries are named after the SHA-256 of the whole input and the library
+   * version, so a document that was converted before is replayed straight
+   * from the mapped file without being parsed again. The cache is best
+   * effort: any problem reading or writing an entry just means a miss.
+   */
+  class DRAWIOCache {
+  public:
+    // throws LimitExceeded if the input has more than maxInputBytes, unless 0
+    DRAWIOCache(const char *directory, librevenge::RVNGInputStream *input,
+                unsigned long maxInputBytes);
+    bool replay(librevenge::RVNGDrawingInterface *const *painters,
+                unsigned count) const;
+    void store(const DRAWIODisplayList &list) const;
+  private:
+    std::string m_path;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOCollector.h"
+#include "libdrawio_utils.h"
+#include <string>
+
+namespace libdrawio {
+  thread_local DRAWIOCollector *DRAWIOCollector::s_current = nullptr;
+
+  DRAWIOCollector::Memory::Memory() : bytes() {}
+
+  DRAWIOCollector::Memory &DRAWIOCollector::Memory::operator+=(const Memory &memory) {
+    for (unsigned i = 0; i < DRAWIOStatistics::MEMORY_COUNT; ++i)
+      bytes[i] += memory.bytes[i];
+    return *this;
+  }
+
+  DRAWIOCollector::Memory &DRAWIOCollector::Memory::operator-=(const Memory &memory) {
+    for (unsigned i = 0; i < DRAWIOStatistics::MEMORY_COUNT; ++i)
+      bytes[i] -= memory.bytes[i];
+    return *this;
+  }
+
+  DRAWIOCollector::DRAWIOCollector(DRAWIOStatistics &statistics)
+    : m_statistics(statistics), m_previous(s_current),
+      m_phase(DRAWIOStatistics::PHASE_COUNT), m_styles(), m_memory(),
+      m_totalMemory(0) {
+    m_statistics = DRAWIOStatistics();
+    s_current = this;
+  }
+
+  DRAWIOCollector::~DRAWIOCollector() {
+    s_current = m_previous;
+  }
+
+  void DRAWIOCollector::addStyle(const librevenge::RVNGString &style) {
+    if (m_styles.insert(style.cstr()).second)
+      ++m_statistics.styles;
+  }
+
+  void DRAWIOCollector::allocate(DRAWIOStatistics::Memory category, long long bytes) {
+    m_memory.bytes[category] += bytes;
+    m_totalMemory += bytes;
+    if (bytes > 0)
+      updatePeak();
+  }
+
+  void DRAWIOCollector::allocate(const Memory &memory) {
+    for (unsigned i = 0; i < DRAWIOStatistics::MEMORY_COUNT; ++i)
+      m_totalMemory += memory.bytes[i];
+    m_memory += memory;
+    updatePeak();
+  }
+
+  void DRAWIOCollector::release(const Memory &memory) {
+    for (unsigned i = 0; i < DRAWIOStatistics::MEMORY_COUNT; ++i)
+      m_totalMemory -= memory.bytes[i];
+    m_memory -= memory;
+  }
+
+  void DRAWIOCollector::hold(const Memory &memory) {
+    allocate(memory);
+    release(memory);
+  }
+
+  void DRAWIOCollector::setMemory(DRAWIOStatistics::Memory category, long long bytes) {
+    allocate(category, bytes - m_memory.bytes[category]);
+  }
+
+  long long DRAWIOCollector::getStringSize(const librevenge::RVNGString &str) {
+    // the implementation holds a std::string, which keeps short strings inline
+    const long long size = (long long)str.size();
+    return (long long)sizeof(std::string) + (size < 16 ? 0 : size + 1);
+  }
+
+  void DRAWIOCollector::updatePeak() {
+    for (unsigned i = 0; i < DRAWIOStatistics::MEMORY_COUNT; ++i) {
+      if (m_memory.bytes[i] > 0
+          && (unsigned long long)m_memory.bytes[i] > m_statistics.peakMemoryOf[i])
+        m_statistics.peakMemoryOf[i] = (unsigned long long)m_memory.bytes[i];
+    }
+    if (m_totalMemory <= 0 || (unsigned long long)m_totalMemory <= m_statistics.peakMemory)
+      return;
+    m_statistics.peakMemory = (unsigned long long)m_totalMemory;
+    for (unsigned i = 0; i < DRAWIOStatistics::MEMORY_COUNT; ++i)
+      m_statistics.memory[i] = m_memory.bytes[i] > 0 ? (unsigned long long)m_memory.bytes[i] : 0;
+  }
+
+  DRAWIOCollector::Phase::Phase(DRAWIOStatistics::Phase phase)
+    : m_collector(s_current), m_phase(phase),
+      m_outer(DRAWIOStatistics::PHASE_COUNT), m_start() {
+    if (!m_collector)
+      return;
+    m_outer = m_collector->m_phase;
+    m_collector->m_phase = phase;
+    m_start = std::chrono::steady_clock::now();
+  }
+
+  DRAWIOCollector::Phase::~Phase() {
+    if (!m_collector)
+      return;
+    const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    m_collector->m_statistics.time[m_phase] += elapsed;
+    if (m_outer != DRAWIOStatistics::PHASE_COUNT)
+      m_collector->m_statistics.time[m_outer] -= elapsed;
+    m_collector->m_phase = m_outer;
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
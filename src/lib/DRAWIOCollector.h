@@ -0,0 +1,85 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOCOLLECTOR_H
+#define DRAWIOCOLLECTOR_H
+
+#include <libdrawio/DRAWIOStatistics.h>
+#include "librevenge/RVNGString.h"
+#include <chrono>
+#include <string>
+#include <unordered_set>
+
+namespace libdrawio {
+  /* Gathers DRAWIOStatistics for the conversion running on this thread.
+   *
+   * Instrumented code asks for the current collector, which is null unless
+   * statistics were requested, so when they are not each instrumentation
+   * point costs a thread-local load and a branch. Hot loops count locally
+   * and report once.
+   *
+   * Memory is accounted for by the owners of the big containers, which
+   * report what they hold when it changes. The XML reader is estimated by
+   * the parser, as libxml2's allocator is the host's to set.
+   */
+  class DRAWIOCollector {
+  public:
+    // bytes held in each memory category
+    struct Memory {
+      Memory();
+      Memory &operator+=(const Memory &memory);
+      Memory &operator-=(const Memory &memory);
+      long long bytes[DRAWIOStatistics::MEMORY_COUNT];
+    };
+
+    explicit DRAWIOCollector(DRAWIOStatistics &statistics);
+    ~DRAWIOCollector();
+
+    static DRAWIOCollector *get() { return s_current; }
+    DRAWIOStatistics &statistics() { return m_statistics; }
+    void addStyle(const librevenge::RVNGString &style);
+
+    void allocate(DRAWIOStatistics::Memory category, long long bytes);
+    void allocate(const Memory &memory);
+    void release(const Memory &memory);
+    // memory held for a moment, like a container while it is copied
+    void hold(const Memory &memory);
+    void setMemory(DRAWIOStatistics::Memory category, long long bytes);
+
+    // estimated heap bytes of a string, its implementation included
+    static long long getStringSize(const librevenge::RVNGString &str);
+
+    // times a phase, less the phases nested in it
+    class Phase {
+    public:
+      explicit Phase(DRAWIOStatistics::Phase phase);
+      ~Phase();
+    private:
+      DRAWIOCollector *const m_collector;
+      DRAWIOStatistics::Phase m_phase;
+      DRAWIOStatistics::Phase m_outer;
+      std::chrono::steady_clock::time_point m_start;
+
+      Phase(const Phase &phase);
+      Phase &operator=(const Phase &phase);
+    };
+
+  private:
+    static thread_local DRAWIOCollector *s_current;
+
+    DRAWIOStatistics &m_statistics;
+    DRAWIOCollector *const m_previous;
+    DRAWIOStatistics::Phase m_phase; // PHASE_COUNT outside of any phase
+    std::unordered_set<std::string> m_styles;
+    Memory m_memory;
+    long long m_totalMemory;
+
+    void updatePeak();
+
+    DRAWIOCollector(const DRAWIOCollector &collector);
+    DRAWIOCollector &operator=(const DRAWIOCollector &collector);
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,51 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOConnections.h"
+#include "DRAWIOShapes.h"
+#include "MXCell.h"
+#include "libdrawio_utils.h"
+
+namespace libdrawio {
+  DRAWIOConnection::DRAWIOConnection()
+    : x(), y(), width(), height(), cx(), cy(), rotation(), rotationTurn(),
+      facingTurn(), direction(EAST), perimeter() {}
+
+  DRAWIOConnectionCache::DRAWIOConnectionCache(
+    const std::map<librevenge::RVNGString, MXCell> &cells)
+    : m_cells(cells), m_connections() {}
+
+  size_t DRAWIOConnectionCache::IdHash::operator()(const librevenge::RVNGString &id) const {
+    return (size_t)hashBytes(id.cstr(), id.size());
+  }
+
+  const DRAWIOConnection &DRAWIOConnectionCache::get(const librevenge::RVNGString &id) {
+    auto it = m_connections.find(id);
+    if (it != m_connections.end())
+      return it->second;
+
+    DRAWIOConnection &connection = m_connections[id];
+    auto cell = m_cells.find(id);
+    if (cell == m_cells.end())
+      return connection;
+    const MXCell &shape = cell->second;
+    connection.x = shape.geometry.x; connection.y = shape.geometry.y;
+    if (!shape.parent_id.empty()) {
+      auto parent = m_cells.find(shape.parent_id);
+      if (parent != m_cells.end()) {
+        connection.x += parent->second.geometry.x;
+        connection.y += parent->second.geometry.y;
+      }
+    }
+    connection.width = shape.geometry.width; connection.height = shape.geometry.height;
+    connection.cx = connection.x + connection.width / 2;
+    connection.cy = connection.y + connection.height / 2;
+    connection.rotation = shape.style.rotation;
+    connection.rotationTurn = ShapeTurn(EAST, shape.style.rotation);
+    connection.facingTurn = ShapeTurn(shape.style.direction, shape.style.rotation);
+    connection.direction = shape.style.direction;
+    connection.perimeter = getPerimeterShape(shape);
+    return connection;
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,48 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOCONNECTIONS_H
+#define DRAWIOCONNECTIONS_H
+
+#include "DRAWIOPerimeter.h"
+#include "DRAWIOTypes.h"
+#include "librevenge/RVNGString.h"
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+
+namespace libdrawio {
+  struct MXCell;
+
+  // what routing an edge needs to know of a vertex at one of its ends
+  struct DRAWIOConnection {
+    double x, y, width, height; // on the page, with the offset of the parent
+    double cx, cy; // the center
+    double rotation; // in degrees, as in the style
+    ShapeTurn rotationTurn; // by the rotation alone, about the center
+    ShapeTurn facingTurn; // by the direction and the rotation
+    Direction direction;
+    PerimeterShape perimeter;
+    DRAWIOConnection();
+  };
+
+  /* The connections of the vertices of one page, each taken from its cell
+   * the first time an edge asks for it, so that a vertex with many edges
+   * is looked up and measured once.
+   */
+  class DRAWIOConnectionCache {
+  public:
+    explicit DRAWIOConnectionCache(const std::map<librevenge::RVNGString, MXCell> &cells);
+    // a missing cell connects as a default one
+    const DRAWIOConnection &get(const librevenge::RVNGString &id);
+  private:
+    struct IdHash {
+      size_t operator()(const librevenge::RVNGString &id) const;
+    };
+    const std::map<librevenge::RVNGString, MXCell> &m_cells;
+    std::unordered_map<librevenge::RVNGString, DRAWIOConnection, IdHash> m_connections;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,523 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIODisplayList.h"
+#include "DRAWIOCollector.h"
+#include "librevenge/RVNGPropertyList.h"
+#include "librevenge/RVNGPropertyListVector.h"
+#include <cstdint>
+#include <cstring>
+
+namespace libdrawio {
+  namespace {
+    const char IMAGE_MAGIC[] = "DRAWIODL";
+    const unsigned IMAGE_VERSION = 3;
+    // longer values, like most labels, seldom repeat and are not looked up
+    const size_t MAX_INTERNED_SIZE = 32;
+
+    struct ImageHeader {
+      char magic[8];
+      unsigned version;
+      // ops, properties, steps, numbers, chars, strings, binaries, bytes
+      unsigned counts[8];
+      unsigned padding;
+    };
+
+    // sections start on 8 byte boundaries so the numbers can be read in place
+    unsigned long sectionSize(unsigned long size) {
+      return (size + 7) & ~7UL;
+    }
+
+    void appendSection(std::vector<unsigned char> &out, const void *data,
+                       unsigned long size) {
+      const auto *bytes = static_cast<const unsigned char *>(data);
+      if (size)
+        out.insert(out.end(), bytes, bytes + size);
+      out.resize(out.size() + sectionSize(size) - size, 0);
+    }
+  }
+
+  void DRAWIODisplayList::insert(const char *key, double value,
+                                 librevenge::RVNGUnit unit) {
+    m_properties.push_back({intern(key), VALUE_DOUBLE, unit,
+                            (unsigned)m_numbers.size(), 0});
+    m_numbers.push_back(value);
+  }
+
+  void DRAWIODisplayList::insert(const char *key, int value) {
+    m_properties.push_back({intern(key), VALUE_INT, librevenge::RVNG_GENERIC,
+                            (unsigned)value, 0});
+  }
+
+  void DRAWIODisplayList::insert(const char *key, const char *value) {
+    const unsigned id = strlen(value) < MAX_INTERNED_SIZE ? intern(value) : store(value);
+    m_properties.push_back({intern(key), VALUE_STRING, librevenge::RVNG_GENERIC, id, 0});
+  }
+
+  void DRAWIODisplayList::insert(const char *key,
+                                 const librevenge::RVNGString &value) {
+    insert(key, value.cstr());
+  }
+
+  void DRAWIODisplayList::insert(const char *key, const Path &path) {
+    m_properties.push_back({intern(key), VALUE_PATH, librevenge::RVNG_GENERIC,
+                            path.first, path.count});
+  }
+
+  void DRAWIODisplayList::insert(const char *key, const librevenge::RVNGBinaryData &data,
+                                 uint64_t hash) {
+    unsigned id = (unsigned)m_binaries.size();
+    const auto range = m_binaryIds.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      const librevenge::RVNGBinaryData &binary = m_binaries[it->second];
+      if (binary.size() == data.size()
+          && (binary.getDataBuffer() == data.getDataBuffer()
+              || !memcmp(binary.getDataBuffer(), data.getDataBuffer(), data.size()))) {
+        id = it->second;
+        break;
+      }
+    }
+    if (id == m_binaries.size()) {
+      m_binaries.push_back(data);
+      m_binaryIds.emplace(hash, id);
+    }
+    m_properties.push_back({intern(key), VALUE_BINARY, librevenge::RVNG_GENERIC, id, 0});
+  }
+
+  DRAWIODisplayList::Props DRAWIODisplayList::closeProps() {
+    Props props(m_openProps, (unsigned)m_properties.size() - m_openProps);
+    m_openProps = (unsigned)m_properties.size();
+    return props;
+  }
+
+  void DRAWIODisplayList::pathStep(char action, const std::vector<MXPoint> &points) {
+    m_steps.push_back({action, (unsigned)points.size(), (unsigned)m_numbers.size()});
+    for (const auto &point : points) {
+      m_numbers.push_back(point.x);
+      m_numbers.push_back(point.y);
+    }
+  }
+
+  DRAWIODisplayList::Path DRAWIODisplayList::closePath() {
+    Path path(m_openPath, (unsigned)m_steps.size() - m_openPath);
+    m_openPath = (unsigned)m_steps.size();
+    return path;
+  }
+
+  void DRAWIODisplayList::replace(const char *key, const char *from, const char *to) {
+    const unsigned keyId = findString(key);
+    if (keyId == NO_STRING)
+      return;
+    unsigned toId = NO_STRING;
+    for (auto &property : m_properties) {
+      if (property.key != keyId || property.type != VALUE_STRING || strcmp(getString(property.value), from))
+        continue;
+      if (toId == NO_STRING)
+        toId = strlen(to) < MAX_INTERNED_SIZE ? intern(to) : store(to);
+      property.value = toId;
+    }
+  }
+
+  void DRAWIODisplayList::replace(const char *key, int from, int to) {
+    const unsigned keyId = findString(key);
+    if (keyId == NO_STRING)
+      return;
+    for (auto &property : m_properties) {
+      if (property.key == keyId && property.type == VALUE_INT && property.value == (unsigned)from)
+        property.value = (unsigned)to;
+    }
+  }
+
+  void DRAWIODisplayList::append(OpType type, const Props &props) {
+    m_ops.push_back({type, props.first, props.count});
+  }
+
+  void DRAWIODisplayList::appendText(const char *text) {
+    m_ops.push_back({INSERT_TEXT, store(text), 0});
+  }
+
+  void DRAWIODisplayList::appendText(const librevenge::RVNGString &text) {
+    appendText(text.cstr());
+  }
+
+  void DRAWIODisplayList::replay(librevenge::RVNGDrawingInterface *painter) const {
+    replay(pools(), painter);
+  }
+
+  void DRAWIODisplayList::serialize(std::vector<unsigned char> &out) const {
+    const Pools p = pools();
+    ImageHeader header;
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+    header.version = IMAGE_VERSION;
+    header.counts[0] = p.opCount;
+    header.counts[1] = p.propertyCount;
+    header.counts[2] = p.stepCount;
+    header.counts[3] = p.numberCount;
+    header.counts[4] = p.charCount;
+    header.counts[5] = p.stringCount;
+    std::vector<Binary> binaries;
+    binaries.reserve(m_binaries.size());
+    unsigned long byteCount = 0;
+    for (const auto &binary : m_binaries) {
+      binaries.push_back({byteCount, binary.size()});
+      byteCount += binary.size();
+    }
+    header.counts[6] = (unsigned)binaries.size();
+    header.counts[7] = (unsigned)byteCount;
+    header.padding = 0;
+    out.clear();
+    appendSection(out, &header, sizeof(header));
+    appendSection(out, p.ops, p.opCount * sizeof(Op));
+    appendSection(out, p.properties, p.propertyCount * sizeof(Property));
+    appendSection(out, p.steps, p.stepCount * sizeof(PathStep));
+    appendSection(out, p.numbers, p.numberCount * sizeof(double));
+    appendSection(out, p.chars, p.charCount);
+    appendSection(out, p.strings, p.stringCount * sizeof(unsigned));
+    appendSection(out, binaries.data(), binaries.size() * sizeof(Binary));
+    for (const auto &binary : m_binaries) {
+      if (!binary.empty())
+        out.insert(out.end(), binary.getDataBuffer(), binary.getDataBuffer() + binary.size());
+    }
+    out.resize(out.size() + sectionSize(byteCount) - byteCount, 0);
+  }
+
+  bool DRAWIODisplayList::replay(const unsigned char *data, unsigned long size,
+                                 librevenge::RVNGDrawingInterface *const *painters,
+                                 unsigned count) {
+    if (!data || size < sizeof(ImageHeader) || (uintptr_t)data % alignof(double))
+      return false;
+    ImageHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, IMAGE_MAGIC, sizeof(header.magic))
+        || header.version != IMAGE_VERSION)
+      return false;
+    const unsigned char *sections[8];
+    const unsigned long sizes[8] = {
+      sizeof(Op), sizeof(Property), sizeof(PathStep), sizeof(double), 1, sizeof(unsigned),
+      sizeof(Binary), 1
+    };
+    unsigned long offset = sectionSize(sizeof(ImageHeader));
+    for (unsigned i = 0; i < 8; i++) {
+      const unsigned long length = (unsigned long)header.counts[i] * sizes[i];
+      if (offset > size || length > size - offset)
+        return false;
+      sections[i] = data + offset;
+      offset += sectionSize(length);
+    }
+    Pools p;
+    p.ops = reinterpret_cast<const Op *>(sections[0]);
+    p.properties = reinterpret_cast<const Property *>(sections[1]);
+    p.steps = reinterpret_cast<const PathStep *>(sections[2]);
+    p.numbers = reinterpret_cast<const double *>(sections[3]);
+    p.chars = reinterpret_cast<const char *>(sections[4]);
+    p.strings = reinterpret_cast<const unsigned *>(sections[5]);
+    p.opCount = header.counts[0];
+    p.propertyCount = header.counts[1];
+    p.stepCount = header.counts[2];
+    p.numberCount = header.counts[3];
+    p.charCount = header.counts[4];
+    p.stringCount = header.counts[5];
+    // the binaries are made once, so that all painters share them
+    const Binary *const binaryTable = reinterpret_cast<const Binary *>(sections[6]);
+    const unsigned long byteCount = header.counts[7];
+    std::vector<librevenge::RVNGBinaryData> binaries;
+    binaries.reserve(header.counts[6]);
+    for (unsigned i = 0; i < header.counts[6]; i++) {
+      const Binary &binary = binaryTable[i];
+      if (binary.first > byteCount || binary.size > byteCount - binary.first)
+        return false;
+      binaries.emplace_back(sections[7] + binary.first, binary.size);
+    }
+    p.binaries = binaries.data();
+    p.binaryCount = (unsigned)binaries.size();
+    if (!validate(p))
+      return false;
+    for (unsigned i = 0; i < count; i++)
+      replay(p, painters[i]);
+    return true;
+  }
+
+  void DRAWIODisplayList::replay(const Pools &pools,
+                                 librevenge::RVNGDrawingInterface *painter) {
+    if (!painter)
+      return;
+    librevenge::RVNGPropertyList propList;
+    unsigned long long calls = 0;
+    for (unsigned i = 0; i < pools.opCount; i++) {
+      const Op &op = pools.ops[i];
+      ++calls;
+      propList.clear();
+      if (op.type != INSERT_TEXT)
+        fillProps(pools, propList, op.first, op.count);
+      switch (op.type) {
+      case START_DOCUMENT:
+        painter->startDocument(propList);
+        break;
+      case END_DOCUMENT:
+        painter->endDocument();
+        break;
+      case START_PAGE:
+        painter->startPage(propList);
+        break;
+      case END_PAGE:
+        painter->endPage();
+        break;
+      case SET_STYLE:
+        painter->setStyle(propList);
+        break;
+      case OPEN_GROUP:
+        painter->openGroup(propList);
+        break;
+      case CLOSE_GROUP:
+        painter->closeGroup();
+        break;
+      case DRAW_RECTANGLE:
+        painter->drawRectangle(propList);
+        break;
+      case DRAW_ELLIPSE:
+        painter->drawEllipse(propList);
+        break;
+      case DRAW_PATH:
+        painter->drawPath(propList);
+        break;
+      case DRAW_CONNECTOR:
+        painter->drawConnector(propList);
+        break;
+      case START_TEXT_OBJECT:
+        painter->startTextObject(propList);
+        break;
+      case END_TEXT_OBJECT:
+        painter->endTextObject();
+        break;
+      case DEFINE_CHARACTER_STYLE:
+        painter->defineCharacterStyle(propList);
+        break;
+      case OPEN_PARAGRAPH:
+        painter->openParagraph(propList);
+        break;
+      case CLOSE_PARAGRAPH:
+        painter->closeParagraph();
+        break;
+      case OPEN_SPAN:
+        painter->openSpan(propList);
+        break;
+      case CLOSE_SPAN:
+        painter->closeSpan();
+        break;
+      case INSERT_TEXT:
+        painter->insertText(librevenge::RVNGString(string(pools, op.first)));
+        break;
+      case INSERT_LINE_BREAK:
+        painter->insertLineBreak();
+        break;
+      case DRAW_GRAPHIC_OBJECT:
+        painter->drawGraphicObject(propList);
+        break;
+      }
+    }
+    if (DRAWIOCollector *collector = DRAWIOCollector::get())
+      collector->statistics().painterCalls += calls;
+  }
+
+  bool DRAWIODisplayList::empty() const {
+    return m_ops.empty();
+  }
+
+  void DRAWIODisplayList::clear() {
+    *this = DRAWIODisplayList();
+  }
+
+  unsigned DRAWIODisplayList::intern(const char *str) {
+    auto it = m_stringIds.find(str);
+    if (it != m_stringIds.end())
+      return it->second;
+    const unsigned id = store(str);
+    m_stringIds.emplace(str, id);
+    return id;
+  }
+
+  unsigned DRAWIODisplayList::store(const char *str) {
+    const unsigned id = (unsigned)m_strings.size();
+    m_strings.push_back((unsigned)m_chars.size());
+    m_chars.insert(m_chars.end(), str, str + strlen(str) + 1);
+    return id;
+  }
+
+  const std::vector<DRAWIODisplayList::Op> &DRAWIODisplayList::getOps() const {
+    return m_ops;
+  }
+
+  const DRAWIODisplayList::Property &DRAWIODisplayList::getProperty(unsigned index) const {
+    return m_properties[index];
+  }
+
+  const DRAWIODisplayList::PathStep &DRAWIODisplayList::getPathStep(unsigned index) const {
+    return m_steps[index];
+  }
+
+  unsigned DRAWIODisplayList::getPathStepCount() const {
+    return (unsigned)m_steps.size();
+  }
+
+  unsigned long long DRAWIODisplayList::getMemoryUsage() const {
+    unsigned long long bytes = m_ops.capacity() * sizeof(Op)
+      + m_properties.capacity() * sizeof(Property)
+      + m_steps.capacity() * sizeof(PathStep)
+      + m_numbers.capacity() * sizeof(double)
+      + m_chars.capacity()
+      + m_strings.capacity() * sizeof(unsigned)
+      + m_stringIds.bucket_count() * sizeof(void *)
+      // the data is shared with the images it came from
+      + m_binaries.capacity() * sizeof(librevenge::RVNGBinaryData)
+      + m_binaryIds.bucket_count() * sizeof(void *)
+      + m_binaryIds.size() * (2 * sizeof(void *) + sizeof(std::pair<uint64_t, unsigned>));
+    // a hash node holds the next pointer and the cached hash besides the entry
+    for (const auto &entry : m_stringIds)
+      bytes += 2 * sizeof(void *) + sizeof(entry) + (entry.first.size() < 16 ? 0 : entry.first.size() + 1);
+    return bytes;
+  }
+
+  double DRAWIODisplayList::getNumber(unsigned index) const {
+    return m_numbers[index];
+  }
+
+  const char *DRAWIODisplayList::getString(unsigned id) const {
+    return &m_chars[m_strings[id]];
+  }
+
+  unsigned DRAWIODisplayList::getStringCount() const {
+    return (unsigned)m_strings.size();
+  }
+
+  const librevenge::RVNGBinaryData &DRAWIODisplayList::getBinary(unsigned id) const {
+    return m_binaries[id];
+  }
+
+  unsigned DRAWIODisplayList::findString(const char *str) const {
+    auto it = m_stringIds.find(str);
+    return it == m_stringIds.end() ? NO_STRING : it->second;
+  }
+
+  const char *DRAWIODisplayList::string(const Pools &pools, unsigned id) {
+    return pools.chars + pools.strings[id];
+  }
+
+  DRAWIODisplayList::Pools DRAWIODisplayList::pools() const {
+    Pools p;
+    p.ops = m_ops.data();
+    p.properties = m_properties.data();
+    p.steps = m_steps.data();
+    p.numbers = m_numbers.data();
+    p.chars = m_chars.data();
+    p.strings = m_strings.data();
+    p.opCount = (unsigned)m_ops.size();
+    p.propertyCount = (unsigned)m_properties.size();
+    p.stepCount = (unsigned)m_steps.size();
+    p.numberCount = (unsigned)m_numbers.size();
+    p.charCount = (unsigned)m_chars.size();
+    p.stringCount = (unsigned)m_strings.size();
+    p.binaries = m_binaries.data();
+    p.binaryCount = (unsigned)m_binaries.size();
+    return p;
+  }
+
+  bool DRAWIODisplayList::validate(const Pools &pools) {
+    // every index is checked, so a damaged image can't make replay read
+    // outside of it
+    if (pools.charCount && pools.chars[pools.charCount - 1])
+      return false;
+    for (unsigned i = 0; i < pools.stringCount; i++) {
+      if (pools.strings[i] >= pools.charCount)
+        return false;
+    }
+    for (unsigned i = 0; i < pools.stepCount; i++) {
+      const PathStep &step = pools.steps[i];
+      if (step.first > pools.numberCount
+          || step.points > (pools.numberCount - step.first) / 2)
+        return false;
+    }
+    for (unsigned i = 0; i < pools.propertyCount; i++) {
+      const Property &prop = pools.properties[i];
+      if (prop.key >= pools.stringCount)
+        return false;
+      switch ((unsigned)prop.type) {
+      case VALUE_DOUBLE:
+        if (prop.value >= pools.numberCount
+            || (unsigned)prop.unit > (unsigned)librevenge::RVNG_UNIT_ERROR)
+          return false;
+        break;
+      case VALUE_INT:
+        break;
+      case VALUE_STRING:
+        if (prop.value >= pools.stringCount)
+          return false;
+        break;
+      case VALUE_PATH:
+        if (prop.value > pools.stepCount || prop.count > pools.stepCount - prop.value)
+          return false;
+        break;
+      case VALUE_BINARY:
+        if (prop.value >= pools.binaryCount)
+          return false;
+        break;
+      default:
+        return false;
+      }
+    }
+    for (unsigned i = 0; i < pools.opCount; i++) {
+      const Op &op = pools.ops[i];
+      if ((unsigned)op.type > (unsigned)DRAW_GRAPHIC_OBJECT)
+        return false;
+      if (op.type == INSERT_TEXT) {
+        if (op.first >= pools.stringCount)
+          return false;
+      } else if (op.first > pools.propertyCount
+                 || op.count > pools.propertyCount - op.first) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void DRAWIODisplayList::fillProps(const Pools &pools,
+                                    librevenge::RVNGPropertyList &propList,
+                                    unsigned first, unsigned count) {
+    for (unsigned i = first; i < first + count; i++) {
+      const Property &prop = pools.properties[i];
+      const char *key = string(pools, prop.key);
+      switch (prop.type) {
+      case VALUE_DOUBLE:
+        propList.insert(key, pools.numbers[prop.value], prop.unit);
+        break;
+      case VALUE_INT:
+        propList.insert(key, (int)prop.value);
+        break;
+      case VALUE_STRING:
+        propList.insert(key, string(pools, prop.value));
+        break;
+      case VALUE_PATH: {
+        static const char *const xs[] = {"svg:x", "svg:x1", "svg:x2"};
+        static const char *const ys[] = {"svg:y", "svg:y1", "svg:y2"};
+        librevenge::RVNGPropertyListVector path;
+        for (unsigned j = prop.value; j < prop.value + prop.count; j++) {
+          const PathStep &step = pools.steps[j];
+          const char action[] = {step.action, 0};
+          librevenge::RVNGPropertyList element;
+          element.insert("librevenge:path-action", action);
+          for (unsigned k = 0; k < step.points && k < 3; k++) {
+            element.insert(xs[k], pools.numbers[step.first + 2*k]);
+            element.insert(ys[k], pools.numbers[step.first + 2*k + 1]);
+          }
+          path.append(element);
+        }
+        propList.insert(key, path);
+        break;
+      }
+      case VALUE_BINARY:
+        propList.insert(key, pools.binaries[prop.value]);
+        break;
+      }
+    }
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,195 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIODISPLAYLIST_H
+#define DRAWIODISPLAYLIST_H
+
+#include "MXGeometry.h"
+#include "librevenge/RVNGString.h"
+#include "librevenge/librevenge.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace libdrawio {
+  /* Flat recording of the painter calls produced for a document.
+   *
+   * Ops, their properties, path steps and strings all live in a handful
+   * of contiguous pools, so a document laid out once can be replayed to
+   * any number of painters without rerunning style and edge resolution.
+   */
+  class DRAWIODisplayList {
+  public:
+    enum OpType {
+      START_DOCUMENT,
+      END_DOCUMENT,
+      START_PAGE,
+      END_PAGE,
+      SET_STYLE,
+      OPEN_GROUP,
+      CLOSE_GROUP,
+      DRAW_RECTANGLE,
+      DRAW_ELLIPSE,
+      DRAW_PATH,
+      DRAW_CONNECTOR,
+      START_TEXT_OBJECT,
+      END_TEXT_OBJECT,
+      DEFINE_CHARACTER_STYLE,
+      OPEN_PARAGRAPH,
+      CLOSE_PARAGRAPH,
+      OPEN_SPAN,
+      CLOSE_SPAN,
+      INSERT_TEXT,
+      INSERT_LINE_BREAK,
+      DRAW_GRAPHIC_OBJECT
+    };
+
+    enum ValueType {
+      VALUE_DOUBLE,
+      VALUE_INT,
+      VALUE_STRING,
+      VALUE_PATH,
+      VALUE_BINARY
+    };
+
+    // a run of properties in the property pool
+    struct Props {
+      unsigned first, count;
+      Props() : first(0), count(0) {}
+      Props(unsigned f, unsigned c) : first(f), count(c) {}
+    };
+
+    // a run of steps in the path pool
+    struct Path {
+      unsigned first, count;
+      Path() : first(0), count(0) {}
+      Path(unsigned f, unsigned c) : first(f), count(c) {}
+    };
+
+    struct Op {
+      OpType type;
+      unsigned first, count; // property run, or string id for INSERT_TEXT
+    };
+
+    struct Property {
+      unsigned key; // string id
+      ValueType type;
+      librevenge::RVNGUnit unit;
+      unsigned value; // number index, int value, string id, first path step or binary id
+      unsigned count; // number of path steps
+    };
+
+    struct PathStep {
+      char action;
+      unsigned points; // number of (x, y) pairs in the number pool
+      unsigned first;
+    };
+
+    // a run of bytes in the byte pool of a serialized image
+    struct Binary {
+      unsigned long first, size;
+    };
+
+    DRAWIODisplayList()
+      : m_ops(), m_properties(), m_steps(), m_numbers(), m_chars(),
+        m_strings(), m_stringIds(), m_binaries(), m_binaryIds(), m_openProps(0),
+        m_openPath(0) {}
+    DRAWIODisplayList(const DRAWIODisplayList &list) = default;
+    DRAWIODisplayList(DRAWIODisplayList &&list) = default;
+    DRAWIODisplayList &operator=(const DRAWIODisplayList &list) = default;
+    DRAWIODisplayList &operator=(DRAWIODisplayList &&list) = default;
+
+    // properties are collected into the open run until closeProps()
+    void insert(const char *key, double value,
+                librevenge::RVNGUnit unit = librevenge::RVNG_INCH);
+    void insert(const char *key, int value);
+    void insert(const char *key, const char *value);
+    void insert(const char *key, const librevenge::RVNGString &value);
+    void insert(const char *key, const Path &path);
+    // equal data, by hash (hashBytes) and content, is recorded once, so
+    // that every painter call shares one buffer
+    void insert(const char *key, const librevenge::RVNGBinaryData &data, uint64_t hash);
+    Props closeProps();
+
+    // path steps are collected into the open path until closePath()
+    void pathStep(char action, const std::vector<MXPoint> &points);
+    Path closePath();
+
+    // points the properties named key that hold from to to instead, so that
+    // names in a recording can change without recording it again
+    void replace(const char *key, const char *from, const char *to);
+    void replace(const char *key, int from, int to);
+
+    void append(OpType type, const Props &props = Props());
+    void appendText(const char *text);
+    void appendText(const librevenge::RVNGString &text);
+
+    void replay(librevenge::RVNGDrawingInterface *painter) const;
+    bool empty() const;
+    void clear();
+
+    // read access for writers that consume the recording directly
+    static const unsigned NO_STRING = ~0u;
+    const std::vector<Op> &getOps() const;
+    const Property &getProperty(unsigned index) const;
+    const PathStep &getPathStep(unsigned index) const;
+    unsigned getPathStepCount() const;
+    // estimated heap bytes of the pools
+    unsigned long long getMemoryUsage() const;
+    double getNumber(unsigned index) const;
+    const char *getString(unsigned id) const;
+    unsigned getStringCount() const;
+    // NO_STRING if never used as a key or a short value
+    unsigned findString(const char *str) const;
+    const librevenge::RVNGBinaryData &getBinary(unsigned id) const;
+
+    /* Binary image of the pools, laid out so that it can be mapped from
+     * disk and replayed in place. It is only meant to be read back by the
+     * same build on the same machine.
+     */
+    void serialize(std::vector<unsigned char> &out) const;
+    static bool replay(const unsigned char *data, unsigned long size,
+                       librevenge::RVNGDrawingInterface *const *painters,
+                       unsigned count);
+
+  private:
+    // read-only view of the pools, either our own or a serialized image
+    struct Pools {
+      const Op *ops;
+      const Property *properties;
+      const PathStep *steps;
+      const double *numbers;
+      const char *chars;
+      const unsigned *strings;
+      const librevenge::RVNGBinaryData *binaries;
+      unsigned opCount, propertyCount, stepCount, numberCount, charCount,
+               stringCount, binaryCount;
+    };
+
+    // property keys and short values are shared through m_stringIds;
+    // text and long values are stored as they come
+    unsigned intern(const char *str);
+    unsigned store(const char *str);
+    Pools pools() const;
+    static const char *string(const Pools &pools, unsigned id);
+    static bool validate(const Pools &pools);
+    static void replay(const Pools &pools, librevenge::RVNGDrawingInterface *painter);
+    static void fillProps(const Pools &pools, librevenge::RVNGPropertyList &propList,
+                          unsigned first, unsigned count);
+
+    std::vector<Op> m_ops;
+    std::vector<Property> m_properties;
+    std::vector<PathStep> m_steps;
+    std::vector<double> m_numbers;
+    std::vector<char> m_chars;
+    std::vector<unsigned> m_strings; // string id -> offset in m_chars
+    std::unordered_map<std::string, unsigned> m_stringIds;
+    std::vector<librevenge::RVNGBinaryData> m_binaries;
+    std::unordered_multimap<uint64_t, unsigned> m_binaryIds; // by hash
+    unsigned m_openProps, m_openPath;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
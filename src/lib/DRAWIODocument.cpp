@@ -8,6 +8,7 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
 
@@ -15,7 +16,11 @@
 
 #include <libdrawio/libdrawio.h>
 
+#include "DRAWIOCache.h"
+#include "DRAWIOCollector.h"
 #include "DRAWIOParser.h"
+#include "DRAWIOSVGWriter.h"
+#include "DRAWIOTracer.h"
 #include "libdrawio_utils.h"
 #include "libdrawio_xml.h"
 #include "librevenge-stream/librevenge-stream.h"
@@ -30,6 +35,64 @@ using std::shared_ptr;
 namespace libdrawio
 {
 
+namespace
+{
+
+librevenge::RVNGString readAttribute(xmlTextReaderPtr reader, const char *name)
+{
+  const std::shared_ptr<xmlChar> value(xmlTextReaderGetAttribute(reader, BAD_CAST(name)), xmlFree);
+  return value ? librevenge::RVNGString((const char *)value.get()) : librevenge::RVNGString();
+}
+
+void hashString(const xmlChar *str, uint64_t &hash)
+{
+  // include the terminator, so adjacent strings cannot run into each other
+  if (str)
+    hash = hashBytes(str, (unsigned long)xmlStrlen(str) + 1, hash);
+  else
+    hash = hashBytes("", 1, hash);
+}
+
+void hashNode(xmlTextReaderPtr reader, uint64_t &hash)
+{
+  const int type = xmlTextReaderNodeType(reader);
+  if (type == XML_READER_TYPE_WHITESPACE || type == XML_READER_TYPE_SIGNIFICANT_WHITESPACE)
+    return;
+  const unsigned char typeByte = (unsigned char)type;
+  hash = hashBytes(&typeByte, 1, hash);
+  hashString(xmlTextReaderConstName(reader), hash);
+  if (type == XML_READER_TYPE_TEXT || type == XML_READER_TYPE_CDATA)
+    hashString(xmlTextReaderConstValue(reader), hash);
+  if (type == XML_READER_TYPE_ELEMENT && xmlTextReaderHasAttributes(reader) == 1)
+  {
+    while (xmlTextReaderMoveToNextAttribute(reader) == 1)
+    {
+      hashString(xmlTextReaderConstName(reader), hash);
+      hashString(xmlTextReaderConstValue(reader), hash);
+    }
+    xmlTextReaderMoveToElement(reader);
+  }
+}
+
+// hash the element under the reader with everything in it and move past it
+int hashSubtree(xmlTextReaderPtr reader, uint64_t &hash)
+{
+  const int depth = xmlTextReaderDepth(reader);
+  int ret = 1;
+  do
+  {
+    hashNode(reader, hash);
+    ret = xmlTextReaderRead(reader);
+  }
+  while (ret == 1 && xmlTextReaderDepth(reader) > depth);
+  if (ret == 1 && xmlTextReaderDepth(reader) == depth
+      && xmlTextReaderNodeType(reader) == XML_READER_TYPE_END_ELEMENT)
+    ret = xmlTextReaderRead(reader);
+  return ret;
+}
+
+}
+
 DRAWIOAPI DRAWIODocument::Confidence DRAWIODocument::isSupported(librevenge::RVNGInputStream *const input, Type *const type) try
 {
   input->seek(0, librevenge::RVNG_SEEK_SET);
@@ -68,6 +131,173 @@ catch (...)
   return CONFIDENCE_NONE;
 }
 
+DRAWIOAPI DRAWIODocument::Result DRAWIODocument::parseToSVG(librevenge::RVNGInputStream *const input, librevenge::RVNGStringVector &output)
+{
+  return parseToSVG(input, output, DRAWIOOptions());
+}
+
+DRAWIOAPI DRAWIODocument::Result DRAWIODocument::parseToSVG(librevenge::RVNGInputStream *const input, librevenge::RVNGStringVector &output, const DRAWIOOptions &options) try
+{
+  Type type;
+  Confidence confidence = isSupported(input, &type);
+  if (CONFIDENCE_NONE == confidence)
+    return RESULT_UNSUPPORTED_FORMAT;
+  else if (CONFIDENCE_SUPPORTED_PART == confidence)
+    return RESULT_UNSUPPORTED_FORMAT;
+  else if (CONFIDENCE_UNSUPPORTED_ENCRYPTION == confidence)
+    return RESULT_UNSUPPORTED_ENCRYPTION;
+
+  std::unique_ptr<DRAWIOCollector> collector;
+  if (options.statistics)
+    collector.reset(new DRAWIOCollector(*options.statistics));
+  const char *const traceFile = options.traceFile ? options.traceFile : getenv("DRAWIO_TRACE");
+  std::unique_ptr<DRAWIOTracer> tracer;
+  if (traceFile && *traceFile)
+    tracer.reset(new DRAWIOTracer(traceFile, options.traceThreshold));
+  const DRAWIOTracer::Span span("document");
+
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  libdrawio::DRAWIOParser parser(input, nullptr);
+  parser.setLimits(options.limits);
+  if (!parser.parseMain())
+    return RESULT_UNKNOWN_ERROR;
+
+  const DRAWIODisplayList &list = parser.getDisplayList();
+  {
+    const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_EMIT);
+    DRAWIOSVGWriter writer;
+    writer.write(list);
+    for (const auto &page : writer.getPages())
+      output.append(librevenge::RVNGString(page.c_str()));
+  }
+  if (collector)
+    collector->statistics().pathSteps = list.getPathStepCount();
+  return RESULT_OK;
+}
+catch (const FileAccessError &)
+{
+  return RESULT_FILE_ACCESS_ERROR;
+}
+catch (const PackageError &)
+{
+  return RESULT_PACKAGE_ERROR;
+}
+catch (const PasswordMismatch &)
+{
+  return RESULT_PASSWORD_MISMATCH;
+}
+catch (const UnsupportedEncryption &)
+{
+  return RESULT_UNSUPPORTED_ENCRYPTION;
+}
+catch (const UnsupportedFormat &)
+{
+  return RESULT_UNSUPPORTED_FORMAT;
+}
+catch (const LimitExceeded &limit)
+{
+  return getLimitResult(limit);
+}
+catch (...)
+{
+  return RESULT_UNKNOWN_ERROR;
+}
+
+DRAWIOAPI DRAWIODocument::Result DRAWIODocument::readHeader(librevenge::RVNGInputStream *const input, DRAWIOHeader &header, const bool diagrams) try
+{
+  header = DRAWIOHeader();
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  auto reader = libdrawio::xmlReaderForStream(input);
+  if (!reader)
+    return RESULT_UNSUPPORTED_FORMAT;
+  int ret = xmlTextReaderRead(reader.get());
+  while (ret == 1 && xmlTextReaderNodeType(reader.get()) != XML_READER_TYPE_ELEMENT)
+    ret = xmlTextReaderRead(reader.get());
+  if (ret != 1)
+    return RESULT_UNSUPPORTED_FORMAT;
+  const xmlChar *name = xmlTextReaderConstName(reader.get());
+  if (!name || !xmlStrEqual(name, BAD_CAST("mxfile")))
+    return RESULT_UNSUPPORTED_FORMAT;
+
+  header.etag = readAttribute(reader.get(), "etag");
+  header.modified = readAttribute(reader.get(), "modified");
+  header.version = readAttribute(reader.get(), "version");
+  if (!diagrams || xmlTextReaderIsEmptyElement(reader.get()))
+    return RESULT_OK;
+
+  const int fileDepth = xmlTextReaderDepth(reader.get());
+  ret = xmlTextReaderRead(reader.get());
+  while (ret == 1 && xmlTextReaderDepth(reader.get()) > fileDepth)
+  {
+    if (xmlTextReaderNodeType(reader.get()) == XML_READER_TYPE_ELEMENT
+        && xmlTextReaderDepth(reader.get()) == fileDepth + 1
+        && xmlStrEqual(xmlTextReaderConstName(reader.get()), BAD_CAST("diagram")))
+    {
+      DRAWIODiagramInfo info;
+      info.id = readAttribute(reader.get(), "id");
+      info.name = readAttribute(reader.get(), "name");
+      uint64_t hash = HASH_SEED;
+      ret = hashSubtree(reader.get(), hash);
+      // 0 is reserved for "not computed"
+      info.hash = hash ? hash : 1;
+      header.diagrams.push_back(info);
+    }
+    else
+      ret = xmlTextReaderRead(reader.get());
+  }
+  if (ret < 0)
+    return RESULT_PARSE_ERROR;
+  return RESULT_OK;
+}
+catch (...)
+{
+  return RESULT_UNKNOWN_ERROR;
+}
+
+DRAWIOAPI bool DRAWIODocument::isUnchanged(const DRAWIOHeader &header, const DRAWIOHeader &previous)
+{
+  if (!header.etag.empty() && !previous.etag.empty())
+    return header.etag == previous.etag;
+  if (header.diagrams.empty() || header.diagrams.size() != previous.diagrams.size())
+    return false;
+  for (unsigned i = 0; i < header.diagrams.size(); i++)
+  {
+    if (!isDiagramUnchanged(header, i, previous)
+        || header.diagrams[i].id != previous.diagrams[i].id)
+      return false;
+  }
+  return true;
+}
+
+DRAWIOAPI bool DRAWIODocument::isDiagramUnchanged(const DRAWIOHeader &header, const unsigned index, const DRAWIOHeader &previous)
+{
+  if (index >= header.diagrams.size() || !header.diagrams[index].hash)
+    return false;
+  const DRAWIODiagramInfo &diagram = header.diagrams[index];
+  for (const auto &prior : previous.diagrams)
+  {
+    if (prior.id == diagram.id)
+      return prior.hash == diagram.hash;
+  }
+  return false;
+}
+
+DRAWIOAPI librevenge::RVNGString DRAWIODocument::getDigest(librevenge::RVNGInputStream *const input)
+{
+  SHA256 hash;
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  while (!input->isEnd())
+  {
+    unsigned long numBytesRead = 0;
+    const unsigned char *const data = input->read(65536, numBytesRead);
+    if (!data || !numBytesRead)
+      break;
+    hash.update(data, numBytesRead);
+  }
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  return librevenge::RVNGString(hash.hexDigest().c_str());
+}
+
 DRAWIOAPI DRAWIODocument::Result DRAWIODocument::parse(librevenge::RVNGInputStream *const input, librevenge::RVNGDrawingInterface *const document, const char *const)
 {
   Type type;
@@ -122,6 +352,92 @@ catch (...)
   return RESULT_UNKNOWN_ERROR;
 }
 
+DRAWIOAPI DRAWIODocument::Result DRAWIODocument::parse(librevenge::RVNGInputStream *const input, librevenge::RVNGDrawingInterface *const *const documents, const unsigned count, const char *const)
+{
+  return parse(input, documents, count, DRAWIOOptions());
+}
+
+DRAWIOAPI DRAWIODocument::Result DRAWIODocument::parse(librevenge::RVNGInputStream *const input, librevenge::RVNGDrawingInterface *const document, const DRAWIOOptions &options)
+{
+  return parse(input, &document, 1, options);
+}
+
+DRAWIOAPI DRAWIODocument::Result DRAWIODocument::parse(librevenge::RVNGInputStream *const input, librevenge::RVNGDrawingInterface *const *const documents, const unsigned count, const DRAWIOOptions &options) try
+{
+  Type type;
+  Confidence confidence = isSupported(input, &type);
+  if (CONFIDENCE_NONE == confidence)
+    return RESULT_UNSUPPORTED_FORMAT;
+  else if (CONFIDENCE_SUPPORTED_PART == confidence)
+    return RESULT_UNSUPPORTED_FORMAT;
+  else if (CONFIDENCE_UNSUPPORTED_ENCRYPTION == confidence)
+    return RESULT_UNSUPPORTED_ENCRYPTION;
+
+  std::unique_ptr<DRAWIOCollector> collector;
+  if (options.statistics)
+    collector.reset(new DRAWIOCollector(*options.statistics));
+  const char *const traceFile = options.traceFile ? options.traceFile : getenv("DRAWIO_TRACE");
+  std::unique_ptr<DRAWIOTracer> tracer;
+  if (traceFile && *traceFile)
+    tracer.reset(new DRAWIOTracer(traceFile, options.traceThreshold));
+  const DRAWIOTracer::Span span("document");
+
+  std::unique_ptr<DRAWIOCache> cache;
+  if (options.cacheDirectory) {
+    cache.reset(new DRAWIOCache(options.cacheDirectory, input, options.limits.maxInputBytes));
+    const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_EMIT);
+    if (cache->replay(documents, count))
+      return RESULT_OK;
+  }
+
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  libdrawio::DRAWIOParser parser(input, nullptr);
+  parser.setLimits(options.limits);
+  if (!parser.parseMain())
+    return RESULT_UNKNOWN_ERROR;
+  if (cache)
+    cache->store(parser.getDisplayList());
+
+  // the layout is computed once; each painter only replays it
+  const DRAWIODisplayList &list = parser.getDisplayList();
+  {
+    const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_EMIT);
+    for (unsigned i = 0; i < count; i++)
+      list.replay(documents[i]);
+  }
+  if (collector)
+    collector->statistics().pathSteps = list.getPathStepCount();
+  return RESULT_OK;
+}
+catch (const FileAccessError &)
+{
+  return RESULT_FILE_ACCESS_ERROR;
+}
+catch (const PackageError &)
+{
+  return RESULT_PACKAGE_ERROR;
+}
+catch (const PasswordMismatch &)
+{
+  return RESULT_PASSWORD_MISMATCH;
+}
+catch (const UnsupportedEncryption &)
+{
+  return RESULT_UNSUPPORTED_ENCRYPTION;
+}
+catch (const UnsupportedFormat &)
+{
+  return RESULT_UNSUPPORTED_FORMAT;
+}
+catch (const LimitExceeded &limit)
+{
+  return getLimitResult(limit);
+}
+catch (...)
+{
+  return RESULT_UNKNOWN_ERROR;
+}
+
 } // namespace libdrawio
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
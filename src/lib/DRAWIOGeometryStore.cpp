@@ -0,0 +1,56 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOGeometryStore.h"
+#include "DRAWIOTypes.h"
+#include "MXCell.h"
+
+namespace libdrawio {
+  void DRAWIOGeometryStore::append(const MXCell &cell,
+                                   const std::map<librevenge::RVNGString, MXCell> &id_map) {
+    const size_t index = m_x.size();
+    double dx = 0, dy = 0;
+    // edges are routed on the page already
+    if (cell.vertex && !cell.parent_id.empty()) {
+      auto parent = id_map.find(cell.parent_id);
+      if (parent != id_map.end()) {
+        dx = parent->second.geometry.x;
+        dy = parent->second.geometry.y;
+      }
+      else
+        m_orphans.emplace(cell.parent_id, index);
+    }
+    m_x.push_back((cell.geometry.x + dx) / 100);
+    m_y.push_back((cell.geometry.y + dy) / 100);
+    m_width.push_back(cell.geometry.width / 100);
+    m_height.push_back(cell.geometry.height / 100);
+    // clockwise degrees to counterclockwise radians
+    m_angle.push_back(cell.style.rotation * -pi / 180);
+
+    if (m_orphans.empty())
+      return;
+    const auto children = m_orphans.equal_range(cell.id);
+    for (auto it = children.first; it != children.second; ++it) {
+      m_x[it->second] += cell.geometry.x / 100;
+      m_y[it->second] += cell.geometry.y / 100;
+    }
+    m_orphans.erase(children.first, children.second);
+  }
+
+  size_t DRAWIOGeometryStore::size() const {
+    return m_x.size();
+  }
+
+  ShapeFrame DRAWIOGeometryStore::getFrame(size_t index) const {
+    ShapeFrame frame = {m_x[index], m_y[index], m_width[index], m_height[index], m_angle[index]};
+    return frame;
+  }
+
+  long long DRAWIOGeometryStore::getMemoryUsage() const {
+    return (long long)((m_x.capacity() + m_y.capacity() + m_width.capacity()
+                        + m_height.capacity() + m_angle.capacity()) * sizeof(double)
+                       // a tree node holds three pointers and a color
+                       + m_orphans.size() * (4 * sizeof(void *) + sizeof(std::pair<librevenge::RVNGString, size_t>)));
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOGEOMETRYSTORE_H
+#define DRAWIOGEOMETRYSTORE_H
+
+#include "librevenge/RVNGString.h"
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace libdrawio {
+  struct MXCell;
+
+  // where a cell is drawn: its box on the page in inches and its rotation
+  struct ShapeFrame {
+    double x, y, width, height;
+    double angle; // in radians, counterclockwise
+  };
+
+  /* The frames of the cells of one page, kept as one array per field and
+   * filled as the cells are read, so that drawing a vertex reads its frame
+   * rather than its parent: vertices are moved by the offset of their
+   * parent, boxes are in inches and rotations in radians.
+   */
+  class DRAWIOGeometryStore {
+  public:
+    DRAWIOGeometryStore() : m_x(), m_y(), m_width(), m_height(), m_angle(), m_orphans() {}
+    // id_map holds the cells read so far; a vertex read before its parent
+    // is moved when the parent is appended
+    void append(const MXCell &cell, const std::map<librevenge::RVNGString, MXCell> &id_map);
+    size_t size() const;
+    ShapeFrame getFrame(size_t index) const;
+    // the estimated heap bytes of the arrays
+    long long getMemoryUsage() const;
+  private:
+    std::vector<double> m_x, m_y, m_width, m_height, m_angle;
+    // vertices waiting for their parent, by parent id
+    std::multimap<librevenge::RVNGString, size_t> m_orphans;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,279 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOImage.h"
+#include "DRAWIOBase64.h"
+#include "libdrawio_utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace libdrawio {
+  namespace {
+    // how much of a URI is decoded at once
+    const unsigned long CHUNK_SIZE = 65536;
+    // how far into an SVG image its root element is looked for
+    const unsigned long SVG_HEADER_SIZE = 65536;
+
+    unsigned readBE16(const unsigned char *p) {
+      return (unsigned)p[0] << 8 | p[1];
+    }
+
+    unsigned long readBE32(const unsigned char *p) {
+      return (unsigned long)p[0] << 24 | (unsigned long)p[1] << 16
+        | (unsigned long)p[2] << 8 | p[3];
+    }
+
+    bool readPNGSize(const unsigned char *data, unsigned long size,
+                     double &width, double &height) {
+      if (size < 24 || memcmp(data, "\x89PNG\r\n\x1a\n", 8) || memcmp(data + 12, "IHDR", 4))
+        return false;
+      width = (double)readBE32(data + 16);
+      height = (double)readBE32(data + 20);
+      return true;
+    }
+
+    bool readGIFSize(const unsigned char *data, unsigned long size,
+                     double &width, double &height) {
+      if (size < 10 || (memcmp(data, "GIF87a", 6) && memcmp(data, "GIF89a", 6)))
+        return false;
+      width = (double)(data[6] | data[7] << 8);
+      height = (double)(data[8] | data[9] << 8);
+      return true;
+    }
+
+    // the size is in the first start of frame segment
+    bool readJPEGSize(const unsigned char *data, unsigned long size,
+                      double &width, double &height) {
+      if (size < 4 || data[0] != 0xff || data[1] != 0xd8)
+        return false;
+      unsigned long i = 2;
+      while (i + 4 <= size) {
+        if (data[i] != 0xff)
+          return false;
+        const unsigned char marker = data[i + 1];
+        if (marker == 0xff) {
+          // fill byte
+          i++;
+          continue;
+        }
+        if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd7)) {
+          i += 2;
+          continue;
+        }
+        if (marker == 0xd9 || marker == 0xda)
+          return false;
+        const unsigned length = readBE16(data + i + 2);
+        if (marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8
+            && marker != 0xcc) {
+          if (length < 7 || i + 9 > size)
+            return false;
+          height = (double)readBE16(data + i + 5);
+          width = (double)readBE16(data + i + 7);
+          return true;
+        }
+        i += 2 + length;
+      }
+      return false;
+    }
+
+    // an SVG length in px; percentages are not a size
+    bool parseSVGLength(const std::string &value, double &length) {
+      const char *const str = value.c_str();
+      char *end = nullptr;
+      const double number = strtod(str, &end);
+      if (end == str || number <= 0)
+        return false;
+      while (*end == ' ')
+        end++;
+      if (!*end || !strcmp(end, "px"))
+        length = number;
+      else if (!strcmp(end, "pt"))
+        length = number * 4 / 3;
+      else if (!strcmp(end, "pc"))
+        length = number * 16;
+      else if (!strcmp(end, "in"))
+        length = number * 96;
+      else if (!strcmp(end, "cm"))
+        length = number * 96 / 2.54;
+      else if (!strcmp(end, "mm"))
+        length = number * 96 / 25.4;
+      else if (!strcmp(end, "em"))
+        length = number * 16;
+      else
+        return false;
+      return true;
+    }
+
+    bool findAttribute(const std::string &tag, const char *name, std::string &value) {
+      const std::string::size_type length = strlen(name);
+      std::string::size_type pos = 0;
+      while ((pos = tag.find(name, pos)) != std::string::npos) {
+        std::string::size_type p = pos + length;
+        const bool start = pos > 0 && (tag[pos - 1] == ' ' || tag[pos - 1] == '\t'
+                                       || tag[pos - 1] == '\n' || tag[pos - 1] == '\r');
+        pos = p;
+        while (p < tag.size() && tag[p] == ' ')
+          p++;
+        if (!start || p >= tag.size() || tag[p] != '=')
+          continue;
+        p++;
+        while (p < tag.size() && tag[p] == ' ')
+          p++;
+        if (p >= tag.size() || (tag[p] != '"' && tag[p] != '\''))
+          return false;
+        const std::string::size_type end = tag.find(tag[p], p + 1);
+        if (end == std::string::npos)
+          return false;
+        value = tag.substr(p + 1, end - p - 1);
+        return true;
+      }
+      return false;
+    }
+
+    // from the width and height, or else the view box, of the root element
+    bool readSVGSize(const unsigned char *data, unsigned long size,
+                     double &width, double &height) {
+      const std::string header(reinterpret_cast<const char *>(data),
+                               size < SVG_HEADER_SIZE ? size : SVG_HEADER_SIZE);
+      const std::string::size_type start = header.find("<svg");
+      if (start == std::string::npos)
+        return false;
+      const std::string::size_type end = header.find('>', start);
+      if (end == std::string::npos)
+        return false;
+      const std::string tag = header.substr(start, end - start);
+      std::string value;
+      double w = 0, h = 0;
+      if (findAttribute(tag, "width", value))
+        parseSVGLength(value, w);
+      if (findAttribute(tag, "height", value))
+        parseSVGLength(value, h);
+      if ((!w || !h) && findAttribute(tag, "viewBox", value)) {
+        double box[4] = {0, 0, 0, 0};
+        const char *p = value.c_str();
+        for (double &number : box) {
+          while (*p == ' ' || *p == ',')
+            p++;
+          number = strtod(p, const_cast<char **>(&p));
+        }
+        if (box[2] > 0 && box[3] > 0) {
+          // a missing side keeps the aspect ratio of the view box
+          if (!w && !h) {
+            w = box[2];
+            h = box[3];
+          } else if (!w) {
+            w = h * box[2] / box[3];
+          } else {
+            h = w * box[3] / box[2];
+          }
+        }
+      }
+      if (!w || !h)
+        return false;
+      width = w;
+      height = h;
+      return true;
+    }
+
+    // finds the end of the MIME type and the comma before the data of a
+    // base64 data URI; draw.io leaves out ";base64" because ';' separates
+    // the entries of a style
+    bool splitDataURI(const std::string &uri, std::string::size_type &mimeEnd,
+                      std::string::size_type &comma) {
+      if (uri.compare(0, 11, "data:image/"))
+        return false;
+      comma = uri.find(',');
+      if (comma == std::string::npos)
+        return false;
+      mimeEnd = uri.find(';', 5);
+      if (mimeEnd == std::string::npos || mimeEnd > comma)
+        mimeEnd = comma;
+      return true;
+    }
+
+    std::shared_ptr<const DRAWIOImage> decodeDataURI(const std::string &uri) {
+      std::string::size_type mimeEnd, comma;
+      if (!splitDataURI(uri, mimeEnd, comma))
+        return std::shared_ptr<const DRAWIOImage>();
+
+      std::shared_ptr<DRAWIOImage> image = std::make_shared<DRAWIOImage>();
+      image->mimeType = uri.substr(5, mimeEnd - 5).c_str();
+      image->hash = HASH_SEED;
+      Base64Decoder decoder;
+      std::vector<unsigned char> buffer(Base64Decoder::getMaxDecodedSize(CHUNK_SIZE));
+      for (std::string::size_type pos = comma + 1; pos < uri.size(); pos += CHUNK_SIZE) {
+        const unsigned long length = (unsigned long)std::min<std::string::size_type>(CHUNK_SIZE, uri.size() - pos);
+        const unsigned long decoded = decoder.decode(uri.data() + pos, length, buffer.data());
+        if (decoder.failed())
+          return std::shared_ptr<const DRAWIOImage>();
+        image->data.append(buffer.data(), decoded);
+        image->hash = hashBytes(buffer.data(), decoded, image->hash);
+      }
+      if (!decoder.finish() || image->data.empty())
+        return std::shared_ptr<const DRAWIOImage>();
+      readImageSize(image->mimeType.cstr(), image->data.getDataBuffer(), image->data.size(),
+                    image->width, image->height);
+      return image;
+    }
+
+    // whether uri decodes to image, checked a chunk at a time so that the
+    // cache need not keep the URI it was decoded from
+    bool isDataURIOf(const std::string &uri, const DRAWIOImage &image) {
+      std::string::size_type mimeEnd, comma;
+      if (!splitDataURI(uri, mimeEnd, comma) || uri.compare(5, mimeEnd - 5, image.mimeType.cstr()))
+        return false;
+      const unsigned char *data = image.data.getDataBuffer();
+      const unsigned long size = image.data.size();
+      unsigned long offset = 0;
+      Base64Decoder decoder;
+      std::vector<unsigned char> buffer(Base64Decoder::getMaxDecodedSize(CHUNK_SIZE));
+      for (std::string::size_type pos = comma + 1; pos < uri.size(); pos += CHUNK_SIZE) {
+        const unsigned long length = (unsigned long)std::min<std::string::size_type>(CHUNK_SIZE, uri.size() - pos);
+        const unsigned long decoded = decoder.decode(uri.data() + pos, length, buffer.data());
+        if (decoder.failed() || decoded > size - offset || memcmp(buffer.data(), data + offset, decoded))
+          return false;
+        offset += decoded;
+      }
+      return decoder.finish() && offset == size;
+    }
+  }
+
+  bool readImageSize(const char *mimeType, const unsigned char *data,
+                     unsigned long size, double &width, double &height) {
+    if (!data)
+      return false;
+    if (readPNGSize(data, size, width, height) || readJPEGSize(data, size, width, height)
+        || readGIFSize(data, size, width, height))
+      return true;
+    return !strcmp(mimeType, "image/svg+xml") && readSVGSize(data, size, width, height);
+  }
+
+  DRAWIOImageCache::DRAWIOImageCache()
+    : m_images(), m_memory(0) {}
+
+  std::shared_ptr<const DRAWIOImage> DRAWIOImageCache::get(const std::string &uri) {
+    const uint64_t hash = hashBytes(uri.data(), uri.size());
+    const auto it = m_images.find(hash);
+    if (it != m_images.end()) {
+      if (isDataURIOf(uri, *it->second))
+        return it->second;
+      return decodeDataURI(uri); // a colliding entry stays
+    }
+    std::shared_ptr<const DRAWIOImage> image = decodeDataURI(uri);
+    // URIs that are not images fail early and are not kept
+    if (!image)
+      return image;
+    m_images.emplace(hash, image);
+    // a hash node holds the next pointer and the cached hash besides the entry
+    m_memory += 2 * sizeof(void *) + sizeof(hash) + sizeof(image)
+      + sizeof(DRAWIOImage) + image->data.size();
+    return image;
+  }
+
+  unsigned long long DRAWIOImageCache::getMemoryUsage() const {
+    return m_memory + m_images.bucket_count() * sizeof(void *);
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOIMAGE_H
+#define DRAWIOIMAGE_H
+
+#include "librevenge/librevenge.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace libdrawio {
+  // an image embedded in a style, e.g. image=data:image/png,iVBOR...
+  struct DRAWIOImage {
+    librevenge::RVNGString mimeType;
+    // copies share the buffer, so every painter call gets the same one
+    librevenge::RVNGBinaryData data;
+    uint64_t hash; // hashBytes of data
+    double width, height; // natural size in px, 0 if unknown
+    DRAWIOImage() : mimeType(), data(), hash(0), width(0), height(0) {}
+  };
+
+  /* Reads the natural size of a PNG, JPEG, GIF or SVG image from its
+   * header, without decoding any pixels.
+   */
+  bool readImageSize(const char *mimeType, const unsigned char *data,
+                     unsigned long size, double &width, double &height);
+
+  /* The images of the styles of one document. Each distinct data URI is
+   * decoded once, however many cells use it. Images are found by the hash
+   * of their URI, which is checked against the image on a hit, so the
+   * URIs themselves are not kept.
+   */
+  class DRAWIOImageCache {
+  public:
+    DRAWIOImageCache();
+    // null if uri is not a base64 data URI of an image
+    std::shared_ptr<const DRAWIOImage> get(const std::string &uri);
+    // estimated heap bytes of the cache and its images
+    unsigned long long getMemoryUsage() const;
+  private:
+    std::unordered_map<uint64_t, std::shared_ptr<const DRAWIOImage> > m_images;
+    unsigned long long m_memory;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
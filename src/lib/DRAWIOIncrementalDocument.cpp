@@ -0,0 +1,284 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libdrawio/libdrawio.h>
+
+#include "DRAWIOConnections.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOGeometryStore.h"
+#include "DRAWIOParser.h"
+#include "MXCell.h"
+#include "libdrawio_utils.h"
+
+namespace libdrawio
+{
+
+namespace
+{
+
+typedef std::map<librevenge::RVNGString, MXCell> CellMap;
+typedef std::map<librevenge::RVNGString, std::string> HashMap;
+
+struct CellRecord
+{
+  CellRecord()
+    : hash()
+    , number(0)
+    , list()
+  {
+  }
+
+  std::string hash; //< MXCell::contentDigest
+  int number; //< the position in the document, which the styles of list are named after
+  DRAWIODisplayList list;
+};
+
+typedef std::map<librevenge::RVNGString, CellRecord> PageRecord;
+
+bool isChanged(const HashMap &hashes, const HashMap &previous, const librevenge::RVNGString &id)
+{
+  const auto now = hashes.find(id);
+  const auto before = previous.find(id);
+  if (now == hashes.end())
+    return before != previous.end();
+  return before == previous.end() || before->second != now->second;
+}
+
+// whether any ancestor of the cell with the given parent changed
+bool isAncestryChanged(librevenge::RVNGString parent, const CellMap &cells, const HashMap &hashes, const HashMap &previous)
+{
+  // a document may have parent cycles, but no chain longer than its cells
+  for (size_t depth = 0; !parent.empty() && depth <= cells.size(); ++depth)
+  {
+    if (isChanged(hashes, previous, parent))
+      return true;
+    const auto it = cells.find(parent);
+    if (it == cells.end())
+      break;
+    parent = it->second.parent_id;
+  }
+  return false;
+}
+
+// whether any cell that the layout of cell reads from the id map changed
+bool isDependencyChanged(const MXCell &cell, const CellMap &cells, const HashMap &hashes, const HashMap &previous)
+{
+  if (isAncestryChanged(cell.parent_id, cells, hashes, previous))
+    return true;
+  if (cell.edge)
+  {
+    for (const librevenge::RVNGString *end : { &cell.source_id, &cell.target_id })
+    {
+      if (isChanged(hashes, previous, *end))
+        return true;
+      const auto it = cells.find(*end);
+      if (it != cells.end() && isAncestryChanged(it->second.parent_id, cells, hashes, previous))
+        return true;
+    }
+  }
+  return false;
+}
+
+}
+
+struct DRAWIOIncrementalState
+{
+  DRAWIOIncrementalState()
+    : pages()
+    , hashes()
+    , styles()
+    , layoutCount(0)
+  {
+  }
+
+  std::map<librevenge::RVNGString, PageRecord> pages; //< by page id
+  HashMap hashes; //< cell hashes, keyed like the parser's id map
+  ParsedStyleMap styles; //< by cell id
+  unsigned layoutCount;
+};
+
+DRAWIOIncrementalDocument::DRAWIOIncrementalDocument()
+  : m_state(new DRAWIOIncrementalState())
+{
+}
+
+DRAWIOIncrementalDocument::~DRAWIOIncrementalDocument()
+{
+}
+
+DRAWIODocument::Result DRAWIOIncrementalDocument::parse(librevenge::RVNGInputStream *const input, librevenge::RVNGDrawingInterface *const document)
+{
+  return parse(input, document, DRAWIOLimits());
+}
+
+DRAWIODocument::Result DRAWIOIncrementalDocument::parse(librevenge::RVNGInputStream *const input, librevenge::RVNGDrawingInterface *const document, const DRAWIOLimits &limits) try
+{
+  DRAWIODocument::Type type;
+  DRAWIODocument::Confidence confidence = DRAWIODocument::isSupported(input, &type);
+  if (DRAWIODocument::CONFIDENCE_NONE == confidence)
+    return DRAWIODocument::RESULT_UNSUPPORTED_FORMAT;
+  else if (DRAWIODocument::CONFIDENCE_SUPPORTED_PART == confidence)
+    return DRAWIODocument::RESULT_UNSUPPORTED_FORMAT;
+  else if (DRAWIODocument::CONFIDENCE_UNSUPPORTED_ENCRYPTION == confidence)
+    return DRAWIODocument::RESULT_UNSUPPORTED_ENCRYPTION;
+
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  ParsedStyleMap styles;
+  DRAWIOParser parser(input, nullptr);
+  parser.setLimits(limits);
+  parser.reuseStyles(m_state->styles, styles);
+  if (!parser.parseModel())
+    return DRAWIODocument::RESULT_UNKNOWN_ERROR;
+  const CellMap &cells = parser.getCells();
+  const std::vector<DRAWIOPage> &parsedPages = parser.getPages();
+
+  // each cell is hashed once; the last cell of an id is the one in the id
+  // map, and so the one its hash is kept for
+  std::vector<std::vector<std::string> > digests(parsedPages.size());
+  HashMap hashes;
+  for (size_t p = 0; p < parsedPages.size(); ++p)
+  {
+    const std::vector<MXCell> &pageCells = parsedPages[p].getCells();
+    digests[p].reserve(pageCells.size());
+    for (const auto &cell : pageCells)
+    {
+      digests[p].push_back(cell.contentDigest());
+      hashes[cell.id] = digests[p].back();
+    }
+  }
+
+  std::map<librevenge::RVNGString, PageRecord> pages;
+  unsigned layoutCount = 0;
+  DRAWIODisplayList frame;
+  int number = 0;
+  frame.append(DRAWIODisplayList::START_DOCUMENT);
+  frame.replay(document);
+  for (size_t p = 0; p < parsedPages.size(); ++p)
+  {
+    const DRAWIOPage &page = parsedPages[p];
+    frame.clear();
+    page.drawStart(frame);
+    frame.replay(document);
+    DRAWIOConnectionCache connections(cells);
+    const std::vector<MXCell> &pageCells = page.getCells();
+    const DRAWIOGeometryStore &frames = page.getFrames();
+
+    // only pages and cells with a unique id can be matched to the last revision
+    PageRecord scratch;
+    PageRecord *record = &scratch;
+    PageRecord *previous = nullptr;
+    if (!page.id.empty() && !pages.count(page.id))
+    {
+      record = &pages[page.id];
+      const auto it = m_state->pages.find(page.id);
+      if (it != m_state->pages.end())
+        previous = &it->second;
+    }
+
+    for (size_t i = 0; i < pageCells.size(); ++i, ++number)
+    {
+      parser.checkTime();
+      const MXCell &cell = pageCells[i];
+      const std::string &hash = digests[p][i];
+      CellRecord fresh;
+      CellRecord *current = &fresh;
+      bool reused = false;
+      if (!cell.id.empty() && !record->count(cell.id))
+      {
+        current = &(*record)[cell.id];
+        if (previous)
+        {
+          const auto it = previous->find(cell.id);
+          if (it != previous->end() && it->second.hash == hash
+              && !isDependencyChanged(cell, cells, hashes, m_state->hashes))
+          {
+            *current = std::move(it->second);
+            // cells inserted or deleted before this one move it
+            if (current->number != number)
+            {
+              MXCell::renumber(current->list, current->number, number);
+              current->number = number;
+            }
+            reused = true;
+          }
+        }
+      }
+      if (!reused)
+      {
+        MXCell shape(cell);
+        current->hash = hash;
+        current->number = number;
+        current->list.clear();
+        shape.draw(current->list, frames.getFrame(i), connections, number);
+        ++layoutCount;
+      }
+      current->list.replay(document);
+    }
+
+    frame.clear();
+    frame.append(DRAWIODisplayList::END_PAGE);
+    frame.replay(document);
+  }
+  frame.clear();
+  frame.append(DRAWIODisplayList::END_DOCUMENT);
+  frame.replay(document);
+
+  m_state->pages.swap(pages);
+  m_state->hashes.swap(hashes);
+  m_state->styles.swap(styles);
+  m_state->layoutCount = layoutCount;
+  return DRAWIODocument::RESULT_OK;
+}
+catch (const FileAccessError &)
+{
+  return DRAWIODocument::RESULT_FILE_ACCESS_ERROR;
+}
+catch (const PackageError &)
+{
+  return DRAWIODocument::RESULT_PACKAGE_ERROR;
+}
+catch (const PasswordMismatch &)
+{
+  return DRAWIODocument::RESULT_PASSWORD_MISMATCH;
+}
+catch (const UnsupportedEncryption &)
+{
+  return DRAWIODocument::RESULT_UNSUPPORTED_ENCRYPTION;
+}
+catch (const UnsupportedFormat &)
+{
+  return DRAWIODocument::RESULT_UNSUPPORTED_FORMAT;
+}
+catch (const LimitExceeded &limit)
+{
+  return getLimitResult(limit);
+}
+catch (...)
+{
+  return DRAWIODocument::RESULT_UNKNOWN_ERROR;
+}
+
+unsigned DRAWIOIncrementalDocument::getLayoutCount() const
+{
+  return m_state->layoutCount;
+}
+
+void DRAWIOIncrementalDocument::reset()
+{
+  m_state.reset(new DRAWIOIncrementalState());
+}
+
+} // namespace libdrawio
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
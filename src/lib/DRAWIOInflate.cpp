@@ -0,0 +1,35 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOInflate.h"
+#include <algorithm>
+#include <zlib.h>
+
+namespace libdrawio {
+  bool inflateRaw(const unsigned char *data, unsigned long size,
+                  unsigned long maxSize, std::vector<unsigned char> &out) {
+    out.clear();
+    z_stream stream = z_stream();
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+      return false;
+    stream.next_in = const_cast<unsigned char *>(data);
+    stream.avail_in = (uInt)size;
+    // deflate rarely does better than 1:4 on XML
+    out.resize(std::min<unsigned long>(maxSize, size * 4 + 64));
+    int result = Z_OK;
+    while (result == Z_OK) {
+      if (stream.total_out == out.size()) {
+        if (out.size() >= maxSize)
+          break;
+        out.resize(std::min<unsigned long>(maxSize, out.size() * 2));
+      }
+      stream.next_out = out.data() + stream.total_out;
+      stream.avail_out = (uInt)(out.size() - stream.total_out);
+      result = inflate(&stream, Z_NO_FLUSH);
+    }
+    out.resize(stream.total_out);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END;
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
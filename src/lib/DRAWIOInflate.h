@@ -0,0 +1,19 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOINFLATE_H
+#define DRAWIOINFLATE_H
+
+#include <vector>
+
+namespace libdrawio {
+  /* Inflates raw deflate data, without a zlib or gzip wrapper, as draw.io
+   * writes it. Fails if the data is broken or would inflate to more than
+   * maxSize bytes.
+   */
+  bool inflateRaw(const unsigned char *data, unsigned long size,
+                  unsigned long maxSize, std::vector<unsigned char> &out);
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
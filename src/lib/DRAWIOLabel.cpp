@@ -0,0 +1,561 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOLabel.h"
+#include "libdrawio_utils.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unicode/utf8.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace libdrawio {
+  namespace {
+    bool isSpecial(char c) {
+      return c == '<' || c == '&' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // the first byte from i on that is markup, an entity or a newline or
+    // tab, or size if there is none; text runs are skipped 16 bytes at a time
+    unsigned long findSpecial(const char *text, unsigned long i, unsigned long size) {
+#ifdef __SSE2__
+      const __m128i lt = _mm_set1_epi8('<');
+      const __m128i amp = _mm_set1_epi8('&');
+      const __m128i lf = _mm_set1_epi8('\n');
+      const __m128i cr = _mm_set1_epi8('\r');
+      const __m128i tab = _mm_set1_epi8('\t');
+      for (; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, lt), _mm_cmpeq_epi8(chunk, amp));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, lf));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, cr));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, tab));
+        const int mask = _mm_movemask_epi8(hits);
+        if (mask)
+          return i + (unsigned long)__builtin_ctz((unsigned)mask);
+      }
+#endif
+      for (; i < size; ++i) {
+        if (isSpecial(text[i]))
+          return i;
+      }
+      return size;
+    }
+
+    bool isSpace(char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool isNameChar(char c) {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+        || c == '-' || c == ':';
+    }
+
+    char toLower(char c) {
+      return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+    }
+
+    std::string trim(const std::string &str) {
+      std::string::size_type first = 0, last = str.size();
+      while (first < last && isSpace(str[first]))
+        ++first;
+      while (last > first && isSpace(str[last - 1]))
+        --last;
+      return str.substr(first, last - first);
+    }
+
+    std::string lower(std::string str) {
+      for (char &c : str)
+        c = toLower(c);
+      return str;
+    }
+
+    void appendCodePoint(std::string &out, UChar32 c) {
+      if (c <= 0 || c > 0x10ffff || U_IS_SURROGATE(c))
+        c = 0xfffd;
+      char buffer[U8_MAX_LENGTH];
+      int length = 0;
+      U8_APPEND_UNSAFE(buffer, length, c);
+      out.append(buffer, (size_t)length);
+    }
+
+    struct Entity {
+      const char *name;
+      UChar32 code;
+    };
+
+    const Entity ENTITIES[] = {
+      {"amp", '&'}, {"lt", '<'}, {"gt", '>'}, {"quot", '"'}, {"apos", '\''},
+      {"nbsp", 0xa0}, {"ndash", 0x2013}, {"mdash", 0x2014}, {"hellip", 0x2026},
+      {"lsquo", 0x2018}, {"rsquo", 0x2019}, {"ldquo", 0x201c}, {"rdquo", 0x201d},
+      {"laquo", 0xab}, {"raquo", 0xbb}, {"bull", 0x2022}, {"middot", 0xb7},
+      {"copy", 0xa9}, {"reg", 0xae}, {"trade", 0x2122}, {"euro", 0x20ac},
+      {"deg", 0xb0}, {"times", 0xd7}, {"divide", 0xf7}, {"plusmn", 0xb1},
+      {"larr", 0x2190}, {"rarr", 0x2192}, {"uarr", 0x2191}, {"darr", 0x2193}
+    };
+
+    // decodes the entity at text[i] == '&' into out and returns its length,
+    // or 0 if it is not one
+    unsigned long decodeEntity(const char *text, unsigned long i, unsigned long size,
+                               std::string &out) {
+      const unsigned long MAX_LENGTH = 12;
+      unsigned long end = i + 1;
+      while (end < size && end - i <= MAX_LENGTH && text[end] != ';' && text[end] != '&'
+             && !isSpace(text[end]))
+        ++end;
+      if (end >= size || text[end] != ';' || end == i + 1)
+        return 0;
+      const std::string name(text + i + 1, end - i - 1);
+      if (name[0] == '#') {
+        const bool hex = name.size() > 1 && (name[1] == 'x' || name[1] == 'X');
+        const char *const digits = name.c_str() + (hex ? 2 : 1);
+        char *digitsEnd = nullptr;
+        const unsigned long code = strtoul(digits, &digitsEnd, hex ? 16 : 10);
+        if (digitsEnd == digits || *digitsEnd)
+          return 0;
+        appendCodePoint(out, code > 0x10ffff ? 0xfffd : (UChar32)code);
+        return end - i + 1;
+      }
+      for (const Entity &entity : ENTITIES) {
+        if (name == entity.name) {
+          appendCodePoint(out, entity.code);
+          return end - i + 1;
+        }
+      }
+      return 0;
+    }
+
+    // #rgb, #rrggbb or rgb(r, g, b)
+    bool parseColor(const std::string &value, Color &color) {
+      const std::string str = lower(trim(value));
+      if (!str.empty() && str[0] == '#') {
+        char *end = nullptr;
+        const unsigned long rgb = strtoul(str.c_str() + 1, &end, 16);
+        if (*end)
+          return false;
+        if (str.size() == 7) {
+          color = Color((rgb >> 16) & 0xff, (rgb >> 8) & 0xff, rgb & 0xff, 0);
+          return true;
+        }
+        if (str.size() == 4) {
+          color = Color(((rgb >> 8) & 0xf) * 0x11, ((rgb >> 4) & 0xf) * 0x11, (rgb & 0xf) * 0x11, 0);
+          return true;
+        }
+        return false;
+      }
+      if (str.compare(0, 4, "rgb(") == 0) {
+        const char *p = str.c_str() + 4;
+        unsigned char channels[3];
+        for (unsigned char &channel : channels) {
+          char *end = nullptr;
+          const long level = strtol(p, &end, 10);
+          if (end == p)
+            return false;
+          channel = (unsigned char)(level < 0 ? 0 : level > 255 ? 255 : level);
+          p = end;
+          while (*p == ' ' || *p == ',')
+            ++p;
+        }
+        color = Color(channels[0], channels[1], channels[2], 0);
+        return true;
+      }
+      if (str == "black") {
+        color = Color(0, 0, 0, 0);
+        return true;
+      }
+      if (str == "white") {
+        color = Color(255, 255, 255, 0);
+        return true;
+      }
+      return false;
+    }
+
+    // a CSS font-size in pixels, as fontSize in a cell style
+    bool parseFontSize(const std::string &value, double &size) {
+      const std::string str = lower(trim(value));
+      char *end = nullptr;
+      const double number = strtod(str.c_str(), &end);
+      if (end == str.c_str() || number <= 0)
+        return false;
+      const std::string unit = trim(end);
+      if (unit.empty() || unit == "px")
+        size = number;
+      else if (unit == "pt")
+        size = number / 0.75;
+      else
+        return false;
+      return true;
+    }
+
+    bool isBlock(const std::string &name) {
+      static const char *const BLOCKS[] = {
+        "div", "p", "li", "ul", "ol", "h1", "h2", "h3", "h4", "h5", "h6",
+        "blockquote", "pre", "table", "tr", "hr"
+      };
+      for (const char *block : BLOCKS) {
+        if (name == block)
+          return true;
+      }
+      return false;
+    }
+
+    bool isVoid(const std::string &name) {
+      return name == "br" || name == "hr" || name == "img" || name == "wbr"
+        || name == "input" || name == "meta";
+    }
+
+    bool isSameStyle(const DRAWIOTextStyle &a, const DRAWIOTextStyle &b) {
+      const auto sameColor = [](const boost::optional<Color> &x, const boost::optional<Color> &y) {
+        return x.has_value() == y.has_value()
+          && (!x.has_value() || (x->r == y->r && x->g == y->g && x->b == y->b));
+      };
+      return a.bold == b.bold && a.italic == b.italic && a.underline == b.underline
+        && a.fontSize == b.fontSize && a.fontFamily == b.fontFamily.cstr()
+        && sameColor(a.fontColor, b.fontColor)
+        && sameColor(a.backgroundColor, b.backgroundColor);
+    }
+
+    class LabelWriter {
+    public:
+      LabelWriter(DRAWIODisplayList &list, const DRAWIOTextStyle &style,
+                  const DRAWIODisplayList::Props &textProps, bool html)
+        : m_list(list), m_base(style), m_textProps(textProps), m_html(html),
+          m_style(style), m_open(), m_text(), m_hasContent(false),
+          m_newParagraph(false), m_space(false), m_lineStart(true) {
+        m_list.append(DRAWIODisplayList::OPEN_PARAGRAPH, m_textProps);
+      }
+
+      void writePlain(const char *text, unsigned long size) {
+        unsigned long start = 0;
+        for (unsigned long i = 0; i <= size; ++i) {
+          if (i < size && text[i] != '\n' && text[i] != '\r')
+            continue;
+          addText(text + start, i - start);
+          if (i < size && text[i] == '\n')
+            lineBreak();
+          start = i + 1;
+        }
+      }
+
+      void writeHTML(const char *html, unsigned long size) {
+        unsigned long i = 0;
+        while (i < size) {
+          const unsigned long special = findSpecial(html, i, size);
+          addText(html + i, special - i);
+          i = special;
+          if (i == size)
+            break;
+          switch (html[i]) {
+          case '<':
+            i = readTag(html, i, size);
+            break;
+          case '&': {
+            std::string decoded;
+            const unsigned long length = decodeEntity(html, i, size, decoded);
+            if (length) {
+              addText(decoded.data(), decoded.size());
+              i += length;
+            } else {
+              addText(html + i, 1);
+              ++i;
+            }
+            break;
+          }
+          default:
+            m_space = true;
+            ++i;
+            break;
+          }
+        }
+      }
+
+      void finish() {
+        flush();
+        m_list.append(DRAWIODisplayList::CLOSE_PARAGRAPH);
+      }
+
+    private:
+      struct Element {
+        std::string name;
+        DRAWIOTextStyle style; // the style before the element
+      };
+
+      DRAWIODisplayList &m_list;
+      const DRAWIOTextStyle &m_base;
+      const DRAWIODisplayList::Props m_textProps;
+      const bool m_html;
+      DRAWIOTextStyle m_style; // of the run in m_text
+      std::vector<Element> m_open;
+      std::string m_text;
+      bool m_hasContent; // in the current paragraph
+      bool m_newParagraph; // a block boundary was passed
+      bool m_space; // collapsed white space is pending
+      bool m_lineStart; // nothing was written since the last line break
+
+      void startContent() {
+        if (m_newParagraph && m_hasContent) {
+          flush();
+          m_list.append(DRAWIODisplayList::CLOSE_PARAGRAPH);
+          m_list.append(DRAWIODisplayList::OPEN_PARAGRAPH, m_textProps);
+          m_hasContent = false;
+          m_space = false;
+          m_lineStart = true;
+        }
+        m_newParagraph = false;
+      }
+
+      void addText(const char *text, unsigned long size) {
+        if (!m_html) {
+          if (!size)
+            return;
+          startContent();
+          m_text.append(text, size);
+          m_hasContent = true;
+          return;
+        }
+        // runs of spaces collapse into one, written only before more text,
+        // so none starts or ends a line
+        const char *const end = text + size;
+        while (text < end) {
+          if (*text == ' ') {
+            m_space = true;
+            ++text;
+            continue;
+          }
+          const char *word = static_cast<const char *>(memchr(text, ' ', (size_t)(end - text)));
+          if (!word)
+            word = end;
+          startContent();
+          if (m_space && !m_lineStart)
+            m_text += ' ';
+          m_space = false;
+          m_lineStart = false;
+          m_text.append(text, (size_t)(word - text));
+          m_hasContent = true;
+          text = word;
+        }
+      }
+
+      void lineBreak() {
+        startContent();
+        flush();
+        m_list.append(DRAWIODisplayList::INSERT_LINE_BREAK);
+        m_hasContent = true;
+        m_space = false;
+        m_lineStart = true;
+      }
+
+      void flush() {
+        if (m_text.empty())
+          return;
+        if (isSameStyle(m_style, m_base)) {
+          m_list.append(DRAWIODisplayList::OPEN_SPAN, m_textProps);
+        } else {
+          insertTextStyle(m_list, m_style);
+          m_list.append(DRAWIODisplayList::OPEN_SPAN, m_list.closeProps());
+        }
+        m_list.appendText(m_text.c_str());
+        m_list.append(DRAWIODisplayList::CLOSE_SPAN);
+        m_text.clear();
+      }
+
+      void setStyle(const DRAWIOTextStyle &style) {
+        if (isSameStyle(style, m_style))
+          return;
+        flush();
+        m_style = style;
+      }
+
+      // returns the index after the tag that starts at html[i] == '<'
+      unsigned long readTag(const char *html, unsigned long i, unsigned long size) {
+        if (size - i >= 4 && !strncmp(html + i, "<!--", 4)) {
+          for (unsigned long j = i + 4; j + 3 <= size; ++j) {
+            if (!strncmp(html + j, "-->", 3))
+              return j + 3;
+          }
+          return size;
+        }
+        const char *const close = static_cast<const char *>(memchr(html + i, '>', size - i));
+        if (!close) {
+          // a lone '<' is text
+          addText(html + i, 1);
+          return i + 1;
+        }
+        const unsigned long end = (unsigned long)(close - html);
+        unsigned long p = i + 1;
+        const bool closing = p < end && html[p] == '/';
+        if (closing)
+          ++p;
+        std::string name;
+        for (; p < end && isNameChar(html[p]); ++p)
+          name += toLower(html[p]);
+        if (name.empty())
+          return end + 1;
+        if (closing)
+          closeElement(name);
+        else
+          openElement(name, std::string(html + p, end - p));
+        return end + 1;
+      }
+
+      void openElement(const std::string &name, const std::string &attributes) {
+        if (name == "br") {
+          lineBreak();
+          return;
+        }
+        if (isBlock(name))
+          m_newParagraph = true;
+        if (isVoid(name) || (!attributes.empty() && attributes[attributes.size() - 1] == '/'))
+          return;
+
+        m_open.push_back(Element{name, m_style});
+        DRAWIOTextStyle style = m_style;
+        if (name == "b" || name == "strong")
+          style.bold = true;
+        else if (name == "i" || name == "em")
+          style.italic = true;
+        else if (name == "u")
+          style.underline = true;
+        applyAttributes(name, attributes, style);
+        setStyle(style);
+      }
+
+      void closeElement(const std::string &name) {
+        if (isBlock(name))
+          m_newParagraph = true;
+        for (std::vector<Element>::size_type i = m_open.size(); i > 0; --i) {
+          if (m_open[i - 1].name == name) {
+            setStyle(m_open[i - 1].style);
+            m_open.resize(i - 1);
+            return;
+          }
+        }
+      }
+
+      void applyAttributes(const std::string &element, const std::string &attributes,
+                           DRAWIOTextStyle &style) const {
+        std::string::size_type p = 0;
+        while (p < attributes.size()) {
+          while (p < attributes.size() && (isSpace(attributes[p]) || attributes[p] == '/'))
+            ++p;
+          std::string name;
+          for (; p < attributes.size() && isNameChar(attributes[p]); ++p)
+            name += toLower(attributes[p]);
+          if (name.empty()) {
+            ++p;
+            continue;
+          }
+          while (p < attributes.size() && isSpace(attributes[p]))
+            ++p;
+          std::string value;
+          if (p < attributes.size() && attributes[p] == '=') {
+            ++p;
+            while (p < attributes.size() && isSpace(attributes[p]))
+              ++p;
+            if (p < attributes.size() && (attributes[p] == '"' || attributes[p] == '\'')) {
+              const char quote = attributes[p++];
+              const std::string::size_type end = attributes.find(quote, p);
+              value = attributes.substr(p, end == std::string::npos ? std::string::npos : end - p);
+              p = end == std::string::npos ? attributes.size() : end + 1;
+            } else {
+              const std::string::size_type start = p;
+              while (p < attributes.size() && !isSpace(attributes[p]))
+                ++p;
+              value = attributes.substr(start, p - start);
+            }
+          }
+          applyAttribute(element, name, value, style);
+        }
+      }
+
+      void applyAttribute(const std::string &element, const std::string &name,
+                          const std::string &value, DRAWIOTextStyle &style) const {
+        Color color;
+        if (name == "style") {
+          applyDeclarations(value, style);
+        } else if (element == "font") {
+          if (name == "color" && parseColor(value, color)) {
+            style.fontColor = color;
+          } else if (name == "face" && !trim(value).empty()) {
+            style.fontFamily = firstFamily(value).c_str();
+          } else if (name == "size") {
+            static const double SIZES[] = {10, 13, 16, 18, 24, 32, 48};
+            const long size = strtol(value.c_str(), nullptr, 10);
+            if (size >= 1 && size <= 7)
+              style.fontSize = SIZES[size - 1];
+          }
+        }
+      }
+
+      void applyDeclarations(const std::string &declarations, DRAWIOTextStyle &style) const {
+        std::string::size_type p = 0;
+        while (p < declarations.size()) {
+          std::string::size_type end = declarations.find(';', p);
+          if (end == std::string::npos)
+            end = declarations.size();
+          const std::string declaration = declarations.substr(p, end - p);
+          p = end + 1;
+          const std::string::size_type colon = declaration.find(':');
+          if (colon == std::string::npos)
+            continue;
+          const std::string property = lower(trim(declaration.substr(0, colon)));
+          const std::string value = trim(declaration.substr(colon + 1));
+          const std::string lowerValue = lower(value);
+          Color color;
+          double size = 0;
+          if (property == "font-weight")
+            style.bold = lowerValue == "bold" || lowerValue == "bolder" || atoi(lowerValue.c_str()) >= 600;
+          else if (property == "font-style")
+            style.italic = lowerValue == "italic" || lowerValue == "oblique";
+          else if (property == "text-decoration" || property == "text-decoration-line")
+            style.underline = lowerValue.find("underline") != std::string::npos;
+          else if (property == "color" && parseColor(value, color))
+            style.fontColor = color;
+          else if (property == "background-color" && parseColor(value, color))
+            style.backgroundColor = color;
+          else if (property == "font-size" && parseFontSize(value, size))
+            style.fontSize = size;
+          else if (property == "font-family" && !value.empty())
+            style.fontFamily = firstFamily(value).c_str();
+        }
+      }
+
+      static std::string firstFamily(const std::string &families) {
+        std::string family = trim(families.substr(0, families.find(',')));
+        if (family.size() >= 2 && (family[0] == '"' || family[0] == '\'')
+            && family[family.size() - 1] == family[0])
+          family = family.substr(1, family.size() - 2);
+        return family;
+      }
+    };
+  }
+
+  void appendLabel(DRAWIODisplayList &list, const char *label, unsigned long size,
+                   bool html, const DRAWIOTextStyle &style,
+                   const DRAWIODisplayList::Props &textProps) {
+    LabelWriter writer(list, style, textProps, html);
+    if (html)
+      writer.writeHTML(label, size);
+    else
+      writer.writePlain(label, size);
+    writer.finish();
+  }
+
+  void insertTextStyle(DRAWIODisplayList &list, const DRAWIOTextStyle &style) {
+    list.insert("style:font-name", style.fontFamily);
+    list.insert("fo:font-size", style.fontSize * 0.75, librevenge::RVNG_POINT);
+    if (style.fontColor.has_value()) {
+      list.insert("fo:color", style.fontColor->to_string().c_str());
+    }
+    if (style.backgroundColor.has_value()) {
+      list.insert("fo:background-color", style.backgroundColor->to_string().c_str());
+    }
+    list.insert("fo:font-weight", style.bold ? "bold" : "normal");
+    list.insert("fo:font-style", style.italic ? "italic" : "normal");
+    list.insert("style:text-underline-style", style.underline ? "solid" : "none");
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
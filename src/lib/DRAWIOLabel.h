@@ -0,0 +1,29 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOLABEL_H
+#define DRAWIOLABEL_H
+
+#include "DRAWIODisplayList.h"
+#include "DRAWIOStyle.h"
+
+namespace libdrawio {
+  /* Writes the label of a cell into a text object of the display list.
+   *
+   * A plain label is one paragraph, with a line break for every newline.
+   * An HTML label (html=1 in the style) is read in a single pass: entities
+   * are decoded, <br> becomes a line break, block elements start new
+   * paragraphs and <b>, <i>, <u>, <font> and inline styles start character
+   * spans. Unstyled runs use the span of the text object; styled ones carry
+   * their character properties inline. Other markup is dropped.
+   */
+  void appendLabel(DRAWIODisplayList &list, const char *label, unsigned long size,
+                   bool html, const DRAWIOTextStyle &style,
+                   const DRAWIODisplayList::Props &textProps);
+
+  // the character properties of a text style
+  void insertTextStyle(DRAWIODisplayList &list, const DRAWIOTextStyle &style);
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -1,24 +1,53 @@
 /* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
 
 #include "DRAWIOPage.h"
+#include "DRAWIOConnections.h"
+#include "DRAWIOTracer.h"
 #include "librevenge/librevenge.h"
 
 namespace libdrawio {
-  void DRAWIOPage::draw(librevenge::RVNGDrawingInterface *painter,
-                        std::map<librevenge::RVNGString, MXCell> id_map) {
-    librevenge::RVNGPropertyList propList;
-    propList.insert("svg:width", width / 100.);
-    propList.insert("svg:height", height / 100.);
-    propList.insert("draw:name", name);
-    propList.insert("draw:id", id);
-    propList.insert("xml:id", id);
-    painter->startPage(propList);
-    elements.draw(painter, id_map);
-    painter->endPage();
+  void DRAWIOPage::draw(DRAWIODisplayList &list,
+                        const std::map<librevenge::RVNGString, MXCell> &id_map,
+                        int firstNumber) {
+    const DRAWIOTracer::Span span("page", name.cstr(), id.cstr());
+    drawStart(list);
+    // edges of the page share what they need of the vertices they connect
+    DRAWIOConnectionCache connections(id_map);
+    elements.draw(list, frames, connections, firstNumber);
+    list.append(DRAWIODisplayList::END_PAGE);
   }
 
-  void DRAWIOPage::insert(MXCell cell) {
+  void DRAWIOPage::drawStart(DRAWIODisplayList &list) const {
+    list.insert("svg:width", width / 100.);
+    list.insert("svg:height", height / 100.);
+    list.insert("draw:name", name);
+    list.insert("draw:id", id);
+    list.insert("xml:id", id);
+    list.append(DRAWIODisplayList::START_PAGE, list.closeProps());
+  }
+
+  void DRAWIOPage::insert(const MXCell &cell,
+                          const std::map<librevenge::RVNGString, MXCell> &id_map) {
     elements.append(cell);
+    frames.append(cell, id_map);
+  }
+
+  const std::vector<MXCell> &DRAWIOPage::getCells() const {
+    return elements.getShapes();
+  }
+
+  const DRAWIOGeometryStore &DRAWIOPage::getFrames() const {
+    return frames;
+  }
+
+  void DRAWIOPage::getMemoryUsage(DRAWIOCollector::Memory &memory) const {
+    const std::vector<MXCell> &cells = getCells();
+    memory.bytes[DRAWIOStatistics::MEMORY_CELLS] +=
+      DRAWIOCollector::getStringSize(name) + DRAWIOCollector::getStringSize(id)
+      + (long long)((cells.capacity() - cells.size()) * sizeof(MXCell))
+      + frames.getMemoryUsage();
+    for (const auto &cell : cells)
+      cell.getMemoryUsage(memory);
   }
 }
 
@@ -3,26 +3,39 @@
 #ifndef DRAWIOPAGE_H
 #define DRAWIOPAGE_H
 
+#include "DRAWIOCollector.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOGeometryStore.h"
 #include "DRAWIOShapeList.h"
 #include "MXCell.h"
 #include "librevenge/RVNGString.h"
 #include "librevenge/librevenge.h"
 #include <string>
 #include <map>
+#include <vector>
 
 namespace libdrawio {
   class DRAWIOPage {
   public:
-    DRAWIOPage() : name(""), id(""), width(0), height(0), elements() {}
+    DRAWIOPage() : name(""), id(""), width(0), height(0), elements(), frames() {}
     DRAWIOPage(const DRAWIOPage & page) = default;
     DRAWIOPage &operator=(const DRAWIOPage &page) = default;
     librevenge::RVNGString name, id;
     int width, height;
-    void draw(librevenge::RVNGDrawingInterface *painter,
-              std::map<librevenge::RVNGString, MXCell> id_map);
-    void insert(MXCell cell);
+    // the cells are numbered from firstNumber, on from those of earlier pages
+    void draw(DRAWIODisplayList &list,
+              const std::map<librevenge::RVNGString, MXCell> &id_map, int firstNumber);
+    void drawStart(DRAWIODisplayList &list) const;
+    // id_map holds the cells read so far, to place the cell in its parent
+    void insert(const MXCell &cell, const std::map<librevenge::RVNGString, MXCell> &id_map);
+    const std::vector<MXCell> &getCells() const;
+    // the frames of the cells, in the same order
+    const DRAWIOGeometryStore &getFrames() const;
+    // adds the estimated memory held by the page and its cells
+    void getMemoryUsage(DRAWIOCollector::Memory &memory) const;
   private:
     DRAWIOShapeList elements;
+    DRAWIOGeometryStore frames;
   };
 }
 
@@ -1,7 +1,9 @@
 /* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
 
 #include "DRAWIOParser.h"
+#include "DRAWIOCollector.h"
 #include "DRAWIOPage.h"
+#include "DRAWIOTracer.h"
 #include "DRAWIOTypes.h"
 #include "DRAWIOUserObject.h"
 #include "MXCell.h"
@@ -24,10 +26,92 @@
 using std::shared_ptr;
 
 namespace libdrawio {
+  namespace {
+    const char *getConverterName(TextFormat format) {
+      switch (format) {
+      case DRAWIO_TEXT_JAPANESE:
+        return "windows-932";
+      case DRAWIO_TEXT_KOREAN:
+        return "windows-949";
+      case DRAWIO_TEXT_CHINESE_SIMPLIFIED:
+        return "windows-936";
+      case DRAWIO_TEXT_CHINESE_TRADITIONAL:
+        return "windows-950";
+      case DRAWIO_TEXT_GREEK:
+        return "windows-1253";
+      case DRAWIO_TEXT_TURKISH:
+        return "windows-1254";
+      case DRAWIO_TEXT_VIETNAMESE:
+        return "windows-1258";
+      case DRAWIO_TEXT_HEBREW:
+        return "windows-1255";
+      case DRAWIO_TEXT_ARABIC:
+        return "windows-1256";
+      case DRAWIO_TEXT_BALTIC:
+        return "windows-1257";
+      case DRAWIO_TEXT_RUSSIAN:
+        return "windows-1251";
+      case DRAWIO_TEXT_THAI:
+        return "windows-874";
+      case DRAWIO_TEXT_CENTRAL_EUROPE:
+        return "windows-1250";
+      case DRAWIO_TEXT_UTF16:
+        return "UTF-16LE";
+      default:
+        return "windows-1252";
+      }
+    }
+
+    /* ICU converters, opened on first use and kept for the thread.
+     *
+     * Opening one loads ICU's conversion data, so this is never done for
+     * UTF-8 documents, which is all that draw.io writes.
+     */
+    class ConverterCache {
+    public:
+      ConverterCache() : m_converters() {}
+      ~ConverterCache() {
+        for (UConverter *conv : m_converters) {
+          if (conv)
+            ucnv_close(conv);
+        }
+      }
+      UConverter *get(TextFormat format) {
+        UConverter *&conv = m_converters[format];
+        if (conv) {
+          // drop the state left by an interrupted multi-byte sequence
+          ucnv_reset(conv);
+        } else {
+          UErrorCode status = U_ZERO_ERROR;
+          conv = ucnv_open(getConverterName(format), &status);
+          if (U_FAILURE(status) && conv) {
+            ucnv_close(conv);
+            conv = nullptr;
+          }
+        }
+        return conv;
+      }
+    private:
+      UConverter *m_converters[DRAWIO_TEXT_UTF16 + 1];
+
+      ConverterCache(const ConverterCache &cache);
+      ConverterCache &operator=(const ConverterCache &cache);
+    };
+
+    UConverter *getConverter(TextFormat format) {
+      static thread_local ConverterCache cache;
+      return cache.get(format);
+    }
+  }
+
   DRAWIOParser::DRAWIOParser(librevenge::RVNGInputStream *input,
 			     librevenge::RVNGDrawingInterface *painter)
     : m_input(input), m_painter(painter), m_value(), m_cell(), m_geometry(),
-      m_point(), m_current_page() {}
+      m_point(), m_current_page(), m_pages(), m_objectStarted(false),
+      m_cellStarted(false), m_geometryStarted(false), m_in_points_list(false),
+      m_layout(true), m_current_level(0), m_watcher(nullptr), m_id_map(),
+      m_images(), m_previousStyles(nullptr), m_styles(nullptr), m_limits(),
+      m_deadline(), m_displayList() {}
 
   DRAWIOParser::~DRAWIOParser() {}
 
@@ -39,26 +123,86 @@ namespace libdrawio {
       if (!_processXmlDocument(m_input))
 	return false;
       return true;
+    } catch (const LimitExceeded &) {
+      throw;
     } catch (...) {
       return false;
     }
   }
 
+  bool DRAWIOParser::parseModel() {
+    m_layout = false;
+    return parseMain();
+  }
+
+  void DRAWIOParser::setLimits(const DRAWIOLimits &limits) {
+    m_limits = limits;
+    if (m_limits.maxTime > 0)
+      m_deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(m_limits.maxTime));
+  }
+
+  void DRAWIOParser::reuseStyles(const ParsedStyleMap &previous, ParsedStyleMap &current) {
+    m_previousStyles = &previous;
+    m_styles = &current;
+  }
+
+  const DRAWIODisplayList &DRAWIOParser::getDisplayList() const {
+    return m_displayList;
+  }
+
+  const std::vector<DRAWIOPage> &DRAWIOParser::getPages() const {
+    return m_pages;
+  }
+
+  const std::map<librevenge::RVNGString, MXCell> &DRAWIOParser::getCells() const {
+    return m_id_map;
+  }
+
   bool DRAWIOParser::_processXmlDocument(librevenge::RVNGInputStream *input) {
     if (!input)
       return false;
 
+    const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_READ);
+    const DRAWIOTracer::Span span("read");
     auto reader = xmlReaderForStream(input);
     if (!reader)
       return false;
+    DRAWIOCollector *const collector = DRAWIOCollector::get();
+    unsigned long long nodes = 0;
     int ret = xmlTextReaderRead(reader.get());
     while (ret == 1) {
+      ++nodes;
+      if (collector)
+        _accountReader(*collector, reader.get(), input);
+      if (m_limits.maxInputBytes && (unsigned long)input->tell() > m_limits.maxInputBytes)
+        throw LimitExceeded(LimitExceeded::INPUT_BYTES);
+      if (nodes % 256 == 0)
+        checkTime();
       _processXmlNode(reader.get());
       ret = xmlTextReaderRead(reader.get());
     }
+    if (collector) {
+      collector->statistics().xmlNodes += nodes;
+      collector->setMemory(DRAWIOStatistics::MEMORY_XML, 0);
+    }
     return true;
   }
 
+  void DRAWIOParser::_accountReader(DRAWIOCollector &collector, xmlTextReaderPtr reader,
+                                    librevenge::RVNGInputStream *input) const {
+    /* libxml2's allocator belongs to the host, so the reader is estimated:
+     * the input it read ahead of the parser, and the current node with its
+     * ancestors. Expanded subtrees and the name dictionary are left out.
+     */
+    const long consumed = xmlTextReaderByteConsumed(reader);
+    const long long buffered = consumed < 0 ? 0 : (long long)input->tell() - consumed;
+    const long long nodes = (long long)xmlTextReaderDepth(reader) + 1;
+    collector.setMemory(DRAWIOStatistics::MEMORY_XML,
+                        (buffered > 0 ? buffered : 0) + nodes * (long long)sizeof(xmlNode));
+  }
+
   void DRAWIOParser::_processXmlNode(xmlTextReaderPtr reader) {
     if (!reader)
       return;
@@ -126,8 +270,11 @@ namespace libdrawio {
       m_geometry.sourcePoint = m_point;
     else if (as && xmlStrEqual(as.get(), BAD_CAST("targetPoint")) && m_geometryStarted)
       m_geometry.targetPoint = m_point;
-    else if (m_in_points_list)
+    else if (m_in_points_list) {
+      if (m_limits.maxPointsPerArray && m_geometry.points.size() >= m_limits.maxPointsPerArray)
+        throw LimitExceeded(LimitExceeded::POINTS_PER_ARRAY);
       m_geometry.points.push_back(m_point);
+    }
   }
 
   void DRAWIOParser::_readGeometry(xmlTextReaderPtr reader) {
@@ -168,20 +315,16 @@ namespace libdrawio {
       label(xmlTextReaderGetAttribute(reader, BAD_CAST("label")), xmlFree);
 
     if (label) {
-      DRAWIOName labelName =
-        DRAWIOName(librevenge::RVNGBinaryData(label.get(), xmlStrlen(label.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_value.label, labelName.m_data, labelName.m_format);
+      if (m_limits.maxLabelBytes && (unsigned long)xmlStrlen(label.get()) > m_limits.maxLabelBytes)
+        throw LimitExceeded(LimitExceeded::LABEL_BYTES);
+      _convertDataToString(m_value.label, label.get());
     }
 
     const shared_ptr<xmlChar>
       id(xmlTextReaderGetAttribute(reader, BAD_CAST("id")), xmlFree);
 
     if (id) {
-      DRAWIOName idName =
-        DRAWIOName(librevenge::RVNGBinaryData(id.get(), xmlStrlen(id.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_value.id, idName.m_data, idName.m_format);
+      _convertDataToString(m_value.id, id.get());
     }
   }
 
@@ -213,44 +356,28 @@ namespace libdrawio {
       value(xmlTextReaderGetAttribute(reader, BAD_CAST("value")), xmlFree);
 
     if (id) {
-      DRAWIOName idName =
-        DRAWIOName(librevenge::RVNGBinaryData(id.get(), xmlStrlen(id.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_cell.id, idName.m_data, idName.m_format);
+      _convertDataToString(m_cell.id, id.get());
     }
     if (m_objectStarted) {
       m_cell.data = m_value;
       m_cell.id = m_value.id;
       m_objectStarted = false;
     } else if (value) {
-      DRAWIOName valueName =
-        DRAWIOName(librevenge::RVNGBinaryData(value.get(), xmlStrlen(value.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_cell.data.label, valueName.m_data, valueName.m_format);
+      if (m_limits.maxLabelBytes && (unsigned long)xmlStrlen(value.get()) > m_limits.maxLabelBytes)
+        throw LimitExceeded(LimitExceeded::LABEL_BYTES);
+      _convertDataToString(m_cell.data.label, value.get());
     }
     if (style) {
-      DRAWIOName styleName =
-        DRAWIOName(librevenge::RVNGBinaryData(style.get(), xmlStrlen(style.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_cell.style_str, styleName.m_data, styleName.m_format);
+      _convertDataToString(m_cell.style_str, style.get());
     }
     if (source) {
-      DRAWIOName sourceName =
-        DRAWIOName(librevenge::RVNGBinaryData(source.get(), xmlStrlen(source.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_cell.source_id, sourceName.m_data, sourceName.m_format);
+      _convertDataToString(m_cell.source_id, source.get());
     }
     if (target) {
-      DRAWIOName targetName =
-        DRAWIOName(librevenge::RVNGBinaryData(target.get(), xmlStrlen(target.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_cell.target_id, targetName.m_data, targetName.m_format);
+      _convertDataToString(m_cell.target_id, target.get());
     }
     if (parent) {
-      DRAWIOName parentName =
-        DRAWIOName(librevenge::RVNGBinaryData(parent.get(), xmlStrlen(parent.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_cell.parent_id, parentName.m_data, parentName.m_format);
+      _convertDataToString(m_cell.parent_id, parent.get());
     }
     if (edge)
       m_cell.edge = xmlStringToBool(edge.get());
@@ -265,12 +392,78 @@ namespace libdrawio {
   }
 
   void DRAWIOParser::_flushCell() {
-    m_cell.setStyle();
-    m_current_page.insert(m_cell);
+    if (m_limits.maxCellsPerPage && m_current_page.getCells().size() >= m_limits.maxCellsPerPage)
+      throw LimitExceeded(LimitExceeded::CELLS_PER_PAGE);
+    const unsigned long long images = m_images.getMemoryUsage();
+    {
+      const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_STYLE);
+      _setStyle();
+    }
+    if (DRAWIOCollector *collector = DRAWIOCollector::get()) {
+      // images are decoded the first time a style uses them
+      collector->allocate(DRAWIOStatistics::MEMORY_STYLES,
+                          (long long)(m_images.getMemoryUsage() - images));
+      ++collector->statistics().cells;
+      if (m_cell.edge)
+        ++collector->statistics().edges;
+      collector->addStyle(m_cell.style_str);
+      _accountCell(*collector);
+    }
+    m_current_page.insert(m_cell, m_id_map);
     m_id_map[m_cell.id] = m_cell;
     m_cellStarted = false;
   }
 
+  void DRAWIOParser::_setStyle() {
+    if (!m_styles) {
+      m_cell.setStyle(m_images);
+      return;
+    }
+    ParsedStyle parsed;
+    parsed.digest = m_cell.styleDigest();
+    const auto it = m_previousStyles->find(m_cell.id);
+    if (it != m_previousStyles->end() && it->second.digest == parsed.digest) {
+      m_cell.style = it->second.style;
+      m_cell.text_style = it->second.text_style;
+    }
+    else
+      m_cell.setStyle(m_images);
+    // only the first cell of an id can be matched
+    if (!m_cell.id.empty() && !m_styles->count(m_cell.id)) {
+      parsed.style = m_cell.style;
+      parsed.text_style = m_cell.text_style;
+      m_styles->emplace(m_cell.id, std::move(parsed));
+    }
+  }
+
+  // accounts for the copies of m_cell about to be made by _flushCell
+  void DRAWIOParser::_accountCell(DRAWIOCollector &collector) const {
+    DRAWIOCollector::Memory cell;
+    m_cell.getMemoryUsage(cell);
+    const std::vector<MXCell> &cells = m_current_page.getCells();
+    if (cells.size() == cells.capacity()) {
+      // the cells are copied when the page grows
+      DRAWIOCollector::Memory page;
+      m_current_page.getMemoryUsage(page);
+      collector.hold(page);
+    }
+    collector.allocate(cell);
+    // and its frame
+    collector.allocate(DRAWIOStatistics::MEMORY_CELLS, (long long)(5 * sizeof(double)));
+
+    const auto it = m_id_map.find(m_cell.id);
+    if (it == m_id_map.end()) {
+      collector.allocate(DRAWIOStatistics::MEMORY_CELLS,
+                         (long long)(4 * sizeof(void *) + sizeof(librevenge::RVNGString))
+                         + DRAWIOCollector::getStringSize(m_cell.id));
+    } else {
+      DRAWIOCollector::Memory replaced;
+      it->second.getMemoryUsage(replaced);
+      collector.release(replaced);
+    }
+    collector.allocate(cell);
+  }
+
   int DRAWIOParser::_getElementToken(xmlTextReaderPtr reader) {
     return DRAWIOTokenMap::getTokenId(xmlTextReaderConstName(reader));
   }
@@ -284,6 +477,11 @@ namespace libdrawio {
   }
 
   void DRAWIOParser::_startPage(xmlTextReaderPtr reader) {
+    if (DRAWIOCollector *collector = DRAWIOCollector::get()) {
+      DRAWIOCollector::Memory page;
+      m_current_page.getMemoryUsage(page);
+      collector->release(page);
+    }
     m_current_page = DRAWIOPage();
 
     const shared_ptr<xmlChar>
@@ -292,16 +490,10 @@ namespace libdrawio {
       name(xmlTextReaderGetAttribute(reader, BAD_CAST("name")), xmlFree);
 
     if (id) {
-      DRAWIOName idName =
-        DRAWIOName(librevenge::RVNGBinaryData(id.get(), xmlStrlen(id.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_current_page.id, idName.m_data, idName.m_format);
+      _convertDataToString(m_current_page.id, id.get());
     }
     if (name) {
-      DRAWIOName nameName =
-        DRAWIOName(librevenge::RVNGBinaryData(name.get(), xmlStrlen(name.get())),
-                   DRAWIO_TEXT_UTF8);
-      _convertDataToString(m_current_page.name, nameName.m_data, nameName.m_format);
+      _convertDataToString(m_current_page.name, name.get());
     }
   }
 
@@ -316,15 +508,67 @@ namespace libdrawio {
   }
 
   void DRAWIOParser::_endPage() {
+    if (DRAWIOCollector *collector = DRAWIOCollector::get()) {
+      DRAWIOCollector::Memory pages;
+      if (m_pages.size() == m_pages.capacity()) {
+        // the pages are copied when the vector grows
+        for (const auto &page : m_pages)
+          page.getMemoryUsage(pages);
+        collector->hold(pages);
+      }
+      DRAWIOCollector::Memory page;
+      m_current_page.getMemoryUsage(page);
+      collector->allocate(page);
+    }
     m_pages.push_back(m_current_page);
   }
 
   void DRAWIOParser::_endDocument() {
-    m_painter -> startDocument(librevenge::RVNGPropertyList());
-    for (auto page : m_pages) {
-      page.draw(m_painter, m_id_map);
+    if (!m_layout)
+      return;
+    {
+      const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_LAYOUT);
+      m_displayList.append(DRAWIODisplayList::START_DOCUMENT);
+      int number = 0;
+      for (auto &page : m_pages) {
+        checkTime();
+        page.draw(m_displayList, m_id_map, number);
+        number += (int)page.getCells().size();
+        if (DRAWIOCollector *collector = DRAWIOCollector::get())
+          collector->setMemory(DRAWIOStatistics::MEMORY_PROPERTIES,
+                               (long long)m_displayList.getMemoryUsage());
+      }
+      m_displayList.append(DRAWIODisplayList::END_DOCUMENT);
+    }
+    if (DRAWIOCollector *collector = DRAWIOCollector::get())
+      collector->setMemory(DRAWIOStatistics::MEMORY_PROPERTIES,
+                           (long long)m_displayList.getMemoryUsage());
+    if (m_painter) {
+      const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_EMIT);
+      m_displayList.replay(m_painter);
+    }
+  }
+
+  void DRAWIOParser::checkTime() const {
+    if (m_limits.maxTime > 0 && std::chrono::steady_clock::now() > m_deadline)
+      throw LimitExceeded(LimitExceeded::TIME);
+  }
+
+  DRAWIODocument::Result getLimitResult(const LimitExceeded &limit) {
+    switch (limit.getLimit()) {
+    case LimitExceeded::INPUT_BYTES:
+      return DRAWIODocument::RESULT_INPUT_TOO_LARGE;
+    case LimitExceeded::CELLS_PER_PAGE:
+      return DRAWIODocument::RESULT_TOO_MANY_CELLS;
+    case LimitExceeded::POINTS_PER_ARRAY:
+      return DRAWIODocument::RESULT_TOO_MANY_POINTS;
+    case LimitExceeded::LABEL_BYTES:
+      return DRAWIODocument::RESULT_LABEL_TOO_LARGE;
+    case LimitExceeded::TIME:
+      return DRAWIODocument::RESULT_TIME_LIMIT_EXCEEDED;
+    default:
+      return DRAWIODocument::RESULT_UNKNOWN_ERROR;
     }
-    m_painter->endDocument();
   }
 
   xmlChar *DRAWIOParser::_readStringData(xmlTextReaderPtr reader) {
@@ -377,28 +621,29 @@ namespace libdrawio {
     return -1;
   }
 
+  void DRAWIOParser::_convertDataToString(librevenge::RVNGString &result,
+                                          const xmlChar *data) {
+    if (data && *data)
+      appendUTF8(result, reinterpret_cast<const char *>(data));
+  }
+
   void DRAWIOParser::_convertDataToString(librevenge::RVNGString &result,
                                           const librevenge::RVNGBinaryData &data,
                                           TextFormat format) {
     if (!data.size())
       return;
-    std::vector<unsigned char> tmpData(data.size());
-    memcpy(&tmpData[0], data.getDataBuffer(), data.size());
-    _appendCharacters(result, tmpData, format);
+    _appendCharacters(result, data.getDataBuffer(), data.size(), format);
   }
 
   void DRAWIOParser::_appendCharacters(librevenge::RVNGString &text,
-                                       const std::vector<unsigned char> &characters,
+                                       const unsigned char *characters, unsigned long size,
                                        TextFormat format) {
     if (format == DRAWIO_TEXT_UTF16)
-      return _appendCharacters(text, characters);
+      return _appendCharacters(text, characters, size);
     if (format == DRAWIO_TEXT_UTF8) {
-      // TODO: revisit for librevenge 0.1
-      std::vector<unsigned char> buf;
-      buf.reserve(characters.size() + 1);
-      buf.assign(characters.begin(), characters.end());
-      buf.push_back(0);
-      text.append(reinterpret_cast<const char *>(buf.data()));
+      // the data is not terminated
+      const std::string str(reinterpret_cast<const char *>(characters), size);
+      appendUTF8(text, str.c_str());
       return;
     }
 
@@ -435,7 +680,8 @@ namespace libdrawio {
 
     UChar32  ucs4Character = 0;
     if (format == DRAWIO_TEXT_SYMBOL) { // SYMBOL
-      for (unsigned char character : characters) {
+      for (unsigned long i = 0; i < size; ++i) {
+        const unsigned char character = characters[i];
         if (0x1e == ucs4Character)
           ucs4Character = 0xfffc;
         else if (character < 0x20)
@@ -446,54 +692,10 @@ namespace libdrawio {
       }
     } else {
       UErrorCode status = U_ZERO_ERROR;
-      UConverter *conv = nullptr;
-      switch (format) {
-      case DRAWIO_TEXT_JAPANESE:
-        conv = ucnv_open("windows-932", &status);
-        break;
-      case DRAWIO_TEXT_KOREAN:
-        conv = ucnv_open("windows-949", &status);
-        break;
-      case DRAWIO_TEXT_CHINESE_SIMPLIFIED:
-        conv = ucnv_open("windows-936", &status);
-        break;
-      case DRAWIO_TEXT_CHINESE_TRADITIONAL:
-        conv = ucnv_open("windows-950", &status);
-        break;
-      case DRAWIO_TEXT_GREEK:
-        conv = ucnv_open("windows-1253", &status);
-        break;
-      case DRAWIO_TEXT_TURKISH:
-        conv = ucnv_open("windows-1254", &status);
-        break;
-      case DRAWIO_TEXT_VIETNAMESE:
-        conv = ucnv_open("windows-1258", &status);
-        break;
-      case DRAWIO_TEXT_HEBREW:
-        conv = ucnv_open("windows-1255", &status);
-        break;
-      case DRAWIO_TEXT_ARABIC:
-        conv = ucnv_open("windows-1256", &status);
-        break;
-      case DRAWIO_TEXT_BALTIC:
-        conv = ucnv_open("windows-1257", &status);
-        break;
-      case DRAWIO_TEXT_RUSSIAN:
-        conv = ucnv_open("windows-1251", &status);
-        break;
-      case DRAWIO_TEXT_THAI:
-        conv = ucnv_open("windows-874", &status);
-        break;
-      case DRAWIO_TEXT_CENTRAL_EUROPE:
-        conv = ucnv_open("windows-1250", &status);
-        break;
-      default:
-        conv = ucnv_open("windows-1252", &status);
-        break;
-      }
-      if (U_SUCCESS(status) && conv) {
-        const auto *src = (const char *)&characters[0];
-        const char *srcLimit = (const char *)src + characters.size();
+      UConverter *const conv = getConverter(format);
+      if (conv) {
+        const auto *src = (const char *)characters;
+        const char *srcLimit = src + size;
         while (src < srcLimit) {
           ucs4Character = ucnv_getNextUChar(conv, &src, srcLimit, &status);
           if (U_SUCCESS(status) && U_IS_UNICODE_CHAR(ucs4Character)) {
@@ -504,27 +706,23 @@ namespace libdrawio {
           }
         }
       }
-      if (conv)
-        ucnv_close(conv);
     }
   }
 
   void DRAWIOParser::_appendCharacters(librevenge::RVNGString &text,
-                                       const std::vector<unsigned char> &characters) {
+                                       const unsigned char *characters, unsigned long size) {
     UErrorCode status = U_ZERO_ERROR;
-    UConverter *conv = ucnv_open("UTF-16LE", &status);
+    UConverter *const conv = getConverter(DRAWIO_TEXT_UTF16);
 
-    if (U_SUCCESS(status) && conv) {
-      const auto *src = (const char *)&characters[0];
-      const char *srcLimit = (const char *)src + characters.size();
+    if (conv) {
+      const auto *src = (const char *)characters;
+      const char *srcLimit = src + size;
       while (src < srcLimit) {
         UChar32 ucs4Character = ucnv_getNextUChar(conv, &src, srcLimit, &status);
         if (U_SUCCESS(status) && U_IS_UNICODE_CHAR(ucs4Character))
           appendUCS4(text, ucs4Character);
       }
     }
-    if (conv)
-      ucnv_close(conv);
   }
 }
 
@@ -3,26 +3,57 @@
 #ifndef DRAWIOPARSER_H
 #define DRAWIOPARSER_H
 
+#include "DRAWIOCollector.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOImage.h"
 #include "DRAWIOPage.h"
 #include "DRAWIOTypes.h"
 #include "DRAWIOUserObject.h"
 #include "MXCell.h"
 #include "MXGeometry.h"
+#include "libdrawio_utils.h"
 #include "libdrawio_xml.h"
 #include "librevenge-stream/librevenge-stream.h"
 #include "librevenge/RVNGString.h"
 #include "librevenge/librevenge.h"
+#include <libdrawio/DRAWIODocument.h>
+#include <libdrawio/DRAWIOLimits.h>
 #include <libxml/xmlreader.h>
+#include <chrono>
 #include <map>
+#include <string>
 #include <vector>
 
 namespace libdrawio {
+  // a style as MXCell::setStyle parsed it, with the styleDigest of its cell
+  struct ParsedStyle {
+    std::string digest;
+    DRAWIOStyle style;
+    DRAWIOTextStyle text_style;
+  };
+  typedef std::map<librevenge::RVNGString, ParsedStyle> ParsedStyleMap;
+
   class DRAWIOParser {
   public:
     DRAWIOParser(librevenge::RVNGInputStream *input,
                  librevenge::RVNGDrawingInterface *painter);
     ~DRAWIOParser();
     bool parseMain();
+    // read pages and cells only, leaving the layout to the caller
+    bool parseModel();
+    // throws LimitExceeded from parseMain or parseModel when one is exceeded;
+    // the time limit counts from this call
+    void setLimits(const DRAWIOLimits &limits);
+    // throws LimitExceeded if the time limit has passed, for callers doing
+    // the layout of a model themselves
+    void checkTime() const;
+    // a cell whose style digest matches that of the cell with its id in
+    // previous takes that style instead of parsing its own; the styles of
+    // this document are put into current, which must outlive the parser
+    void reuseStyles(const ParsedStyleMap &previous, ParsedStyleMap &current);
+    const DRAWIODisplayList &getDisplayList() const;
+    const std::vector<DRAWIOPage> &getPages() const;
+    const std::map<librevenge::RVNGString, MXCell> &getCells() const;
   private:
     bool _processXmlDocument(librevenge::RVNGInputStream *input);
     void _processXmlNode(xmlTextReaderPtr reader);
@@ -33,20 +64,26 @@ namespace libdrawio {
     void _readGraphModel(xmlTextReaderPtr reader);
     void _startPage(xmlTextReaderPtr reader);
     void _flushCell();
+    void _setStyle();
+    void _accountCell(DRAWIOCollector &collector) const;
+    void _accountReader(DRAWIOCollector &collector, xmlTextReaderPtr reader,
+                        librevenge::RVNGInputStream *input) const;
     void _flushGeometry();
     void _endPage();
     void _endDocument();
     int _getElementToken(xmlTextReaderPtr reader);
     int _getElementDepth(xmlTextReaderPtr reader);
     void _handleLevelChange(unsigned level);
+    // appends an attribute value, which libxml2 gives as UTF-8
+    void _convertDataToString(librevenge::RVNGString &result, const xmlChar *data);
     void _convertDataToString(librevenge::RVNGString &result,
                               const librevenge::RVNGBinaryData &data,
                               TextFormat format);
     void _appendCharacters(librevenge::RVNGString &text,
-                           const std::vector<unsigned char> &characters,
+                           const unsigned char *characters, unsigned long size,
                            TextFormat format);
     void _appendCharacters(librevenge::RVNGString &text,
-                           const std::vector<unsigned char> &characters);
+                           const unsigned char *characters, unsigned long size);
     xmlChar *_readStringData(xmlTextReaderPtr reader);
     int _readStringData(DRAWIOName &text, xmlTextReaderPtr reader);
     int _readDoubleData(double &value, xmlTextReaderPtr reader);
@@ -61,13 +98,23 @@ namespace libdrawio {
     std::vector<DRAWIOPage> m_pages;
     bool m_objectStarted, m_cellStarted, m_geometryStarted;
     bool m_in_points_list;
+    bool m_layout;
     unsigned m_current_level;
     XMLErrorWatcher *m_watcher;
     std::map<librevenge::RVNGString, MXCell> m_id_map;
+    DRAWIOImageCache m_images;
+    const ParsedStyleMap *m_previousStyles;
+    ParsedStyleMap *m_styles;
+    DRAWIOLimits m_limits;
+    std::chrono::steady_clock::time_point m_deadline;
+    DRAWIODisplayList m_displayList;
 
     DRAWIOParser(const DRAWIOParser &parser);
     DRAWIOParser &operator=(const DRAWIOParser &parser);
   };
+
+  // the result a conversion ends with when limit is exceeded
+  DRAWIODocument::Result getLimitResult(const LimitExceeded &limit);
 }
 
 #endif
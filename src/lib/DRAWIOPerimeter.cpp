@@ -0,0 +1,154 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOPerimeter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace libdrawio {
+  namespace {
+    /* Every outline but the step and the callout is convex and holds the
+     * center, so a ray from the center leaves it at the first of its
+     * sides that it crosses. A side is the half-plane a*x + b*y <= d, and
+     * the ray is center + t*v.
+     */
+    inline double leave(double a, double b, double d, MXPoint v) {
+      const double speed = a * v.x + b * v.y;
+      return speed > 0 ? (d - (a + b) / 2) / speed : HUGE_VAL;
+    }
+
+    inline MXPoint along(MXPoint v, double t) {
+      // no side ahead only for the center itself
+      if (t == HUGE_VAL) t = 0;
+      return MXPoint(0.5 + t * v.x, 0.5 + t * v.y);
+    }
+
+    inline double across(double c) {
+      return std::max(0., std::min(c, 0.5));
+    }
+
+    // the box is the outline
+    MXPoint rectanglePerimeter(MXPoint p, double) {
+      return p;
+    }
+
+    MXPoint ellipsePerimeter(MXPoint p, double) {
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      const double r = std::hypot(v.x, v.y);
+      return r > 0 ? along(v, 0.5 / r) : p;
+    }
+
+    MXPoint trianglePerimeter(MXPoint p, double) {
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      return along(v, std::min(std::min(leave(-1, 0, 0, v), leave(1, -2, 0, v)),
+                               leave(1, 2, 2, v)));
+    }
+
+    MXPoint rhombusPerimeter(MXPoint p, double) {
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      return along(v, std::min(std::min(leave(1, 1, 1.5, v), leave(1, -1, 0.5, v)),
+                               std::min(leave(-1, 1, 0.5, v), leave(-1, -1, -0.5, v))));
+    }
+
+    MXPoint parallelogramPerimeter(MXPoint p, double c) {
+      c = across(c);
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      return along(v, std::min(std::min(leave(0, -1, 0, v), leave(0, 1, 1, v)),
+                               std::min(leave(-1, -c, -c, v), leave(1, c, 1, v))));
+    }
+
+    MXPoint hexagonPerimeter(MXPoint p, double c) {
+      c = across(c);
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      const double t = std::min(leave(0, -1, 0, v), leave(0, 1, 1, v));
+      return along(v, std::min(std::min(t, std::min(leave(-1, -2*c, -c, v), leave(-1, 2*c, c, v))),
+                               std::min(leave(1, -2*c, 1 - c, v), leave(1, 2*c, 1 + c, v))));
+    }
+
+    /* The notch of the step is the part of the box on the left of both
+     * its sides, so the ray leaves the step at the last of the two that
+     * it crosses. A notch deeper than half the box holds the center.
+     */
+    MXPoint stepPerimeter(MXPoint p, double c) {
+      c = std::max(0., c);
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      if (c > 0.5 && v.x < 0) return MXPoint(0.5, 0.5);
+      const double notch = std::max(leave(-1, 2*c, 0, v), leave(-1, -2*c, -2*c, v));
+      const double t = std::min(leave(0, -1, 0, v), leave(0, 1, 1, v));
+      return along(v, std::min(std::min(t, notch),
+                               std::min(leave(1, -2*c, 1 - c, v), leave(1, 2*c, 1 + c, v))));
+    }
+
+    MXPoint trapezoidPerimeter(MXPoint p, double c) {
+      c = across(c);
+      const MXPoint v(p.x - 0.5, p.y - 0.5);
+      return along(v, std::min(std::min(leave(0, -1, 0, v), leave(0, 1, 1, v)),
+                               std::min(leave(-1, -c, -c, v), leave(1, -c, 1 - c, v))));
+    }
+
+    // the box above the pointer, seen from its own center
+    MXPoint calloutPerimeter(MXPoint p, double c) {
+      c = std::max(0., c);
+      if (c >= 1) return p;
+      const double h = (1 - c) / 2;
+      const MXPoint v(p.x - 0.5, p.y - h);
+      const double t = std::min(0.5 / std::abs(v.x), h / std::abs(v.y));
+      return t == HUGE_VAL ? p : MXPoint(0.5 + t * v.x, h + t * v.y);
+    }
+
+    typedef MXPoint (*PerimeterKernel)(MXPoint p, double c);
+
+    // in the order of Perimeter
+    const PerimeterKernel KERNELS[] = {
+      rectanglePerimeter,
+      ellipsePerimeter,
+      trianglePerimeter,
+      calloutPerimeter,
+      rhombusPerimeter,
+      parallelogramPerimeter,
+      hexagonPerimeter,
+      stepPerimeter,
+      trapezoidPerimeter
+    };
+
+    static_assert(sizeof(KERNELS) / sizeof(KERNELS[0]) == TRAPEZOID_P + 1,
+                  "a perimeter is missing");
+  }
+
+  MXPoint projectOnPerimeter(const PerimeterShape &shape, MXPoint point) {
+    return KERNELS[shape.perimeter](point, shape.size);
+  }
+
+  void projectOnPerimeters(const PerimeterShape *shapes, MXPoint *points, size_t count) {
+    for (size_t i = 0; i < count; i++)
+      points[i] = KERNELS[shapes[i].perimeter](points[i], shapes[i].size);
+  }
+
+  ShapeTurn::ShapeTurn(Direction facing, double rotation) {
+    static const double COS[] = {0, 1, 0, -1};
+    static const double SIN[] = {-1, 0, 1, 0};
+    cosine = COS[facing]; sine = SIN[facing];
+    if (rotation != 0) {
+      const double r = rotation * pi / 180;
+      const double c = std::cos(r), s = std::sin(r);
+      const double t = cosine * c - sine * s;
+      sine = sine * c + cosine * s;
+      cosine = t;
+    }
+  }
+
+  MXPoint getBoxExit(double dx, double dy, const ShapeTurn &turn) {
+    const double u = dx * turn.cosine + dy * turn.sine;
+    const double w = dy * turn.cosine - dx * turn.sine;
+    if (std::abs(w) > std::abs(u))
+      return MXPoint(0.5 + 0.5 * u / std::abs(w), w < 0 ? 0 : 1);
+    return MXPoint(u < 0 ? 0 : 1, u != 0 ? 0.5 + 0.5 * w / std::abs(u) : 0.5);
+  }
+
+  MXPoint getBoxExit(Direction dir, const ShapeTurn &turn) {
+    static const double DX[] = {0, 1, 0, -1};
+    static const double DY[] = {-1, 0, 1, 0};
+    return getBoxExit(DX[dir], DY[dir], turn);
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,48 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOPERIMETER_H
+#define DRAWIOPERIMETER_H
+
+#include "DRAWIOTypes.h"
+#include "MXGeometry.h"
+#include <cstddef>
+
+namespace libdrawio {
+  /* The outline that edges connect to. Points are given in fractions of
+   * the unrotated box of the shape, as exitX and exitY are, in the frame
+   * of a shape facing east.
+   */
+  struct PerimeterShape {
+    Perimeter perimeter;
+    // the inset of the outline, as a fraction of the box along the
+    // direction of the shape; across it for the callout
+    double size;
+  };
+
+  /* Moves a point on or outside the box to where the ray from the center
+   * through it crosses the outline.
+   */
+  MXPoint projectOnPerimeter(const PerimeterShape &shape, MXPoint point);
+
+  // the same for count points, each on the shape of the same index
+  void projectOnPerimeters(const PerimeterShape *shapes, MXPoint *points, size_t count);
+
+  // how far a shape is turned clockwise by its direction and rotation
+  struct ShapeTurn {
+    double cosine, sine;
+    ShapeTurn() : cosine(1), sine(0) {}
+    ShapeTurn(Direction facing, double rotation);
+  };
+
+  /* Where a ray from the center of the box, heading along (dx, dy) on the
+   * page, leaves it, in the frame of a shape turned by turn.
+   */
+  MXPoint getBoxExit(double dx, double dy, const ShapeTurn &turn);
+
+  // the same for a ray heading in dir
+  MXPoint getBoxExit(Direction dir, const ShapeTurn &turn);
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
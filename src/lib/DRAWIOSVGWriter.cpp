@@ -0,0 +1,722 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOSVGWriter.h"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace libdrawio {
+  namespace {
+    const unsigned NO_CLASS = ~0u;
+
+    const char *const KEY_NAMES[] = {
+      "draw:fill", "draw:fill-color", "draw:stroke", "svg:stroke-color",
+      "draw:marker-start-path", "draw:marker-start-viewbox", "draw:marker-start-width",
+      "draw:marker-end-path", "draw:marker-end-viewbox", "draw:marker-end-width",
+      "svg:x", "svg:y", "svg:width", "svg:height", "svg:x1", "svg:y1", "svg:x2", "svg:y2",
+      "svg:cx", "svg:cy", "svg:rx", "svg:ry", "librevenge:rotate", "draw:transform", "svg:d",
+      "fo:text-align", "draw:textarea-vertical-align", "librevenge:span-id", "style:font-name",
+      "fo:font-size", "fo:color", "fo:font-weight", "fo:font-style", "style:text-underline-style",
+      "librevenge:mime-type", "office:binary-data"
+    };
+
+    // locale independent, unlike strtod
+    double parseNumber(const char *&p) {
+      while (*p == ' ' || *p == ',')
+        p++;
+      double sign = 1;
+      if (*p == '-' || *p == '+')
+        sign = *p++ == '-' ? -1 : 1;
+      double value = 0;
+      while (*p >= '0' && *p <= '9')
+        value = value * 10 + (*p++ - '0');
+      if (*p == '.') {
+        p++;
+        for (double scale = 0.1; *p >= '0' && *p <= '9'; scale /= 10)
+          value += (*p++ - '0') * scale;
+      }
+      return sign * value;
+    }
+
+    // length in a draw:transform, in points
+    double parseLength(const char *&p) {
+      double value = parseNumber(p);
+      if (!strncmp(p, "in", 2)) {
+        p += 2;
+        value *= 72;
+      } else if (!strncmp(p, "pt", 2)) {
+        p += 2;
+      } else if (!strncmp(p, "cm", 2)) {
+        p += 2;
+        value *= 72 / 2.54;
+      } else if (!strncmp(p, "mm", 2)) {
+        p += 2;
+        value *= 72 / 25.4;
+      } else {
+        value *= 72;
+      }
+      return value;
+    }
+
+    /* Values from the document go into a style sheet shared by the whole
+     * page, so they must not be able to end their rule. Colours are let
+     * through only as #rgb, #rrggbb or a name, keywords only as letters,
+     * digits and dashes; anything else gives the fallback.
+     */
+    bool isHexDigit(char c) {
+      return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    const char *cssColor(const char *value, const char *fallback) {
+      size_t length = 0;
+      if (value[0] == '#') {
+        while (isHexDigit(value[length + 1]))
+          length++;
+        return value[length + 1] == '\0' && (length == 3 || length == 6) ? value : fallback;
+      }
+      while ((value[length] >= 'a' && value[length] <= 'z')
+             || (value[length] >= 'A' && value[length] <= 'Z'))
+        length++;
+      return value[length] == '\0' && length > 0 ? value : fallback;
+    }
+
+    const char *cssKeyword(const char *value, const char *fallback) {
+      size_t length = 0;
+      while ((value[length] >= 'a' && value[length] <= 'z')
+             || (value[length] >= 'A' && value[length] <= 'Z')
+             || (value[length] >= '0' && value[length] <= '9') || value[length] == '-')
+        length++;
+      return value[length] == '\0' && length > 0 ? value : fallback;
+    }
+
+    // a CSS string, with quotes, backslashes and control characters escaped
+    void appendCSSString(std::string &out, const char *text) {
+      static const char HEX[] = "0123456789abcdef";
+      out += '"';
+      for (const char *p = text; *p; p++) {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\') {
+          out += '\\';
+          out += *p;
+        } else if (c < 0x20 || c == 0x7f) {
+          out += '\\';
+          out += HEX[c >> 4];
+          out += HEX[c & 15];
+          out += ' ';
+        } else {
+          out += *p;
+        }
+      }
+      out += '"';
+    }
+  }
+
+  DRAWIOSVGWriter::DRAWIOSVGWriter()
+    : m_list(nullptr), m_keyIds(), m_props(), m_header(), m_defs(), m_styles(),
+      m_body(), m_scratch(), m_key(), m_classes(), m_markers(), m_spanClasses(),
+      m_images(),
+      m_currentClass(NO_CLASS), m_textX(0), m_textY(0), m_textAnchor(""),
+      m_textBaseline(""), m_textOpen(false), m_lineBreaks(0), m_pages() {}
+
+  void DRAWIOSVGWriter::write(const DRAWIODisplayList &list) {
+    m_list = &list;
+    resolveKeys();
+    for (const auto &op : list.getOps()) {
+      if (op.type != DRAWIODisplayList::INSERT_TEXT)
+        collect(op);
+      switch (op.type) {
+      case DRAWIODisplayList::START_DOCUMENT:
+      case DRAWIODisplayList::END_DOCUMENT:
+      case DRAWIODisplayList::CLOSE_PARAGRAPH:
+        break;
+      case DRAWIODisplayList::OPEN_PARAGRAPH:
+        // SVG has no paragraphs; later ones start on a new line
+        if (m_textOpen)
+          m_lineBreaks++;
+        break;
+      case DRAWIODisplayList::INSERT_LINE_BREAK:
+        m_lineBreaks++;
+        break;
+      case DRAWIODisplayList::START_PAGE:
+        startPage();
+        break;
+      case DRAWIODisplayList::END_PAGE:
+        endPage();
+        break;
+      case DRAWIODisplayList::SET_STYLE:
+        setStyle();
+        break;
+      case DRAWIODisplayList::OPEN_GROUP:
+        m_body += "<g>";
+        break;
+      case DRAWIODisplayList::CLOSE_GROUP:
+        m_body += "</g>\n";
+        break;
+      case DRAWIODisplayList::DRAW_RECTANGLE:
+        writeRectangle();
+        break;
+      case DRAWIODisplayList::DRAW_ELLIPSE:
+        writeEllipse();
+        break;
+      case DRAWIODisplayList::DRAW_PATH:
+        writePath();
+        break;
+      case DRAWIODisplayList::DRAW_CONNECTOR:
+        writeConnector();
+        break;
+      case DRAWIODisplayList::DRAW_GRAPHIC_OBJECT:
+        writeImage();
+        break;
+      case DRAWIODisplayList::START_TEXT_OBJECT:
+        startText();
+        break;
+      case DRAWIODisplayList::END_TEXT_OBJECT:
+        if (m_textOpen)
+          m_body += "</text>";
+        m_textOpen = false;
+        break;
+      case DRAWIODisplayList::DEFINE_CHARACTER_STYLE:
+        defineCharacterStyle();
+        break;
+      case DRAWIODisplayList::OPEN_SPAN:
+        openSpan();
+        break;
+      case DRAWIODisplayList::CLOSE_SPAN:
+        m_body += "</tspan>";
+        break;
+      case DRAWIODisplayList::INSERT_TEXT:
+        appendEscaped(m_body, list.getString(op.first));
+        break;
+      }
+    }
+    m_list = nullptr;
+  }
+
+  const std::vector<std::string> &DRAWIOSVGWriter::getPages() const {
+    return m_pages;
+  }
+
+  void DRAWIOSVGWriter::resolveKeys() {
+    m_keyIds.assign(m_list->getStringCount(), -1);
+    for (int key = 0; key < KEY_COUNT; key++) {
+      unsigned id = m_list->findString(KEY_NAMES[key]);
+      if (id != DRAWIODisplayList::NO_STRING)
+        m_keyIds[id] = key;
+    }
+  }
+
+  void DRAWIOSVGWriter::collect(const DRAWIODisplayList::Op &op) {
+    for (auto &prop : m_props)
+      prop = nullptr;
+    // later properties override earlier ones, as in a property list
+    for (unsigned i = op.first; i < op.first + op.count; i++) {
+      const DRAWIODisplayList::Property &prop = m_list->getProperty(i);
+      int key = m_keyIds[prop.key];
+      if (key >= 0)
+        m_props[key] = &prop;
+    }
+  }
+
+  bool DRAWIOSVGWriter::has(Key key) const {
+    return m_props[key] != nullptr;
+  }
+
+  double DRAWIOSVGWriter::number(Key key) const {
+    const DRAWIODisplayList::Property *prop = m_props[key];
+    if (!prop)
+      return 0;
+    if (prop->type == DRAWIODisplayList::VALUE_DOUBLE)
+      return m_list->getNumber(prop->value);
+    if (prop->type == DRAWIODisplayList::VALUE_INT)
+      return (int)prop->value;
+    return 0;
+  }
+
+  int DRAWIOSVGWriter::integer(Key key) const {
+    const DRAWIODisplayList::Property *prop = m_props[key];
+    if (prop && prop->type == DRAWIODisplayList::VALUE_INT)
+      return (int)prop->value;
+    return (int)number(key);
+  }
+
+  const char *DRAWIOSVGWriter::string(Key key) const {
+    const DRAWIODisplayList::Property *prop = m_props[key];
+    if (prop && prop->type == DRAWIODisplayList::VALUE_STRING)
+      return m_list->getString(prop->value);
+    return "";
+  }
+
+  bool DRAWIOSVGWriter::equals(Key key, const char *value) const {
+    return has(key) && !strcmp(string(key), value);
+  }
+
+  void DRAWIOSVGWriter::startPage() {
+    m_header.clear();
+    m_defs.clear();
+    m_styles.clear();
+    m_body.clear();
+    m_classes.clear();
+    m_markers.clear();
+    m_spanClasses.clear();
+    m_images.clear();
+    m_currentClass = NO_CLASS;
+    m_textOpen = false;
+    const double width = number(KEY_WIDTH), height = number(KEY_HEIGHT);
+    m_header += "<svg xmlns=\"http://www.w3.org/2000/svg\" "
+      "xmlns:xlink=\"http://www.w3.org/1999/xlink\" version=\"1.1\" width=\"";
+    appendNumber(m_header, width);
+    m_header += "in\" height=\"";
+    appendNumber(m_header, height);
+    m_header += "in\" viewBox=\"0 0 ";
+    appendLength(m_header, width);
+    m_header += ' ';
+    appendLength(m_header, height);
+    m_header += "\">\n";
+  }
+
+  void DRAWIOSVGWriter::endPage() {
+    std::string page;
+    page.reserve(m_header.size() + m_styles.size() + m_defs.size() + m_body.size() + 64);
+    page += m_header;
+    if (!m_styles.empty() || !m_defs.empty()) {
+      page += "<defs>";
+      if (!m_styles.empty()) {
+        page += "<style type=\"text/css\">";
+        page += m_styles;
+        page += "</style>";
+      }
+      page += m_defs;
+      page += "</defs>\n";
+    }
+    page += m_body;
+    page += "</svg>\n";
+    m_pages.push_back(std::move(page));
+  }
+
+  void DRAWIOSVGWriter::setStyle() {
+    const char *strokeColor = cssColor(string(KEY_STROKE_COLOR), "#000000");
+    m_scratch.clear();
+    if (equals(KEY_FILL, "solid") && has(KEY_FILL_COLOR)) {
+      m_scratch += "fill:";
+      m_scratch += cssColor(string(KEY_FILL_COLOR), "none");
+    } else {
+      m_scratch += "fill:none";
+    }
+    if (equals(KEY_STROKE, "none")) {
+      m_scratch += ";stroke:none";
+    } else {
+      m_scratch += ";stroke:";
+      m_scratch += strokeColor;
+    }
+    if (has(KEY_MARKER_START_PATH)) {
+      unsigned id = marker(KEY_MARKER_START_PATH, KEY_MARKER_START_VIEWBOX,
+                           KEY_MARKER_START_WIDTH, strokeColor, true);
+      m_scratch += ";marker-start:url(#m";
+      appendNumber(m_scratch, id);
+      m_scratch += ')';
+    }
+    if (has(KEY_MARKER_END_PATH)) {
+      unsigned id = marker(KEY_MARKER_END_PATH, KEY_MARKER_END_VIEWBOX,
+                           KEY_MARKER_END_WIDTH, strokeColor, false);
+      m_scratch += ";marker-end:url(#m";
+      appendNumber(m_scratch, id);
+      m_scratch += ')';
+    }
+    m_currentClass = styleClass(m_scratch);
+  }
+
+  unsigned DRAWIOSVGWriter::marker(Key path, Key viewBox, Key width,
+                                   const char *color, bool start) {
+    m_key.clear();
+    m_key += start ? "s\n" : "e\n";
+    m_key += string(path);
+    m_key += '\n';
+    m_key += string(viewBox);
+    m_key += '\n';
+    appendNumber(m_key, number(width));
+    m_key += '\n';
+    m_key += color;
+    auto it = m_markers.find(m_key);
+    if (it != m_markers.end())
+      return it->second;
+    const unsigned id = (unsigned)m_markers.size();
+    m_markers.emplace(m_key, id);
+
+    const char *p = string(viewBox);
+    const double minX = parseNumber(p), minY = parseNumber(p);
+    double boxWidth = parseNumber(p), boxHeight = parseNumber(p);
+    if (boxWidth <= 0 || boxHeight <= 0)
+      boxWidth = boxHeight = 1;
+    const double cx = minX + boxWidth / 2, cy = minY + boxHeight / 2;
+    const double markerWidth = number(width);
+    // marker paths point up with the tip at the top; turn them to point
+    // away from the line, with the tip on its end point
+    m_defs += "<marker id=\"m";
+    appendNumber(m_defs, id);
+    m_defs += "\" viewBox=\"";
+    appendEscaped(m_defs, string(viewBox));
+    m_defs += "\" markerUnits=\"userSpaceOnUse\" markerWidth=\"";
+    appendLength(m_defs, markerWidth);
+    m_defs += "\" markerHeight=\"";
+    appendLength(m_defs, markerWidth * boxHeight / boxWidth);
+    m_defs += "\" refX=\"";
+    appendNumber(m_defs, start ? cx - boxHeight / 2 : cx + boxHeight / 2);
+    m_defs += "\" refY=\"";
+    appendNumber(m_defs, cy);
+    m_defs += "\" orient=\"auto\" overflow=\"visible\"><path d=\"";
+    appendEscaped(m_defs, string(path));
+    m_defs += "\" fill=\"";
+    appendEscaped(m_defs, color);
+    m_defs += "\" transform=\"rotate(";
+    m_defs += start ? "-90 " : "90 ";
+    appendNumber(m_defs, cx);
+    m_defs += ' ';
+    appendNumber(m_defs, cy);
+    m_defs += ")\"/></marker>";
+    return id;
+  }
+
+  unsigned DRAWIOSVGWriter::styleClass(const std::string &declarations) {
+    auto it = m_classes.find(declarations);
+    if (it != m_classes.end())
+      return it->second;
+    const unsigned id = (unsigned)m_classes.size();
+    m_classes.emplace(declarations, id);
+    m_styles += ".s";
+    appendNumber(m_styles, id);
+    m_styles += '{';
+    appendEscaped(m_styles, declarations.c_str());
+    m_styles += '}';
+    return id;
+  }
+
+  unsigned DRAWIOSVGWriter::characterClass() {
+    m_scratch.clear();
+    if (has(KEY_FONT_NAME)) {
+      m_scratch += "font-family:";
+      appendCSSString(m_scratch, string(KEY_FONT_NAME));
+      m_scratch += ';';
+    }
+    if (has(KEY_FONT_SIZE)) {
+      m_scratch += "font-size:";
+      appendNumber(m_scratch, number(KEY_FONT_SIZE));
+      m_scratch += "pt;";
+    }
+    m_scratch += "fill:";
+    m_scratch += cssColor(string(KEY_COLOR), "#000000");
+    if (has(KEY_FONT_WEIGHT)) {
+      m_scratch += ";font-weight:";
+      m_scratch += cssKeyword(string(KEY_FONT_WEIGHT), "normal");
+    }
+    if (has(KEY_FONT_STYLE)) {
+      m_scratch += ";font-style:";
+      m_scratch += cssKeyword(string(KEY_FONT_STYLE), "normal");
+    }
+    if (has(KEY_UNDERLINE) && !equals(KEY_UNDERLINE, "none"))
+      m_scratch += ";text-decoration:underline";
+    return styleClass(m_scratch);
+  }
+
+  void DRAWIOSVGWriter::defineCharacterStyle() {
+    m_spanClasses[integer(KEY_SPAN_ID)] = characterClass();
+  }
+
+  void DRAWIOSVGWriter::openShape(const char *element) {
+    m_body += '<';
+    m_body += element;
+    if (m_currentClass != NO_CLASS) {
+      m_body += " class=\"s";
+      appendNumber(m_body, m_currentClass);
+      m_body += '"';
+    }
+  }
+
+  void DRAWIOSVGWriter::writeRectangle() {
+    openShape("rect");
+    m_body += " x=\"";
+    appendLength(m_body, number(KEY_X));
+    m_body += "\" y=\"";
+    appendLength(m_body, number(KEY_Y));
+    m_body += "\" width=\"";
+    appendLength(m_body, number(KEY_WIDTH));
+    m_body += "\" height=\"";
+    appendLength(m_body, number(KEY_HEIGHT));
+    m_body += '"';
+    if (has(KEY_TRANSFORM))
+      writeTransform(string(KEY_TRANSFORM));
+    m_body += "/>";
+  }
+
+  void DRAWIOSVGWriter::writeEllipse() {
+    openShape("ellipse");
+    m_body += " cx=\"";
+    appendLength(m_body, number(KEY_CX));
+    m_body += "\" cy=\"";
+    appendLength(m_body, number(KEY_CY));
+    m_body += "\" rx=\"";
+    appendLength(m_body, number(KEY_RX));
+    m_body += "\" ry=\"";
+    appendLength(m_body, number(KEY_RY));
+    m_body += '"';
+    const double rotate = number(KEY_ROTATE);
+    if (rotate != 0) {
+      m_body += " transform=\"rotate(";
+      appendNumber(m_body, -rotate);
+      m_body += ' ';
+      appendLength(m_body, number(KEY_CX));
+      m_body += ' ';
+      appendLength(m_body, number(KEY_CY));
+      m_body += ")\"";
+    }
+    m_body += "/>";
+  }
+
+  void DRAWIOSVGWriter::writePath() {
+    if (!has(KEY_D) || m_props[KEY_D]->type != DRAWIODisplayList::VALUE_PATH)
+      return;
+    openShape("path");
+    m_body += " d=\"";
+    appendPath(m_body, *m_props[KEY_D]);
+    m_body += "\"/>";
+  }
+
+  void DRAWIOSVGWriter::writeConnector() {
+    // the fill of a connector style only colours its markers
+    if (has(KEY_D) && m_props[KEY_D]->type == DRAWIODisplayList::VALUE_PATH) {
+      openShape("path");
+      m_body += " style=\"fill:none\" d=\"";
+      appendPath(m_body, *m_props[KEY_D]);
+      m_body += "\"/>";
+      return;
+    }
+    openShape("line");
+    m_body += " x1=\"";
+    appendLength(m_body, number(KEY_X1));
+    m_body += "\" y1=\"";
+    appendLength(m_body, number(KEY_Y1));
+    m_body += "\" x2=\"";
+    appendLength(m_body, number(KEY_X2));
+    m_body += "\" y2=\"";
+    appendLength(m_body, number(KEY_Y2));
+    m_body += "\"/>";
+  }
+
+  // each image is written once per page, as a unit sized symbol
+  void DRAWIOSVGWriter::writeImage() {
+    const DRAWIODisplayList::Property *data = m_props[KEY_BINARY_DATA];
+    if (!data || data->type != DRAWIODisplayList::VALUE_BINARY)
+      return;
+    auto it = m_images.find(data->value);
+    if (it == m_images.end()) {
+      it = m_images.emplace(data->value, (unsigned)m_images.size()).first;
+      m_defs += "<symbol id=\"i";
+      appendNumber(m_defs, it->second);
+      m_defs += "\" viewBox=\"0 0 1 1\" preserveAspectRatio=\"none\">"
+        "<image width=\"1\" height=\"1\" preserveAspectRatio=\"none\" xlink:href=\"data:";
+      appendEscaped(m_defs, string(KEY_MIME_TYPE));
+      m_defs += ";base64,";
+      m_defs += m_list->getBinary(data->value).getBase64Data().cstr();
+      m_defs += "\"/></symbol>";
+    }
+    m_body += "<use xlink:href=\"#i";
+    appendNumber(m_body, it->second);
+    m_body += "\" x=\"";
+    appendLength(m_body, number(KEY_X));
+    m_body += "\" y=\"";
+    appendLength(m_body, number(KEY_Y));
+    m_body += "\" width=\"";
+    appendLength(m_body, number(KEY_WIDTH));
+    m_body += "\" height=\"";
+    appendLength(m_body, number(KEY_HEIGHT));
+    m_body += "\"/>\n";
+  }
+
+  void DRAWIOSVGWriter::startText() {
+    m_textOpen = false;
+    m_lineBreaks = 0;
+    const double x = number(KEY_X), y = number(KEY_Y);
+    const double width = number(KEY_WIDTH), height = number(KEY_HEIGHT);
+    if (equals(KEY_TEXT_ALIGN, "left")) {
+      m_textX = x;
+      m_textAnchor = "start";
+    } else if (equals(KEY_TEXT_ALIGN, "right")) {
+      m_textX = x + width;
+      m_textAnchor = "end";
+    } else {
+      m_textX = x + width / 2;
+      m_textAnchor = "middle";
+    }
+    if (equals(KEY_VERTICAL_ALIGN, "top")) {
+      m_textY = y;
+      m_textBaseline = "text-before-edge";
+    } else if (equals(KEY_VERTICAL_ALIGN, "bottom")) {
+      m_textY = y + height;
+      m_textBaseline = "text-after-edge";
+    } else {
+      m_textY = y + height / 2;
+      m_textBaseline = "central";
+    }
+  }
+
+  void DRAWIOSVGWriter::openSpan() {
+    if (!m_textOpen) {
+      m_body += "<text x=\"";
+      appendLength(m_body, m_textX);
+      m_body += "\" y=\"";
+      appendLength(m_body, m_textY);
+      m_body += "\" text-anchor=\"";
+      m_body += m_textAnchor;
+      m_body += "\" dominant-baseline=\"";
+      m_body += m_textBaseline;
+      m_body += "\">";
+      m_textOpen = true;
+    }
+    m_body += "<tspan";
+    if (m_lineBreaks) {
+      m_body += " x=\"";
+      appendLength(m_body, m_textX);
+      m_body += "\" dy=\"";
+      appendNumber(m_body, 1.2 * m_lineBreaks);
+      m_body += "em\"";
+      m_lineBreaks = 0;
+    }
+    // spans of styled runs carry their character properties inline
+    unsigned spanClass = NO_CLASS;
+    if (has(KEY_SPAN_ID)) {
+      auto it = m_spanClasses.find(integer(KEY_SPAN_ID));
+      if (it != m_spanClasses.end())
+        spanClass = it->second;
+    } else if (has(KEY_FONT_NAME) || has(KEY_FONT_SIZE)) {
+      spanClass = characterClass();
+    }
+    if (spanClass != NO_CLASS) {
+      m_body += " class=\"s";
+      appendNumber(m_body, spanClass);
+      m_body += '"';
+    }
+    m_body += '>';
+  }
+
+  void DRAWIOSVGWriter::writeTransform(const char *transform) {
+    // draw:transform applies its steps left to right, with angles in
+    // radians turning counterclockwise; fold them into one matrix
+    double a = 1, b = 0, c = 0, d = 1, e = 0, f = 0;
+    const char *p = transform;
+    while (*p) {
+      while (*p == ' ')
+        p++;
+      const char *name = p;
+      while (*p && *p != '(')
+        p++;
+      if (!*p)
+        break;
+      const size_t length = p++ - name;
+      if (length == 9 && !strncmp(name, "translate", 9)) {
+        e += parseLength(p);
+        f += parseLength(p);
+      } else if (length == 6 && !strncmp(name, "rotate", 6)) {
+        const double angle = parseNumber(p);
+        const double cosA = cos(angle), sinA = sin(angle);
+        const double a2 = cosA * a + sinA * b, b2 = -sinA * a + cosA * b;
+        const double c2 = cosA * c + sinA * d, d2 = -sinA * c + cosA * d;
+        const double e2 = cosA * e + sinA * f, f2 = -sinA * e + cosA * f;
+        a = a2; b = b2; c = c2; d = d2; e = e2; f = f2;
+      } else if (length == 5 && !strncmp(name, "scale", 5)) {
+        const double sx = parseNumber(p);
+        const double sy = parseNumber(p);
+        a *= sx; c *= sx; e *= sx;
+        b *= sy; d *= sy; f *= sy;
+      }
+      while (*p && *p != ')')
+        p++;
+      if (*p)
+        p++;
+    }
+    const double epsilon = 1e-9;
+    if (std::fabs(a - 1) < epsilon && std::fabs(b) < epsilon && std::fabs(c) < epsilon
+        && std::fabs(d - 1) < epsilon && std::fabs(e) < epsilon && std::fabs(f) < epsilon)
+      return;
+    m_body += " transform=\"matrix(";
+    const double values[] = {a, b, c, d, e, f};
+    for (unsigned i = 0; i < 6; i++) {
+      if (i)
+        m_body += ' ';
+      appendNumber(m_body, values[i]);
+    }
+    m_body += ")\"";
+  }
+
+  void DRAWIOSVGWriter::appendNumber(std::string &out, double value) {
+    if (!std::isfinite(value) || std::fabs(value) > 1e14) {
+      out += '0';
+      return;
+    }
+    long long scaled = std::llround(value * 10000);
+    if (scaled < 0) {
+      out += '-';
+      scaled = -scaled;
+    }
+    char digits[24];
+    int count = 0;
+    unsigned long long whole = (unsigned long long)scaled / 10000;
+    unsigned fraction = (unsigned)((unsigned long long)scaled % 10000);
+    do {
+      digits[count++] = char('0' + whole % 10);
+      whole /= 10;
+    } while (whole);
+    while (count)
+      out += digits[--count];
+    if (fraction) {
+      out += '.';
+      for (unsigned divisor = 1000; fraction; divisor /= 10) {
+        out += char('0' + fraction / divisor);
+        fraction %= divisor;
+      }
+    }
+  }
+
+  void DRAWIOSVGWriter::appendLength(std::string &out, double inches) {
+    appendNumber(out, inches * 72);
+  }
+
+  void DRAWIOSVGWriter::appendEscaped(std::string &out, const char *text) {
+    for (const char *p = text; *p; p++) {
+      switch (*p) {
+      case '&':
+        out += "&amp;";
+        break;
+      case '<':
+        out += "&lt;";
+        break;
+      case '>':
+        out += "&gt;";
+        break;
+      case '"':
+        out += "&quot;";
+        break;
+      default:
+        out += *p;
+      }
+    }
+  }
+
+  void DRAWIOSVGWriter::appendPath(std::string &out,
+                                   const DRAWIODisplayList::Property &path) {
+    for (unsigned i = path.value; i < path.value + path.count; i++) {
+      const DRAWIODisplayList::PathStep &step = m_list->getPathStep(i);
+      if (i != path.value)
+        out += ' ';
+      out += step.action;
+      // the end point is recorded first, control points follow it
+      for (unsigned k = 1; k <= step.points; k++) {
+        const unsigned point = k % step.points;
+        out += ' ';
+        appendLength(out, m_list->getNumber(step.first + 2 * point));
+        out += ' ';
+        appendLength(out, m_list->getNumber(step.first + 2 * point + 1));
+      }
+    }
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,90 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOSVGWRITER_H
+#define DRAWIOSVGWRITER_H
+
+#include "DRAWIODisplayList.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace libdrawio {
+  /* Writes SVG markup straight from a display list.
+   *
+   * This follows what librevenge's SVG generator makes of the same
+   * painter calls, but reads the typed values recorded in the list
+   * instead of building property lists, and appends to reused buffers.
+   * Every distinct shape or character style becomes one CSS class and
+   * every distinct marker one <marker>, both in the page's <defs>.
+   */
+  class DRAWIOSVGWriter {
+  public:
+    DRAWIOSVGWriter();
+    // appends one SVG document per page of the list
+    void write(const DRAWIODisplayList &list);
+    const std::vector<std::string> &getPages() const;
+
+  private:
+    enum Key {
+      KEY_FILL, KEY_FILL_COLOR, KEY_STROKE, KEY_STROKE_COLOR,
+      KEY_MARKER_START_PATH, KEY_MARKER_START_VIEWBOX, KEY_MARKER_START_WIDTH,
+      KEY_MARKER_END_PATH, KEY_MARKER_END_VIEWBOX, KEY_MARKER_END_WIDTH,
+      KEY_X, KEY_Y, KEY_WIDTH, KEY_HEIGHT, KEY_X1, KEY_Y1, KEY_X2, KEY_Y2,
+      KEY_CX, KEY_CY, KEY_RX, KEY_RY, KEY_ROTATE, KEY_TRANSFORM, KEY_D,
+      KEY_TEXT_ALIGN, KEY_VERTICAL_ALIGN, KEY_SPAN_ID, KEY_FONT_NAME,
+      KEY_FONT_SIZE, KEY_COLOR, KEY_FONT_WEIGHT, KEY_FONT_STYLE, KEY_UNDERLINE,
+      KEY_MIME_TYPE, KEY_BINARY_DATA,
+      KEY_COUNT
+    };
+
+    void resolveKeys();
+    void collect(const DRAWIODisplayList::Op &op);
+    bool has(Key key) const;
+    double number(Key key) const;
+    int integer(Key key) const;
+    const char *string(Key key) const;
+    bool equals(Key key, const char *value) const;
+
+    void startPage();
+    void endPage();
+    void setStyle();
+    unsigned marker(Key path, Key viewBox, Key width, const char *color, bool start);
+    unsigned styleClass(const std::string &declarations);
+    unsigned characterClass();
+    void defineCharacterStyle();
+    void openShape(const char *element);
+    void writeRectangle();
+    void writeEllipse();
+    void writePath();
+    void writeConnector();
+    void writeImage();
+    void startText();
+    void openSpan();
+    void writeTransform(const char *transform);
+
+    static void appendNumber(std::string &out, double value);
+    static void appendLength(std::string &out, double inches);
+    static void appendEscaped(std::string &out, const char *text);
+    void appendPath(std::string &out, const DRAWIODisplayList::Property &path);
+
+    const DRAWIODisplayList *m_list;
+    std::vector<int> m_keyIds; // string id -> Key, or -1
+    const DRAWIODisplayList::Property *m_props[KEY_COUNT];
+
+    std::string m_header, m_defs, m_styles, m_body, m_scratch, m_key;
+    std::unordered_map<std::string, unsigned> m_classes, m_markers;
+    std::map<int, unsigned> m_spanClasses; // span id -> class
+    std::unordered_map<unsigned, unsigned> m_images; // binary id -> symbol
+    unsigned m_currentClass;
+    double m_textX, m_textY;
+    const char *m_textAnchor, *m_textBaseline;
+    bool m_textOpen;
+    unsigned m_lineBreaks; // before the next span
+    std::vector<std::string> m_pages;
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
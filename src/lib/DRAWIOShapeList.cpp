@@ -1,18 +1,35 @@
 /* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
 
 #include "DRAWIOShapeList.h"
+#include "DRAWIOCollector.h"
 
 namespace libdrawio {
-  void DRAWIOShapeList::draw(librevenge::RVNGDrawingInterface *painter,
-                             std::map<librevenge::RVNGString, MXCell> id_map) {
-    for (auto shape : shapes) {
-      shape.draw(painter, id_map);
+  void DRAWIOShapeList::draw(DRAWIODisplayList &list, const DRAWIOGeometryStore &frames,
+                             DRAWIOConnectionCache &connections, int firstNumber) {
+    for (size_t i = 0; i < shapes.size(); i++) {
+      if (!shapes[i].edge) {
+        shapes[i].draw(list, frames.getFrame(i), connections, firstNumber + (int)i);
+        continue;
+      }
+      // routing fills in the end points and waypoints, so the page is kept
+      // as it was read
+      MXCell shape(shapes[i]);
+      shape.draw(list, frames.getFrame(i), connections, firstNumber + (int)i);
+      if (DRAWIOCollector *collector = DRAWIOCollector::get()) {
+        DRAWIOCollector::Memory memory;
+        shape.getMemoryUsage(memory);
+        collector->hold(memory);
+      }
     }
   }
 
   void DRAWIOShapeList::append(MXCell cell) {
     shapes.push_back(cell);
   }
+
+  const std::vector<MXCell> &DRAWIOShapeList::getShapes() const {
+    return shapes;
+  }
 }
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
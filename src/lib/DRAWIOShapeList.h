@@ -3,6 +3,9 @@
 #ifndef DRAWIOSHAPELIST_H
 #define DRAWIOSHAPELIST_H
 
+#include "DRAWIOConnections.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOGeometryStore.h"
 #include "MXCell.h"
 #include "librevenge/RVNGDrawingInterface.h"
 #include "librevenge/RVNGString.h"
@@ -16,8 +19,11 @@ namespace libdrawio {
     DRAWIOShapeList(const DRAWIOShapeList &list) = default;
     DRAWIOShapeList &operator=(const DRAWIOShapeList &list) = default;
     void append(MXCell cell);
-    void draw(librevenge::RVNGDrawingInterface *painter,
-              std::map<librevenge::RVNGString, MXCell> id_map);
+    // frames holds the frames of the shapes, in the same order; the shapes
+    // are numbered from firstNumber
+    void draw(DRAWIODisplayList &list, const DRAWIOGeometryStore &frames,
+              DRAWIOConnectionCache &connections, int firstNumber);
+    const std::vector<MXCell> &getShapes() const;
   private:
     std::vector<MXCell> shapes;
   };
@@ -0,0 +1,535 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOShapes.h"
+#include "DRAWIOStencil.h"
+#include "DRAWIOTokenMap.h"
+#include "MXCell.h"
+#include "MXGeometry.h"
+#include "librevenge/RVNGString.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace libdrawio {
+  struct PathContext {
+    DRAWIODisplayList &list;
+
+    PathContext(MXCell& cell, const ShapeFrame &frame, DRAWIODisplayList &displayList)
+      : list(displayList)
+    {
+      origin = MXPoint(frame.x, frame.y);
+      width = frame.width; height = frame.height;
+      center = MXPoint(width/2, height/2);
+      direction = cell.style.direction;
+      angle = frame.angle;
+      if (vertical(direction)) {
+        origin.x += (width - height) / 2;
+        origin.y += (height - width) / 2;
+        double t = width; width = height; height = t;
+        t = center.x; center.x = center.y; center.y = t;
+      }
+      if (direction == SOUTH) angle -= pi/2;
+      if (direction == WEST) angle -= pi;
+      if (direction == NORTH) angle += pi/2;
+    }
+
+    void moveTo(double x, double y)
+    {
+      addStep("M", {MXPoint(x, y)});
+    }
+
+    void lineTo(double x, double y)
+    {
+      addStep("L", {MXPoint(x, y)});
+    }
+
+    void quadTo(double x1, double y1, double x, double y)
+    {
+      addStep("Q", {MXPoint(x, y), MXPoint(x1, y1)});
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y)
+    {
+      addStep("C", {MXPoint(x, y), MXPoint(x1, y1), MXPoint(x2, y2)});
+    }
+
+    void close()
+    {
+      addStep("Z", {});
+    }
+
+    void addPoints(const std::vector<MXPoint>& points, bool close_path)
+    {
+      if (points.empty()) return;
+      MXPoint p = points[0];
+      moveTo(p.x, p.y);
+      size_t i = 1;
+      while (i < points.size() - (close_path ? 0 : 1)) {
+        p = points[i];
+        lineTo(p.x, p.y);
+        i++;
+      }
+      if (close_path) close();
+      else {
+        p = points[i];
+        lineTo(p.x, p.y);
+      }
+    }
+
+    MXPoint center, origin;
+    double width, height, angle;
+    Direction direction;
+
+  private:
+    void addStep(const char* action, std::vector<MXPoint>&& points)
+    {
+      for (auto& point : points) {
+        point = origin + point.rotate(center, angle);
+      }
+      list.pathStep(action[0], points);
+    }
+  };
+
+  /* Draws every painted part of a stencil as a path of its own, with the
+   * colors of the cell where the stencil does not set them.
+   */
+  static void drawStencil(PathContext &c, const DRAWIOStencil &stencil, const DRAWIOStyle &style,
+                          const librevenge::RVNGString &id, const std::string &style_name) {
+    DRAWIODisplayList &list = c.list;
+    double sx = c.width / stencil.width, sy = c.height / stencil.height;
+    double dx = 0, dy = 0;
+    if (stencil.fixedAspect) {
+      sx = sy = std::min(sx, sy);
+      dx = (c.width - stencil.width * sx) / 2;
+      dy = (c.height - stencil.height * sy) / 2;
+    }
+    for (size_t i = 0; i < stencil.parts.size(); i++) {
+      const DRAWIOStencil::Part &part = stencil.parts[i];
+      const boost::optional<Color> &fill = part.ownFill ? part.fillColor : style.fillColor;
+      const boost::optional<Color> &stroke = part.ownStroke ? part.strokeColor : style.strokeColor;
+      if (!(part.paint & DRAWIOStencil::FILL) || !fill) list.insert("draw:fill", "none");
+      else {
+        list.insert("draw:fill", "solid");
+        list.insert("draw:fill-color", fill->to_string().c_str());
+      }
+      if (!(part.paint & DRAWIOStencil::STROKE) || !stroke) list.insert("draw:stroke", "none");
+      else {
+        list.insert("draw:stroke", "solid");
+        list.insert("svg:stroke-color", stroke->to_string().c_str());
+      }
+      list.append(DRAWIODisplayList::SET_STYLE, list.closeProps());
+
+      // ids are unique, so only the first path carries them
+      if (!i && !id.empty()) {
+        list.insert("draw:id", id);
+        list.insert("xml:id", id);
+      }
+      list.insert("draw:style-name", style_name.c_str());
+      for (unsigned j = part.firstStep; j < part.firstStep + part.stepCount; j++) {
+        const DRAWIOStencil::Step &step = stencil.steps[j];
+        const MXPoint *p = &stencil.points[step.first];
+        auto x = [&](unsigned k) { return dx + p[k].x * sx; };
+        auto y = [&](unsigned k) { return dy + p[k].y * sy; };
+        switch (step.action) {
+        case 'M':
+          c.moveTo(x(0), y(0));
+          break;
+        case 'L':
+          c.lineTo(x(0), y(0));
+          break;
+        case 'Q':
+          c.quadTo(x(0), y(0), x(1), y(1));
+          break;
+        case 'C':
+          c.curveTo(x(0), y(0), x(1), y(1), x(2), y(2));
+          break;
+        default:
+          c.close();
+          break;
+        }
+      }
+      list.insert("svg:d", list.closePath());
+      list.append(DRAWIODisplayList::DRAW_PATH, list.closeProps());
+    }
+  }
+
+  // appends the path built in c as the shape
+  static void appendPath(DRAWIODisplayList &list) {
+    list.insert("svg:d", list.closePath());
+    list.append(DRAWIODisplayList::DRAW_PATH, list.closeProps());
+  }
+
+  static void drawRectangle(MXCell &, const ShapeFrame &frame, DRAWIODisplayList &list,
+                            const std::string &) {
+    double rx = frame.width / 2; double ry = frame.height / 2;
+    double cx = frame.x + rx; double cy = frame.y + ry;
+    double angle = frame.angle;
+    list.insert("svg:x", frame.x);
+    list.insert("svg:y", frame.y);
+    list.insert("svg:width", frame.width);
+    list.insert("svg:height", frame.height);
+    double dx = sqrt(pow(rx, 2.) + pow(ry, 2.))*cos(atan(ry/rx)-angle) - rx;
+    double dy = sqrt(pow(rx, 2.) + pow(ry, 2.))*sin(atan(ry/rx)-angle) - ry;
+    librevenge::RVNGString sValue = "translate(";
+    sValue.append(std::to_string(-frame.x).c_str());
+    sValue.append("in,");
+    sValue.append(std::to_string(-frame.y).c_str());
+    sValue.append("in) rotate(");
+    sValue.append(std::to_string(angle).c_str());
+    sValue.append(") translate(");
+    sValue.append(std::to_string(cx - rx - dx).c_str());
+    sValue.append("in,");
+    sValue.append(std::to_string(cy - ry - dy).c_str());
+    sValue.append("in)");
+    list.insert("draw:transform", sValue);
+    list.append(DRAWIODisplayList::DRAW_RECTANGLE, list.closeProps());
+  }
+
+  static void drawEllipse(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                          const std::string &) {
+    double rx = frame.width / 2; double ry = frame.height / 2;
+    list.insert("svg:rx", rx);
+    list.insert("svg:ry", ry);
+    list.insert("svg:cx", frame.x + rx);
+    list.insert("svg:cy", frame.y + ry);
+    list.insert("librevenge:rotate", -cell.style.rotation);
+    list.append(DRAWIODisplayList::DRAW_ELLIPSE, list.closeProps());
+  }
+
+  static void drawTriangle(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                           const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    c.addPoints({MXPoint(0,0), MXPoint(w,h/2), MXPoint(0,h)}, true);
+    appendPath(list);
+  }
+
+  static void drawCallout(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                          const std::string &) {
+    const DRAWIOStyle &style = cell.style;
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double s = std::max(0., style.calloutLength/100);
+    double dx = w * std::max(0., std::min(1., style.calloutPosition));
+    double dx2 = w * std::max(0., std::min(1., style.calloutTipPosition));
+    double base = std::max(0., style.calloutWidth/100);
+    c.addPoints({
+      MXPoint(0, 0), MXPoint(w, 0), MXPoint(w, h-s), MXPoint(dx+base, h-s),
+      MXPoint(dx2, h), MXPoint(dx, h-s), MXPoint(0, h-s)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawProcess(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                          const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double inset = w * std::max(0., std::min(1., cell.style.processBarSize));
+    c.moveTo(inset, 0);
+    c.lineTo(inset, h);
+    c.close();
+    c.moveTo(w-inset, 0);
+    c.lineTo(w-inset, h);
+    c.close();
+    c.addPoints({
+      MXPoint(0, 0), MXPoint(w, 0), MXPoint(w, h), MXPoint(0, h)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawRhombus(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                          const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    c.addPoints({
+      MXPoint(w/2, 0), MXPoint(w, h/2), MXPoint(w/2, h), MXPoint(0, h/2)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawParallelogram(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                                const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double dx = cell.style.parallelogramSize/100;
+    c.addPoints({
+      MXPoint(0, h), MXPoint(dx, 0), MXPoint(w, 0), MXPoint(w-dx, h)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawHexagon(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                          const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double s = cell.style.hexagonSize/100;
+    c.addPoints({
+      MXPoint(s, 0), MXPoint(w-s, 0), MXPoint(w, h/2),
+      MXPoint(w-s, h), MXPoint(s, h), MXPoint(0, h/2)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawStep(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                       const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double s = cell.style.stepSize/100;
+    c.addPoints({
+      MXPoint(0, 0), MXPoint(w-s, 0), MXPoint(w, h/2),
+      MXPoint(w-s, h), MXPoint(0, h), MXPoint(s, h/2)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawTrapezoid(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                            const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double dx = cell.style.trapezoidSize/100;
+    c.addPoints({
+      MXPoint(0, h), MXPoint(dx, 0), MXPoint(w-dx, 0), MXPoint(w, h)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawCard(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                       const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double s = cell.style.cardSize/100;
+    c.addPoints({
+      MXPoint(s, 0), MXPoint(w, 0), MXPoint(w, h),
+      MXPoint(0, h), MXPoint(0, s)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawInternalStorage(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                                  const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double dx = cell.style.storageX/100; double dy = cell.style.storageY/100;
+    c.moveTo(0, dy);
+    c.lineTo(w, dy);
+    c.close();
+    c.moveTo(dx, 0);
+    c.lineTo(dx, h);
+    c.close();
+    c.addPoints({
+      MXPoint(0, 0), MXPoint(w, 0), MXPoint(w, h), MXPoint(0, h)
+    }, true);
+    appendPath(list);
+  }
+
+  static void drawOr(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                     const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    c.moveTo(0, 0);
+    c.quadTo(w, 0, w, h/2);
+    c.quadTo(w, h, 0, h);
+    c.close();
+    appendPath(list);
+  }
+
+  static void drawXor(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                      const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    c.moveTo(0, 0);
+    c.quadTo(w, 0, w, h/2);
+    c.quadTo(w, h, 0, h);
+    c.quadTo(w/2, h/2, 0, 0);
+    c.close();
+    appendPath(list);
+  }
+
+  static void drawDocument(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                           const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double dy = h * cell.style.documentSize;
+    double fy = 1.4;
+    c.moveTo(0, 0);
+    c.lineTo(w, 0);
+    c.lineTo(w, h-dy/2);
+    c.quadTo(w*3/4, h-dy*fy, w/2, h-dy/2);
+    c.quadTo(w/4, h-dy*(1-fy), 0, h-dy/2);
+    c.close();
+    appendPath(list);
+  }
+
+  static void drawTape(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                       const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double dy = h * cell.style.tapeSize;
+    double fy = 1.4;
+    c.moveTo(0, dy/2);
+    c.quadTo(w/4, dy*fy, w/2, dy/2);
+    c.quadTo(w*3/4, dy*(1-fy), w, dy/2);
+    c.lineTo(w, h-dy/2);
+    c.quadTo(w*3/4, h-dy*fy, w/2, h-dy/2);
+    c.quadTo(w/4, h-dy*(1-fy), 0, h-dy/2);
+    c.close();
+    appendPath(list);
+  }
+
+  static void drawDataStorage(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                              const std::string &) {
+    PathContext c(cell, frame, list);
+    double w = c.width; double h = c.height;
+    double s = cell.style.dataStorageSize/100;
+    c.moveTo(s, 0);
+    c.lineTo(w, 0);
+    c.quadTo(w-2*s, h/2, w, h);
+    c.lineTo(s, h);
+    c.quadTo(s-2*s, h/2, s, 0);
+    c.close();
+    appendPath(list);
+  }
+
+  static void drawImage(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                        const std::string &) {
+    if (!cell.style.image)
+      return;
+    // with imageAspect the image is scaled to fit and aligned in the cell
+    const DRAWIOImage &image = *cell.style.image;
+    const DRAWIOStyle &style = cell.style;
+    double width = frame.width; double height = frame.height;
+    if (style.imageAspect && image.width > 0 && image.height > 0) {
+      double scale = std::min(width / image.width, height / image.height);
+      width = image.width * scale;
+      height = image.height * scale;
+    }
+    list.insert("svg:x", frame.x + ((int)style.imageAlign + 1) * (frame.width - width) / 2);
+    list.insert("svg:y", frame.y + ((int)style.imageVerticalAlign + 1) * (frame.height - height) / 2);
+    list.insert("svg:width", width);
+    list.insert("svg:height", height);
+    list.insert("librevenge:mime-type", image.mimeType);
+    list.insert("office:binary-data", image.data, image.hash);
+    list.append(DRAWIODisplayList::DRAW_GRAPHIC_OBJECT, list.closeProps());
+  }
+
+  static void drawStencilShape(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                               const std::string &styleName) {
+    if (!cell.style.stencil)
+      return;
+    // the ids go on the first path instead
+    list.closeProps();
+    PathContext c(cell, frame, list);
+    drawStencil(c, *cell.style.stencil, cell.style, cell.id, styleName);
+  }
+
+  namespace {
+    typedef ShapeDescriptor::Parameter Parameter;
+
+    // in the order of Shape
+    const ShapeDescriptor SHAPES[] = {
+      {RECTANGLE, "rectangle", false, RECTANGLE_P, {}, drawRectangle},
+      {ELLIPSE, "ellipse", true, ELLIPSE_P, {}, drawEllipse},
+      {TRIANGLE, "triangle", true, TRIANGLE_P, {}, drawTriangle},
+      {CALLOUT, "callout", false, CALLOUT_P, {
+          Parameter {"size", &DRAWIOStyle::calloutLength, false},
+          Parameter {"base", &DRAWIOStyle::calloutWidth, false},
+          Parameter {"position", &DRAWIOStyle::calloutPosition, false},
+          Parameter {"position2", &DRAWIOStyle::calloutTipPosition, false}
+        }, drawCallout},
+      {PROCESS, "process", false, RECTANGLE_P, {
+          Parameter {"size", &DRAWIOStyle::processBarSize, false}
+        }, drawProcess},
+      {RHOMBUS, "rhombus", true, RHOMBUS_P, {}, drawRhombus},
+      {PARALLELOGRAM, "parallelogram", false, PARALLELOGRAM_P, {
+          Parameter {"size", &DRAWIOStyle::parallelogramSize, false}
+        }, drawParallelogram},
+      {HEXAGON, "hexagon", false, HEXAGON_P, {
+          Parameter {"size", &DRAWIOStyle::hexagonSize, false}
+        }, drawHexagon},
+      {STEP, "step", false, STEP_P, {
+          Parameter {"size", &DRAWIOStyle::stepSize, true}
+        }, drawStep},
+      {TRAPEZOID, "trapezoid", false, TRAPEZOID_P, {
+          Parameter {"size", &DRAWIOStyle::trapezoidSize, false}
+        }, drawTrapezoid},
+      {CARD, "card", false, RECTANGLE_P, {
+          Parameter {"size", &DRAWIOStyle::cardSize, false}
+        }, drawCard},
+      {INTERNAL_STORAGE, "internalStorage", false, RECTANGLE_P, {
+          Parameter {"dx", &DRAWIOStyle::storageX, false},
+          Parameter {"dy", &DRAWIOStyle::storageY, false}
+        }, drawInternalStorage},
+      {OR, "or", false, RECTANGLE_P, {}, drawOr},
+      {XOR, "xor", false, RECTANGLE_P, {}, drawXor},
+      {DOCUMENT, "document", false, RECTANGLE_P, {
+          Parameter {"size", &DRAWIOStyle::documentSize, false}
+        }, drawDocument},
+      {TAPE, "tape", false, RECTANGLE_P, {
+          Parameter {"size", &DRAWIOStyle::tapeSize, false}
+        }, drawTape},
+      {DATA_STORAGE, "dataStorage", false, RECTANGLE_P, {
+          Parameter {"size", &DRAWIOStyle::dataStorageSize, false}
+        }, drawDataStorage},
+      {IMAGE, "image", false, RECTANGLE_P, {}, drawImage},
+      // named by shape=stencil(...) or by a built-in stencil
+      {STENCIL, nullptr, false, RECTANGLE_P, {}, drawStencilShape}
+    };
+
+    static_assert(sizeof(SHAPES) / sizeof(SHAPES[0]) == STENCIL + 1, "a shape is missing");
+
+    // the shapes by the token of their name, so that a name is found by
+    // the perfect hash of DRAWIOTokenMap
+    const std::vector<const ShapeDescriptor *> &getShapesByToken() {
+      static const std::vector<const ShapeDescriptor *> shapes = [] {
+        std::vector<const ShapeDescriptor *> byToken(XML_TOKEN_COUNT + 1);
+        for (const ShapeDescriptor &descriptor : SHAPES) {
+          const int token = descriptor.name ? DRAWIOTokenMap::getTokenId(BAD_CAST(descriptor.name))
+            : XML_TOKEN_INVALID;
+          if (token > 0 && token <= XML_TOKEN_COUNT)
+            byToken[token] = &descriptor;
+        }
+        return byToken;
+      }();
+      return shapes;
+    }
+  }
+
+  const ShapeDescriptor &getShapeDescriptor(Shape shape) {
+    return SHAPES[shape];
+  }
+
+  const ShapeDescriptor *findShapeDescriptor(const std::string &name) {
+    const int token = DRAWIOTokenMap::getTokenId(BAD_CAST(name.c_str()));
+    return token > 0 && token <= XML_TOKEN_COUNT ? getShapesByToken()[token] : nullptr;
+  }
+
+  PerimeterShape getPerimeterShape(const MXCell &shape) {
+    const DRAWIOStyle &style = shape.style;
+    const double length = vertical(style.direction) ? shape.geometry.height : shape.geometry.width;
+    const double breadth = vertical(style.direction) ? shape.geometry.width : shape.geometry.height;
+    PerimeterShape perimeter = {style.perimeter, 0};
+    switch (style.perimeter) {
+    case CALLOUT_P:
+      perimeter.size = style.calloutLength / breadth;
+      break;
+    case PARALLELOGRAM_P:
+      perimeter.size = style.parallelogramSize / length;
+      break;
+    case HEXAGON_P:
+      perimeter.size = style.hexagonSize / length;
+      break;
+    case STEP_P:
+      perimeter.size = style.stepSize / length;
+      break;
+    case TRAPEZOID_P:
+      perimeter.size = style.trapezoidSize / length;
+      break;
+    default:
+      break;
+    }
+    return perimeter;
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,50 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOSHAPES_H
+#define DRAWIOSHAPES_H
+
+#include "DRAWIODisplayList.h"
+#include "DRAWIOGeometryStore.h"
+#include "DRAWIOPerimeter.h"
+#include "DRAWIOStyle.h"
+#include "DRAWIOTypes.h"
+#include <string>
+
+namespace libdrawio {
+  struct MXCell;
+
+  /* What the rest of the library knows about a kind of shape. A new shape
+   * is an enumerator in Shape and an entry in the table of DRAWIOShapes.cpp.
+   */
+  struct ShapeDescriptor {
+    static const unsigned MAX_PARAMETERS = 4;
+
+    // a number in the style that shapes the outline, as in size=20
+    struct Parameter {
+      const char *key;
+      double DRAWIOStyle::*field;
+      bool relative; // a fraction of the width unless fixedSize is set
+    };
+
+    Shape shape;
+    const char *name; // the value of shape=, which must be a token; null for none
+    bool baseStyle; // the name alone, as in "rhombus;", sets the perimeter too
+    Perimeter perimeter;
+    Parameter parameters[MAX_PARAMETERS]; // up to the first without a key
+    // appends the shape in frame to the list, or nothing if it cannot be drawn
+    void (*draw)(MXCell &cell, const ShapeFrame &frame, DRAWIODisplayList &list,
+                 const std::string &styleName);
+  };
+
+  const ShapeDescriptor &getShapeDescriptor(Shape shape);
+
+  // the shape with the given name; null if there is none
+  const ShapeDescriptor *findShapeDescriptor(const std::string &name);
+
+  // the outline that edges connect to on shape, sized by its style
+  PerimeterShape getPerimeterShape(const MXCell &shape);
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,494 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOStencil.h"
+#include "DRAWIOBase64.h"
+#include "DRAWIOInflate.h"
+#include "libdrawio_utils.h"
+#include "libdrawio_xml.h"
+#include "stencilblob.h"
+#include <libxml/xmlreader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <unordered_map>
+
+namespace libdrawio {
+  namespace {
+    // stencils are a few kB; anything inflating to more is not one
+    const unsigned long MAX_STENCIL_SIZE = 1 << 20;
+    // estimated heap bytes the process-wide cache may hold
+    const unsigned long long MAX_CACHE_MEMORY = 32ULL << 20;
+    // mxConstants.RECTANGLE_ROUNDING_FACTOR, in percent
+    const double DEFAULT_ARC_SIZE = 15;
+    // control point distance of a quarter ellipse, as a fraction of the radius
+    const double ELLIPSE_KAPPA = 0.5522847498;
+
+    struct PaintState {
+      bool ownFill, ownStroke;
+      boost::optional<Color> fillColor, strokeColor;
+      PaintState() : ownFill(false), ownStroke(false), fillColor(), strokeColor() {}
+    };
+
+    /* Reads mxStencil XML element by element. Every rect, ellipse or path
+     * replaces the path drawn so far, and fill, stroke or fillstroke paint
+     * it, as on the canvas of mxGraph.
+     */
+    class StencilParser {
+    public:
+      explicit StencilParser(DRAWIOStencil &stencil)
+        : m_stencil(stencil), m_reader(nullptr), m_state(), m_saved(),
+          m_pathStart(0), m_current(), m_start() {}
+      bool parse(const char *xml, unsigned long size);
+    private:
+      void element(const xmlChar *name);
+      void pathElement(const xmlChar *name);
+      void paint(unsigned paint);
+      void beginPath();
+      void addStep(char action, std::initializer_list<MXPoint> points);
+      void arcTo(double rx, double ry, double angle, bool largeArc, bool sweep, double x, double y);
+      double number(const char *name, double value = 0) const;
+      bool flag(const char *name) const;
+      bool color(const char *name, boost::optional<Color> &value) const;
+
+      DRAWIOStencil &m_stencil;
+      xmlTextReaderPtr m_reader;
+      PaintState m_state;
+      std::vector<PaintState> m_saved;
+      unsigned m_pathStart; // first step not painted yet
+      MXPoint m_current, m_start; // of the path and of its last subpath
+    };
+
+    bool StencilParser::parse(const char *xml, unsigned long size) {
+      std::unique_ptr<xmlTextReader, void (*)(xmlTextReaderPtr)> reader {
+        xmlReaderForMemory(xml, (int)size, nullptr, nullptr,
+                           XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOERROR
+                           | XML_PARSE_NOWARNING),
+        xmlFreeTextReader
+      };
+      if (!reader)
+        return false;
+      m_reader = reader.get();
+      // depth of the shape element, and of the path being read
+      int shapeDepth = -1, pathDepth = -1;
+      int ret = xmlTextReaderRead(m_reader);
+      for (; ret == 1; ret = xmlTextReaderRead(m_reader)) {
+        const int type = xmlTextReaderNodeType(m_reader);
+        const int depth = xmlTextReaderDepth(m_reader);
+        const xmlChar *const name = xmlTextReaderConstName(m_reader);
+        if (type == XML_READER_TYPE_END_ELEMENT) {
+          if (depth == shapeDepth)
+            break;
+          if (depth == pathDepth)
+            pathDepth = -1;
+          continue;
+        }
+        if (type != XML_READER_TYPE_ELEMENT)
+          continue;
+        if (shapeDepth < 0) {
+          if (xmlStrEqual(name, BAD_CAST("shape"))) {
+            shapeDepth = depth;
+            m_stencil.width = number("w");
+            m_stencil.height = number("h");
+            const std::unique_ptr<xmlChar, void (*)(void *)>
+              aspect(xmlTextReaderGetAttribute(m_reader, BAD_CAST("aspect")), xmlFree);
+            m_stencil.fixedAspect = aspect && xmlStrEqual(aspect.get(), BAD_CAST("fixed"));
+            if (xmlTextReaderIsEmptyElement(m_reader))
+              break;
+          }
+          continue;
+        }
+        // shape > background or foreground > drawing element
+        if (depth == shapeDepth + 2) {
+          if (xmlStrEqual(name, BAD_CAST("path"))) {
+            beginPath();
+            if (!xmlTextReaderIsEmptyElement(m_reader))
+              pathDepth = depth;
+          } else {
+            element(name);
+          }
+        } else if (pathDepth >= 0 && depth == pathDepth + 1) {
+          pathElement(name);
+        }
+      }
+      m_reader = nullptr;
+      if (ret < 0 || shapeDepth < 0)
+        return false;
+      // steps that were never painted are not drawn
+      if (m_pathStart < m_stencil.steps.size()) {
+        m_stencil.points.resize(m_stencil.steps[m_pathStart].first);
+        m_stencil.steps.resize(m_pathStart);
+      }
+      return m_stencil.width > 0 && m_stencil.height > 0;
+    }
+
+    void StencilParser::element(const xmlChar *name) {
+      const char *const n = reinterpret_cast<const char *>(name);
+      if (!strcmp(n, "rect") || !strcmp(n, "roundrect")) {
+        const double x = number("x"), y = number("y"), w = number("w"), h = number("h");
+        beginPath();
+        double r = 0;
+        if (n[0] == 'r' && n[1] == 'o') {
+          const double arcSize = number("arcsize");
+          r = std::min(w, h) * (arcSize ? arcSize : DEFAULT_ARC_SIZE) / 100;
+        }
+        if (r > 0) {
+          addStep('M', {MXPoint(x + r, y)});
+          addStep('L', {MXPoint(x + w - r, y)});
+          addStep('Q', {MXPoint(x + w, y), MXPoint(x + w, y + r)});
+          addStep('L', {MXPoint(x + w, y + h - r)});
+          addStep('Q', {MXPoint(x + w, y + h), MXPoint(x + w - r, y + h)});
+          addStep('L', {MXPoint(x + r, y + h)});
+          addStep('Q', {MXPoint(x, y + h), MXPoint(x, y + h - r)});
+          addStep('L', {MXPoint(x, y + r)});
+          addStep('Q', {MXPoint(x, y), MXPoint(x + r, y)});
+        } else {
+          addStep('M', {MXPoint(x, y)});
+          addStep('L', {MXPoint(x + w, y)});
+          addStep('L', {MXPoint(x + w, y + h)});
+          addStep('L', {MXPoint(x, y + h)});
+        }
+        addStep('Z', {});
+      } else if (!strcmp(n, "ellipse")) {
+        const double x = number("x"), y = number("y"), w = number("w"), h = number("h");
+        const double cx = x + w / 2, cy = y + h / 2;
+        const double ox = w / 2 * ELLIPSE_KAPPA, oy = h / 2 * ELLIPSE_KAPPA;
+        beginPath();
+        addStep('M', {MXPoint(x, cy)});
+        addStep('C', {MXPoint(x, cy - oy), MXPoint(cx - ox, y), MXPoint(cx, y)});
+        addStep('C', {MXPoint(cx + ox, y), MXPoint(x + w, cy - oy), MXPoint(x + w, cy)});
+        addStep('C', {MXPoint(x + w, cy + oy), MXPoint(cx + ox, y + h), MXPoint(cx, y + h)});
+        addStep('C', {MXPoint(cx - ox, y + h), MXPoint(x, cy + oy), MXPoint(x, cy)});
+        addStep('Z', {});
+      } else if (!strcmp(n, "fill")) {
+        paint(DRAWIOStencil::FILL);
+      } else if (!strcmp(n, "stroke")) {
+        paint(DRAWIOStencil::STROKE);
+      } else if (!strcmp(n, "fillstroke")) {
+        paint(DRAWIOStencil::FILL_STROKE);
+      } else if (!strcmp(n, "fillcolor")) {
+        if (color("color", m_state.fillColor))
+          m_state.ownFill = true;
+      } else if (!strcmp(n, "strokecolor")) {
+        if (color("color", m_state.strokeColor))
+          m_state.ownStroke = true;
+      } else if (!strcmp(n, "save")) {
+        m_saved.push_back(m_state);
+      } else if (!strcmp(n, "restore")) {
+        if (!m_saved.empty()) {
+          m_state = m_saved.back();
+          m_saved.pop_back();
+        }
+      }
+      // text, images, included shapes and line styles are not drawn
+    }
+
+    void StencilParser::pathElement(const xmlChar *name) {
+      const char *const n = reinterpret_cast<const char *>(name);
+      if (!strcmp(n, "move")) {
+        m_start = MXPoint(number("x"), number("y"));
+        addStep('M', {m_start});
+      } else if (!strcmp(n, "line")) {
+        addStep('L', {MXPoint(number("x"), number("y"))});
+      } else if (!strcmp(n, "quad")) {
+        addStep('Q', {MXPoint(number("x1"), number("y1")), MXPoint(number("x2"), number("y2"))});
+      } else if (!strcmp(n, "curve")) {
+        addStep('C', {MXPoint(number("x1"), number("y1")), MXPoint(number("x2"), number("y2")),
+                      MXPoint(number("x3"), number("y3"))});
+      } else if (!strcmp(n, "arc")) {
+        arcTo(number("rx"), number("ry"), number("x-axis-rotation"), flag("large-arc-flag"),
+              flag("sweep-flag"), number("x"), number("y"));
+      } else if (!strcmp(n, "close")) {
+        addStep('Z', {});
+        m_current = m_start;
+      }
+    }
+
+    void StencilParser::paint(unsigned paint) {
+      const unsigned count = (unsigned)m_stencil.steps.size() - m_pathStart;
+      if (!count)
+        return;
+      DRAWIOStencil::Part part;
+      part.firstStep = m_pathStart;
+      part.stepCount = count;
+      part.paint = paint;
+      part.ownFill = m_state.ownFill;
+      part.ownStroke = m_state.ownStroke;
+      part.fillColor = m_state.fillColor;
+      part.strokeColor = m_state.strokeColor;
+      m_stencil.parts.push_back(part);
+      m_pathStart = (unsigned)m_stencil.steps.size();
+    }
+
+    void StencilParser::beginPath() {
+      if (m_pathStart < m_stencil.steps.size()) {
+        m_stencil.points.resize(m_stencil.steps[m_pathStart].first);
+        m_stencil.steps.resize(m_pathStart);
+      }
+      m_current = m_start = MXPoint();
+    }
+
+    void StencilParser::addStep(char action, std::initializer_list<MXPoint> points) {
+      m_stencil.steps.push_back({action, (unsigned)m_stencil.points.size()});
+      m_stencil.points.insert(m_stencil.points.end(), points);
+      if (points.size())
+        m_current = *(points.end() - 1);
+    }
+
+    /* An SVG elliptical arc as cubic curves of at most a quarter turn
+     * each, from its endpoint parametrization (SVG 1.1, appendix F.6).
+     */
+    void StencilParser::arcTo(double rx, double ry, double angle, bool largeArc, bool sweep,
+                              double x, double y) {
+      const MXPoint from = m_current;
+      if (from.x == x && from.y == y)
+        return;
+      rx = std::abs(rx);
+      ry = std::abs(ry);
+      if (!rx || !ry) {
+        addStep('L', {MXPoint(x, y)});
+        return;
+      }
+      const double phi = angle * pi / 180, cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+      const double dx = (from.x - x) / 2, dy = (from.y - y) / 2;
+      const double x1 = cosPhi * dx + sinPhi * dy, y1 = -sinPhi * dx + cosPhi * dy;
+      const double lambda = x1 * x1 / (rx * rx) + y1 * y1 / (ry * ry);
+      if (lambda > 1) {
+        rx *= std::sqrt(lambda);
+        ry *= std::sqrt(lambda);
+      }
+      const double rx2 = rx * rx, ry2 = ry * ry;
+      const double denominator = rx2 * y1 * y1 + ry2 * x1 * x1;
+      double coef = denominator > 0 ? std::sqrt(std::max(0., (rx2 * ry2 - denominator) / denominator)) : 0;
+      if (largeArc == sweep)
+        coef = -coef;
+      const double cx1 = coef * rx * y1 / ry, cy1 = -coef * ry * x1 / rx;
+      const double cx = cosPhi * cx1 - sinPhi * cy1 + (from.x + x) / 2;
+      const double cy = sinPhi * cx1 + cosPhi * cy1 + (from.y + y) / 2;
+      const double theta = std::atan2((y1 - cy1) / ry, (x1 - cx1) / rx);
+      double delta = std::atan2((-y1 - cy1) / ry, (-x1 - cx1) / rx) - theta;
+      if (!sweep && delta > 0)
+        delta -= 2 * pi;
+      else if (sweep && delta < 0)
+        delta += 2 * pi;
+
+      const int segments = std::max(1, (int)std::ceil(std::abs(delta) / (pi / 2) - 1e-9));
+      const double step = delta / segments;
+      const double t = 4. / 3 * std::tan(step / 4);
+      double a = theta;
+      MXPoint p = from;
+      for (int i = 0; i < segments; i++) {
+        const double cosA = std::cos(a), sinA = std::sin(a);
+        const double b = a + step, cosB = std::cos(b), sinB = std::sin(b);
+        const MXPoint c1(p.x - t * (rx * sinA * cosPhi + ry * cosA * sinPhi),
+                         p.y - t * (rx * sinA * sinPhi - ry * cosA * cosPhi));
+        const MXPoint q = i + 1 == segments ? MXPoint(x, y)
+          : MXPoint(cx + rx * cosB * cosPhi - ry * sinB * sinPhi,
+                    cy + rx * cosB * sinPhi + ry * sinB * cosPhi);
+        const MXPoint c2(q.x + t * (rx * sinB * cosPhi + ry * cosB * sinPhi),
+                         q.y + t * (rx * sinB * sinPhi - ry * cosB * cosPhi));
+        addStep('C', {c1, c2, q});
+        p = q;
+        a = b;
+      }
+    }
+
+    double StencilParser::number(const char *name, double value) const {
+      const std::unique_ptr<xmlChar, void (*)(void *)>
+        attribute(xmlTextReaderGetAttribute(m_reader, BAD_CAST(name)), xmlFree);
+      if (attribute && *attribute) {
+        value = xmlStringToDouble(attribute.get());
+        if (!std::isfinite(value))
+          throw XmlParserException();
+      }
+      return value;
+    }
+
+    bool StencilParser::flag(const char *name) const {
+      return number(name) != 0;
+    }
+
+    // false if the color is missing or not understood, so the old one stays
+    bool StencilParser::color(const char *name, boost::optional<Color> &value) const {
+      const std::unique_ptr<xmlChar, void (*)(void *)>
+        attribute(xmlTextReaderGetAttribute(m_reader, BAD_CAST(name)), xmlFree);
+      if (!attribute)
+        return false;
+      if (xmlStrEqual(attribute.get(), BAD_CAST("none"))) {
+        value = boost::none;
+        return true;
+      }
+      try {
+        value = xmlStringToColor(attribute.get());
+        return true;
+      } catch (const XmlParserException &) {
+        return false;
+      }
+    }
+
+    // %XX escapes as left by encodeURIComponent
+    void decodeURI(std::vector<unsigned char> &text) {
+      auto hex = [](unsigned char c) -> int {
+        if (c >= '0' && c <= '9')
+          return c - '0';
+        if (c >= 'a' && c <= 'f')
+          return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+          return c - 'A' + 10;
+        return -1;
+      };
+      size_t out = 0;
+      for (size_t i = 0; i < text.size(); i++) {
+        int high, low;
+        if (text[i] == '%' && i + 2 < text.size() && (high = hex(text[i + 1])) >= 0
+            && (low = hex(text[i + 2])) >= 0) {
+          text[out++] = (unsigned char)(high << 4 | low);
+          i += 2;
+        } else {
+          text[out++] = text[i];
+        }
+      }
+      text.resize(out);
+    }
+
+    struct CacheEntry {
+      std::string encoded;
+      std::shared_ptr<const DRAWIOStencil> stencil;
+    };
+
+    // stencils that are decoded, broken ones included, oldest first out
+    struct StencilCache {
+      std::mutex mutex;
+      std::unordered_map<uint64_t, CacheEntry> entries;
+      std::deque<uint64_t> order;
+      unsigned long long memory = 0;
+    };
+
+    unsigned long long getEntryMemory(const CacheEntry &entry) {
+      // a hash node holds the next pointer and the key besides the entry
+      unsigned long long memory = 2 * sizeof(void *) + sizeof(CacheEntry)
+        + entry.encoded.capacity() + sizeof(uint64_t);
+      if (entry.stencil)
+        memory += entry.stencil->getMemoryUsage();
+      return memory;
+    }
+
+    // FNV-1a with a seed; must match stencilHash in packstencils.pl
+    uint32_t stencilHash(const std::string &name, uint32_t seed) {
+      uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+      for (const char c : name) {
+        hash ^= (unsigned char)c;
+        hash *= 16777619u;
+      }
+      return hash;
+    }
+
+    // the slot of a built-in shape, or SHAPE_COUNT if there is none
+    unsigned findBuiltinStencil(const std::string &name) {
+      using namespace stencilblob;
+      const unsigned seed = SEEDS[stencilHash(name, 0) % BUCKET_COUNT];
+      const unsigned slot = stencilHash(name, seed) % SHAPE_COUNT;
+      // every name hashes to some slot; only the right one holds it
+      if (seed == 0 || name != NAMES + RECORDS[slot][0])
+        return SHAPE_COUNT;
+      return slot;
+    }
+  }
+
+  unsigned long long DRAWIOStencil::getMemoryUsage() const {
+    return sizeof(DRAWIOStencil) + parts.capacity() * sizeof(Part)
+      + steps.capacity() * sizeof(Step) + points.capacity() * sizeof(MXPoint);
+  }
+
+  std::shared_ptr<const DRAWIOStencil> parseStencil(const char *xml, unsigned long size) try {
+    std::shared_ptr<DRAWIOStencil> stencil = std::make_shared<DRAWIOStencil>();
+    StencilParser parser(*stencil);
+    if (!parser.parse(xml, size))
+      return std::shared_ptr<const DRAWIOStencil>();
+    stencil->parts.shrink_to_fit();
+    stencil->steps.shrink_to_fit();
+    stencil->points.shrink_to_fit();
+    return stencil;
+  } catch (const XmlParserException &) {
+    return std::shared_ptr<const DRAWIOStencil>();
+  }
+
+  std::shared_ptr<const DRAWIOStencil> decodeStencil(const char *encoded, unsigned long size) {
+    std::vector<unsigned char> deflated(Base64Decoder::getMaxDecodedSize(size));
+    Base64Decoder decoder;
+    deflated.resize(decoder.decode(encoded, size, deflated.data()));
+    if (!decoder.finish())
+      return std::shared_ptr<const DRAWIOStencil>();
+    std::vector<unsigned char> xml;
+    if (!inflateRaw(deflated.data(), deflated.size(), MAX_STENCIL_SIZE, xml))
+      return std::shared_ptr<const DRAWIOStencil>();
+    // draw.io escapes the XML before deflating it; older files did not
+    size_t start = 0;
+    while (start < xml.size() && (xml[start] == ' ' || xml[start] == '\n' || xml[start] == '\r'
+                                  || xml[start] == '\t'))
+      start++;
+    if (start < xml.size() && xml[start] != '<')
+      decodeURI(xml);
+    return parseStencil(reinterpret_cast<const char *>(xml.data()), xml.size());
+  }
+
+  std::shared_ptr<const DRAWIOStencil> getStencil(const std::string &encoded) {
+    static StencilCache cache;
+    const uint64_t hash = hashBytes(encoded.data(), encoded.size());
+    {
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      const auto it = cache.entries.find(hash);
+      if (it != cache.entries.end() && it->second.encoded == encoded)
+        return it->second.stencil;
+    }
+    // decoded without the lock; another thread may be doing the same
+    CacheEntry entry = {encoded, decodeStencil(encoded.data(), encoded.size())};
+    const std::shared_ptr<const DRAWIOStencil> stencil = entry.stencil;
+    const unsigned long long memory = getEntryMemory(entry);
+    if (memory > MAX_CACHE_MEMORY)
+      return stencil;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.entries.count(hash))
+      return stencil; // a colliding or concurrent entry stays
+    while (cache.memory + memory > MAX_CACHE_MEMORY && !cache.order.empty()) {
+      const auto it = cache.entries.find(cache.order.front());
+      cache.memory -= getEntryMemory(it->second);
+      cache.entries.erase(it);
+      cache.order.pop_front();
+    }
+    cache.entries.emplace(hash, std::move(entry));
+    cache.order.push_back(hash);
+    cache.memory += memory;
+    return stencil;
+  }
+
+  std::shared_ptr<const DRAWIOStencil> getBuiltinStencil(const std::string &name) {
+    // stencils built into the library, each compiled on first use
+    static std::mutex mutex;
+    static std::unordered_map<unsigned, std::shared_ptr<const DRAWIOStencil> > stencils;
+    std::string lowerName(name);
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
+                   [](char c) { return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c; });
+    const unsigned slot = findBuiltinStencil(lowerName);
+    if (slot == stencilblob::SHAPE_COUNT)
+      return std::shared_ptr<const DRAWIOStencil>();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto it = stencils.find(slot);
+      if (it != stencils.end())
+        return it->second;
+    }
+    const unsigned *const record = stencilblob::RECORDS[slot];
+    std::vector<unsigned char> xml;
+    std::shared_ptr<const DRAWIOStencil> stencil;
+    if (inflateRaw(stencilblob::DATA + record[1], record[2], record[3], xml))
+      stencil = parseStencil(reinterpret_cast<const char *>(xml.data()), xml.size());
+    std::lock_guard<std::mutex> lock(mutex);
+    // if another thread was quicker, its stencil is shared
+    return stencils.emplace(slot, stencil).first->second;
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
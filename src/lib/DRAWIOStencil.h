@@ -0,0 +1,73 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOSTENCIL_H
+#define DRAWIOSTENCIL_H
+
+#include "DRAWIOTypes.h"
+#include "MXGeometry.h"
+#include <boost/optional.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace libdrawio {
+  /* A shape given as mxStencil XML, compiled into paths in the units of
+   * the stencil. Arcs, rectangles and ellipses are turned into lines and
+   * curves on the way, so drawing a stencil is only scaling its points.
+   */
+  struct DRAWIOStencil {
+    enum Paint {
+      FILL = 1,
+      STROKE = 2,
+      FILL_STROKE = FILL | STROKE
+    };
+
+    struct Step {
+      char action; // M, L, Q, C or Z
+      unsigned first; // in points: the control points, then the end point
+    };
+
+    // a path and how it is painted
+    struct Part {
+      unsigned firstStep, stepCount;
+      unsigned paint;
+      bool ownFill, ownStroke; // the stencil sets the color, not the style
+      boost::optional<Color> fillColor, strokeColor;
+    };
+
+    double width, height;
+    bool fixedAspect; // scaled by the same factor in both directions
+    std::vector<Part> parts;
+    std::vector<Step> steps;
+    std::vector<MXPoint> points;
+
+    DRAWIOStencil()
+      : width(0), height(0), fixedAspect(false), parts(), steps(), points() {}
+    // estimated heap bytes, the stencil itself included
+    unsigned long long getMemoryUsage() const;
+  };
+
+  // compiles the first shape element in xml; null if there is none
+  std::shared_ptr<const DRAWIOStencil> parseStencil(const char *xml, unsigned long size);
+
+  /* Decodes, inflates and parses the argument of shape=stencil(...).
+   * Null if it is broken.
+   */
+  std::shared_ptr<const DRAWIOStencil> decodeStencil(const char *encoded, unsigned long size);
+
+  /* decodeStencil through a cache shared by the whole process, keyed by a
+   * hash of the encoded string, so that a stencil used by many cells and
+   * documents is only decoded once.
+   */
+  std::shared_ptr<const DRAWIOStencil> getStencil(const std::string &encoded);
+
+  /* A stencil built into the library, by its style name, e.g.
+   * mxgraph.flowchart.decision; null if there is none. Each one is
+   * inflated and compiled when it is first asked for.
+   */
+  std::shared_ptr<const DRAWIOStencil> getBuiltinStencil(const std::string &name);
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -5,7 +5,10 @@
 
 #include <boost/optional.hpp>
 #include <boost/optional/optional.hpp>
+#include "DRAWIOImage.h"
+#include "DRAWIOStencil.h"
 #include "DRAWIOTypes.h"
+#include <memory>
 
 namespace libdrawio {
   struct DRAWIOStyle {
@@ -15,6 +18,7 @@ namespace libdrawio {
     boost::optional<double> exitX, exitY; // same range as above
     double entryDx, entryDy, exitDx, exitDy;
     bool wrapText;
+    bool html = false; // the label is HTML
     double rotation; // rotation in [0,360]
     boost::optional<Color> fillColor = Color(255, 255, 255, 1);
     double margin;
@@ -64,6 +68,11 @@ namespace libdrawio {
     AlignV verticalAlign = MIDDLE;
     AlignH position = CENTER;
     AlignV verticalPosition = MIDDLE;
+    std::shared_ptr<const DRAWIOImage> image; // shared by the cells using it
+    bool imageAspect = true;
+    AlignH imageAlign = CENTER;
+    AlignV imageVerticalAlign = MIDDLE;
+    std::shared_ptr<const DRAWIOStencil> stencil; // shared by the whole process
   };
 
   struct DRAWIOTextStyle {
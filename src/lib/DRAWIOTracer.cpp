@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#include "DRAWIOTracer.h"
+#include <cstdio>
+
+namespace libdrawio {
+  namespace {
+    void writeString(FILE *file, const std::string &str) {
+      fputc('"', file);
+      for (const char c : str) {
+        if (c == '"' || c == '\\')
+          fprintf(file, "\\%c", c);
+        else if ((unsigned char)c < 0x20)
+          fprintf(file, "\\u%04x", (unsigned)c);
+        else
+          fputc(c, file);
+      }
+      fputc('"', file);
+    }
+  }
+
+  thread_local DRAWIOTracer *DRAWIOTracer::s_current = nullptr;
+
+  DRAWIOTracer::DRAWIOTracer(const char *path, unsigned threshold)
+    : m_path(path), m_threshold(threshold), m_previous(s_current),
+      m_start(std::chrono::steady_clock::now()), m_events() {
+    s_current = this;
+  }
+
+  DRAWIOTracer::~DRAWIOTracer() {
+    s_current = m_previous;
+    write();
+  }
+
+  void DRAWIOTracer::write() const {
+    FILE *const file = fopen(m_path.c_str(), "w");
+    if (!file)
+      return;
+    fprintf(file, "{\"traceEvents\": [");
+    const char *separator = "\n";
+    for (const auto &event : m_events) {
+      fprintf(file, "%s{\"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"cat\": \"%s\", \"name\": ",
+              separator, event.category);
+      writeString(file, event.name.empty() ? std::string(event.category) : event.name);
+      fprintf(file, ", \"ts\": %.3f, \"dur\": %.3f", event.start, event.duration);
+      if (!event.id.empty()) {
+        fprintf(file, ", \"args\": {\"id\": ");
+        writeString(file, event.id);
+        fputc('}', file);
+      }
+      fputc('}', file);
+      separator = ",\n";
+    }
+    fprintf(file, "\n], \"displayTimeUnit\": \"ms\"}\n");
+    fclose(file);
+  }
+
+  DRAWIOTracer::Span::Span(const char *category, const char *name,
+                           const char *id, bool filtered)
+    : m_tracer(s_current), m_category(category), m_name(name), m_id(id),
+      m_filtered(filtered), m_start() {
+    if (m_tracer)
+      m_start = std::chrono::steady_clock::now();
+  }
+
+  DRAWIOTracer::Span::~Span() {
+    if (!m_tracer)
+      return;
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    const double duration = std::chrono::duration<double, std::micro>(end - m_start).count();
+    if (m_filtered && duration < m_tracer->m_threshold)
+      return;
+    Event event;
+    event.category = m_category;
+    event.name = m_name ? m_name : "";
+    event.id = m_id ? m_id : "";
+    event.start = std::chrono::duration<double, std::micro>(m_start - m_tracer->m_start).count();
+    event.duration = duration;
+    m_tracer->m_events.push_back(event);
+  }
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
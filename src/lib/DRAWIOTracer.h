@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+
+#ifndef DRAWIOTRACER_H
+#define DRAWIOTRACER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace libdrawio {
+  /* Writes the spans of the conversion running on this thread to a file in
+   * the Chrome trace_event format, which chrome://tracing and Perfetto
+   * open.
+   *
+   * Like DRAWIOCollector, a span costs a thread-local load and a branch
+   * when no conversion is traced. Spans are kept in memory and written when
+   * the tracer goes away; writing is best effort.
+   */
+  class DRAWIOTracer {
+  public:
+    // threshold: in microseconds, below which filtered spans are dropped
+    DRAWIOTracer(const char *path, unsigned threshold);
+    ~DRAWIOTracer();
+
+    class Span {
+    public:
+      // the strings must outlive the span; filtered spans are only kept if
+      // they last at least the threshold
+      explicit Span(const char *category, const char *name = nullptr,
+                    const char *id = nullptr, bool filtered = false);
+      ~Span();
+    private:
+      DRAWIOTracer *const m_tracer;
+      const char *m_category;
+      const char *m_name;
+      const char *m_id;
+      bool m_filtered;
+      std::chrono::steady_clock::time_point m_start;
+
+      Span(const Span &span);
+      Span &operator=(const Span &span);
+    };
+
+  private:
+    struct Event {
+      const char *category;
+      std::string name, id;
+      double start, duration; // microseconds
+    };
+
+    static thread_local DRAWIOTracer *s_current;
+
+    std::string m_path;
+    double m_threshold;
+    DRAWIOTracer *const m_previous;
+    std::chrono::steady_clock::time_point m_start;
+    std::vector<Event> m_events;
+
+    void write() const;
+
+    DRAWIOTracer(const DRAWIOTracer &tracer);
+    DRAWIOTracer &operator=(const DRAWIOTracer &tracer);
+  };
+}
+
+#endif
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -89,7 +89,9 @@ namespace libdrawio {
     XOR,
     DOCUMENT,
     TAPE,
-    DATA_STORAGE
+    DATA_STORAGE,
+    IMAGE,
+    STENCIL
   };
 
   enum Perimeter {
@@ -131,9 +133,9 @@ namespace libdrawio {
     inline bool operator!() const {
       return (!r && !g && !b && !a);
     }
-    std::string to_string() {
+    std::string to_string() const {
       std::stringstream out;
-      out << "#" << std::hex
+      out << "#" << std::hex << std::setfill('0')
           << std::setw(2) << (unsigned)r
           << std::setw(2) << (unsigned)g
           << std::setw(2) << (unsigned)b;
@@ -1,8 +1,17 @@
 /* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
 
 #include "MXCell.h"
+#include "DRAWIOCollector.h"
+#include "DRAWIOConnections.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOLabel.h"
+#include "DRAWIOPerimeter.h"
+#include "DRAWIOShapes.h"
+#include "DRAWIOStencil.h"
+#include "DRAWIOTracer.h"
 #include "DRAWIOTypes.h"
 #include "MXGeometry.h"
+#include "libdrawio_utils.h"
 #include "libdrawio_xml.h"
 #include "librevenge/RVNGPropertyList.h"
 #include "librevenge/RVNGPropertyListVector.h"
@@ -12,6 +21,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/none.hpp>
+#include <climits>
 #include <cmath>
 #include <complex>
 #include <cstdlib>
@@ -27,360 +37,191 @@
 #include <librevenge/librevenge.h>
 
 namespace libdrawio {
-  struct PathContext {
-    librevenge::RVNGPropertyListVector path;
-
-    PathContext(MXCell& cell)
-    {
-      origin = MXPoint(cell.geometry.x/100, cell.geometry.y/100);
-      width = cell.geometry.width/100; height = cell.geometry.height/100;
-      center = MXPoint(width/2, height/2);
-      direction = cell.style.direction;
-      angle = -cell.style.rotation * pi / 180;
-      if (vertical(direction)) {
-        origin.x += (width - height) / 2;
-        origin.y += (height - width) / 2;
-        double t = width; width = height; height = t;
-        t = center.x; center.x = center.y; center.y = t;
-      }
-      if (direction == SOUTH) angle -= pi/2;
-      if (direction == WEST) angle -= pi;
-      if (direction == NORTH) angle += pi/2;
-    }
-
-    void moveTo(double x, double y)
-    {
-      addStep("M", {MXPoint(x, y)});
-    }
-
-    void lineTo(double x, double y)
-    {
-      addStep("L", {MXPoint(x, y)});
-    }
-
-    void quadTo(double x1, double y1, double x, double y)
-    {
-      addStep("Q", {MXPoint(x, y), MXPoint(x1, y1)});
-    }
-
-    void curveTo(double x1, double y1, double x2, double y2, double x, double y)
-    {
-      addStep("C", {MXPoint(x, y), MXPoint(x1, y1), MXPoint(x2, y2)});
-    }
+  // coordinates come from the document and may be out of range, or not numbers at all
+  static int toInt(double value) {
+    if (!(value > INT_MIN))
+      return value != value ? 0 : INT_MIN;
+    return value < INT_MAX ? (int)value : INT_MAX;
+  }
 
-    void close()
-    {
-      addStep("Z", {});
-    }
+  // an orthogonal route needs a few bends; more steps mean the routing is not converging
+  static const unsigned MAX_ROUTE_STEPS = 32;
 
-    void addPoints(const std::vector<MXPoint>& points, bool close_path)
-    {
-      if (points.empty()) return;
-      MXPoint p = points[0];
-      moveTo(p.x, p.y);
-      int i = 1;
-      while (i < points.size() - (close_path ? 0 : 1)) {
-        p = points[i];
-        lineTo(p.x, p.y);
-        i++;
-      }
-      if (close_path) close();
-      else {
-        p = points[i];
-        lineTo(p.x, p.y);
-      }
-    }
+  static std::string getStyleName(int number) {
+    return "gr_" + std::to_string(number);
+  }
 
-    MXPoint center, origin;
-    double width, height, angle;
-    Direction direction;
+  void MXCell::draw(DRAWIODisplayList &list, const ShapeFrame &frame,
+                    DRAWIOConnectionCache &connections, int number) {
+    std::string style_name = getStyleName(number);
+    insertStyle(list);
+    list.insert("style:display-name", style_name.c_str());
+    DRAWIODisplayList::Props styleProps = list.closeProps();
+    list.append(DRAWIODisplayList::SET_STYLE, styleProps);
 
-  private:
-    void addStep(const char* action, std::vector<MXPoint>&& points)
-    {
-      for (auto& point : points) {
-        point = origin + point.rotate(center, angle);
-      }
-      librevenge::RVNGPropertyList step;
-      step.insert("librevenge:path-action", action);
-      if (points.size() >= 1) {
-        step.insert("svg:x", points[0].x);
-        step.insert("svg:y", points[0].y);
-      } if (points.size() >= 2) {
-        step.insert("svg:x1", points[1].x);
-        step.insert("svg:y1", points[1].y);
-      } if (points.size() >= 3) {
-        step.insert("svg:x2", points[2].x);
-        step.insert("svg:y2", points[2].y);
-      }
-      path.append(step);
-    }
-  };
-  
-  int MXCell::draw_count = 0;
+    list.append(DRAWIODisplayList::OPEN_GROUP);
 
-  void MXCell::draw(librevenge::RVNGDrawingInterface *painter,
-                    std::map<librevenge::RVNGString, MXCell> id_map) {
-    librevenge::RVNGPropertyList propList;
     if (!id.empty()) {
-      propList.insert("draw:id", id);
-      propList.insert("xml:id", id);
+      list.insert("draw:id", id);
+      list.insert("xml:id", id);
     }
-    std::string style_name = "gr_" + std::to_string(draw_count);
-    librevenge::RVNGPropertyList styleProps = getStyle();
-    styleProps.insert("style:display-name", style_name.c_str());
-    propList.insert("draw:style-name", style_name.c_str());
-    painter->setStyle(styleProps);
-
-    painter->openGroup(librevenge::RVNGPropertyList());
+    list.insert("draw:style-name", style_name.c_str());
 
     if (edge) {
-      setEndPoints(id_map);
-      setWaypoints(id_map);
+      {
+        const DRAWIOCollector::Phase phase(DRAWIOStatistics::PHASE_ROUTE);
+        const DRAWIOTracer::Span span("route", id.cstr(), id.cstr(), true);
+        setEndPoints(connections);
+        setWaypoints(connections);
+      }
       calculateBounds();
       if (!source_id.empty()) {
-        propList.insert("draw:start-shape", source_id);
+        list.insert("draw:start-shape", source_id);
       }
       if (!target_id.empty()) {
-        propList.insert("draw:end-shape", target_id);
+        list.insert("draw:end-shape", target_id);
       }
 
-      propList.insert("svg:x1", geometry.sourcePoint.x / 100.);
-      propList.insert("svg:y1", geometry.sourcePoint.y / 100.);
-      propList.insert("svg:x2", geometry.targetPoint.x / 100.);
-      propList.insert("svg:y2", geometry.targetPoint.y / 100.);
+      list.insert("svg:x1", geometry.sourcePoint.x / 100.);
+      list.insert("svg:y1", geometry.sourcePoint.y / 100.);
+      list.insert("svg:x2", geometry.targetPoint.x / 100.);
+      list.insert("svg:y2", geometry.targetPoint.y / 100.);
       
-      propList.insert("svg:d", getPath());
+      list.insert("svg:d", getPath(list));
 
-      painter->drawConnector(propList);
+      list.append(DRAWIODisplayList::DRAW_CONNECTOR, list.closeProps());
     }
     else if (vertex) {
-      if (!parent_id.empty())
-      {
-        MXCell parent = id_map[parent_id];
-        geometry.x += parent.geometry.x;
-        geometry.y += parent.geometry.y;
-      }
-
-      double rx = geometry.width / 200.; double ry = geometry.height / 200.;
-      double cx = geometry.x / 100. + rx; double cy = geometry.y / 100. + ry;
-      PathContext c(*this);
-      double w = c.width; double h = c.height;
-      double angle = -style.rotation * boost::math::double_constants::pi / 180;
-      if (style.shape == RECTANGLE) {
-        propList.insert("svg:x", geometry.x / 100.);
-        propList.insert("svg:y", geometry.y / 100.);
-        propList.insert("svg:width", geometry.width / 100.);
-        propList.insert("svg:height", geometry.height / 100.);
-        double dx = sqrt(pow(rx, 2.) + pow(ry, 2.))*cos(atan(ry/rx)-angle) - rx;
-        double dy = sqrt(pow(rx, 2.) + pow(ry, 2.))*sin(atan(ry/rx)-angle) - ry;
-        librevenge::RVNGString sValue = "translate(";
-        sValue.append(std::to_string(-geometry.x / 100.).c_str());
-        sValue.append("in,");
-        sValue.append(std::to_string(-geometry.y / 100.).c_str());
-        sValue.append("in) rotate(");
-        sValue.append(std::to_string(angle).c_str());
-        sValue.append(") translate(");
-        sValue.append(std::to_string(cx - rx - dx).c_str());
-        sValue.append("in,");
-        sValue.append(std::to_string(cy - ry - dy).c_str());
-        sValue.append("in)");
-        propList.insert("draw:transform", sValue);
-        painter->drawRectangle(propList);
-      }
-      else if (style.shape == ELLIPSE) {
-        propList.insert("svg:rx", rx);
-        propList.insert("svg:ry", ry);
-        propList.insert("svg:cx", cx);
-        propList.insert("svg:cy", cy);
-        propList.insert("librevenge:rotate", -style.rotation);
-        painter->drawEllipse(propList);
-      }
-      else if (style.shape == TRIANGLE) {
-        c.addPoints({MXPoint(0,0), MXPoint(w,h/2), MXPoint(0,h)}, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == CALLOUT) {
-        double s = std::max(0., style.calloutLength/100);
-        double dx = w * std::max(0., std::min(1., style.calloutPosition));
-        double dx2 = w * std::max(0., std::min(1., style.calloutTipPosition));
-        double base = std::max(0., style.calloutWidth/100);
-        c.addPoints({
-          MXPoint(0, 0), MXPoint(w, 0), MXPoint(w, h-s), MXPoint(dx+base, h-s), 
-          MXPoint(dx2, h), MXPoint(dx, h-s), MXPoint(0, h-s)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == PROCESS) {
-        double inset = w * std::max(0., std::min(1., style.processBarSize));
-        c.moveTo(inset, 0);
-        c.lineTo(inset, h);
-        c.close();
-        c.moveTo(w-inset, 0);
-        c.lineTo(w-inset, h);
-        c.close();
-        c.addPoints({
-          MXPoint(0, 0), MXPoint(w, 0), MXPoint(w, h), MXPoint(0, h)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == RHOMBUS) {
-        c.addPoints({
-          MXPoint(w/2, 0), MXPoint(w, h/2), MXPoint(w/2, h), MXPoint(0, h/2)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == PARALLELOGRAM) {
-        double dx = style.parallelogramSize/100;
-        c.addPoints({
-          MXPoint(0, h), MXPoint(dx, 0), MXPoint(w, 0), MXPoint(w-dx, h)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == HEXAGON) {
-        double s = style.hexagonSize/100;
-        c.addPoints({
-          MXPoint(s, 0), MXPoint(w-s, 0), MXPoint(w, h/2), 
-          MXPoint(w-s, h), MXPoint(s, h), MXPoint(0, h/2)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == STEP) {
-        double s = style.stepSize/100;
-        c.addPoints({
-          MXPoint(0, 0), MXPoint(w-s, 0), MXPoint(w, h/2), 
-          MXPoint(w-s, h), MXPoint(0, h), MXPoint(s, h/2)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == TRAPEZOID) {
-        double dx = style.trapezoidSize/100;
-        c.addPoints({
-          MXPoint(0, h), MXPoint(dx, 0), MXPoint(w-dx, 0), MXPoint(w, h)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == CARD) {
-        double s = style.cardSize/100;
-        c.addPoints({
-          MXPoint(s, 0), MXPoint(w, 0), MXPoint(w, h), 
-          MXPoint(0, h), MXPoint(0, s)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == INTERNAL_STORAGE) {
-        double dx = style.storageX/100; double dy = style.storageY/100;
-        c.moveTo(0, dy);
-        c.lineTo(w, dy);
-        c.close();
-        c.moveTo(dx, 0);
-        c.lineTo(dx, h);
-        c.close();
-        c.addPoints({
-          MXPoint(0, 0), MXPoint(w, 0), MXPoint(w, h), MXPoint(0, h)
-        }, true);
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == OR) {
-        c.moveTo(0, 0);
-        c.quadTo(w, 0, w, h/2);
-        c.quadTo(w, h, 0, h);
-        c.close();
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == XOR) {
-        c.moveTo(0, 0);
-        c.quadTo(w, 0, w, h/2);
-        c.quadTo(w, h, 0, h);
-        c.quadTo(w/2, h/2, 0, 0);
-        c.close();
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == DOCUMENT) {
-        double dy = h * style.documentSize;
-        double fy = 1.4;
-        c.moveTo(0, 0);
-        c.lineTo(w, 0);
-        c.lineTo(w, h-dy/2);
-        c.quadTo(w*3/4, h-dy*fy, w/2, h-dy/2);
-        c.quadTo(w/4, h-dy*(1-fy), 0, h-dy/2);
-        c.close();
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == TAPE) {
-        double dy = h * style.tapeSize;
-        double fy = 1.4;
-        c.moveTo(0, dy/2);
-        c.quadTo(w/4, dy*fy, w/2, dy/2);
-        c.quadTo(w*3/4, dy*(1-fy), w, dy/2);
-        c.lineTo(w, h-dy/2);
-        c.quadTo(w*3/4, h-dy*fy, w/2, h-dy/2);
-        c.quadTo(w/4, h-dy*(1-fy), 0, h-dy/2);
-        c.close();
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
-      else if (style.shape == DATA_STORAGE) {
-        double s = style.dataStorageSize/100;
-        c.moveTo(s, 0);
-        c.lineTo(w, 0);
-        c.quadTo(w-2*s, h/2, w, h);
-        c.lineTo(s, h);
-        c.quadTo(s-2*s, h/2, s, 0);
-        c.close();
-        propList.insert("svg:d", c.path);
-        painter->drawPath(propList);
-      }
+      getShapeDescriptor(style.shape).draw(*this, frame, list, style_name);
     }
 
-    propList.clear();
-    propList.insert("librevenge:span-id", draw_count);
-    propList.insert("svg:x", (geometry.x + (int)style.position*geometry.width) / 100.);
-    propList.insert("svg:y", (geometry.y + (int)style.verticalPosition*geometry.height) / 100.);
-    propList.insert("svg:width", geometry.width / 100.);
-    propList.insert("svg:height", geometry.height / 100.);
-    librevenge::RVNGPropertyList textStyleProps = getTextStyle();
-    textStyleProps.insert("librevenge:span-id", draw_count);
-    propList.insert("fo:text-align", to_string(style.align).c_str());
-    propList.insert("draw:textarea-vertical-align", to_string(style.verticalAlign).c_str());
-    painter->setStyle(styleProps);
-    painter->startTextObject(propList);
+    // drop the shape properties if no shape was drawn
+    list.closeProps();
+    list.insert("librevenge:span-id", number);
+    list.insert("svg:x", frame.x + (int)style.position*frame.width);
+    list.insert("svg:y", frame.y + (int)style.verticalPosition*frame.height);
+    list.insert("svg:width", frame.width);
+    list.insert("svg:height", frame.height);
+    list.insert("fo:text-align", to_string(style.align).c_str());
+    list.insert("draw:textarea-vertical-align", to_string(style.verticalAlign).c_str());
+    DRAWIODisplayList::Props textProps = list.closeProps();
+    list.append(DRAWIODisplayList::SET_STYLE, styleProps);
+    list.append(DRAWIODisplayList::START_TEXT_OBJECT, textProps);
     if (!data.label.empty()) {
-      painter->defineCharacterStyle(textStyleProps);
-      painter->openParagraph(propList);
-      painter->openSpan(propList);
-      painter->insertText(processText(data.label));
-      painter->closeSpan();
-      painter->closeParagraph();
-    }
-    painter->endTextObject();
-    painter->closeGroup();
-    draw_count++;
+      insertTextStyle(list);
+      list.insert("librevenge:span-id", number);
+      list.append(DRAWIODisplayList::DEFINE_CHARACTER_STYLE, list.closeProps());
+      appendLabel(list, data.label.cstr(), data.label.size(), style.html, text_style,
+                  textProps);
+    }
+    list.append(DRAWIODisplayList::END_TEXT_OBJECT);
+    list.append(DRAWIODisplayList::CLOSE_GROUP);
+  }
+
+  void MXCell::renumber(DRAWIODisplayList &list, int from, int to) {
+    const std::string fromName = getStyleName(from), toName = getStyleName(to);
+    list.replace("style:display-name", fromName.c_str(), toName.c_str());
+    list.replace("draw:style-name", fromName.c_str(), toName.c_str());
+    list.replace("librevenge:span-id", from, to);
+  }
+
+  static void hashString(SHA256 &hash, const librevenge::RVNGString &str) {
+    hash.update(str.cstr(), str.size() + 1);
+  }
+
+  static void hashPoint(SHA256 &hash, const MXPoint &point) {
+    hash.update(&point.x, sizeof(point.x));
+    hash.update(&point.y, sizeof(point.y));
+  }
+
+  static void hashCount(SHA256 &hash, size_t count) {
+    const uint64_t value = count;
+    hash.update(&value, sizeof(value));
+  }
+
+  std::string MXCell::contentDigest() const {
+    SHA256 hash;
+    hashString(hash, id);
+    hashString(hash, data.label);
+    hashString(hash, data.id);
+    // counts keep lists of different lengths apart
+    hashCount(hash, data.data.size());
+    for (const auto &entry : data.data) {
+      hashString(hash, entry.first);
+      hashString(hash, entry.second);
+    }
+    hashString(hash, style_str);
+    hashString(hash, parent_id);
+    hashString(hash, source_id);
+    hashString(hash, target_id);
+    const unsigned char flags[] = {vertex, edge, connectable, visible, collapsed,
+                                   geometry.relative};
+    hash.update(flags, sizeof(flags));
+    const double extent[] = {geometry.x, geometry.y, geometry.width,
+                             geometry.height, geometry.offset};
+    hash.update(extent, sizeof(extent));
+    hashPoint(hash, geometry.sourcePoint);
+    hashPoint(hash, geometry.targetPoint);
+    hashCount(hash, geometry.points.size());
+    for (const auto &point : geometry.points)
+      hashPoint(hash, point);
+    return hash.hexDigest();
+  }
+
+  std::string MXCell::styleDigest() const {
+    SHA256 hash;
+    hashString(hash, style_str);
+    const unsigned char ends[] = {source_id.empty(), target_id.empty()};
+    hash.update(ends, sizeof(ends));
+    const double size[] = {geometry.width, geometry.height};
+    hash.update(size, sizeof(size));
+    return hash.hexDigest();
+  }
+
+  void MXCell::getMemoryUsage(DRAWIOCollector::Memory &memory) const {
+    long long cells = (long long)(sizeof(MXCell) - sizeof(DRAWIOStyle) - sizeof(DRAWIOTextStyle));
+    cells += DRAWIOCollector::getStringSize(id);
+    cells += DRAWIOCollector::getStringSize(data.label);
+    cells += DRAWIOCollector::getStringSize(data.id);
+    for (const auto &entry : data.data) {
+      // a tree node holds four pointers besides the entry
+      cells += (long long)(4 * sizeof(void *) + sizeof(entry));
+      cells += DRAWIOCollector::getStringSize(entry.first);
+      cells += DRAWIOCollector::getStringSize(entry.second);
+    }
+    cells += DRAWIOCollector::getStringSize(parent_id);
+    cells += DRAWIOCollector::getStringSize(source_id);
+    cells += DRAWIOCollector::getStringSize(target_id);
+    for (const auto *references : {&children, &edges}) {
+      cells += (long long)(references->capacity() * sizeof(librevenge::RVNGString));
+      for (const auto &reference : *references)
+        cells += DRAWIOCollector::getStringSize(reference);
+    }
+    memory.bytes[DRAWIOStatistics::MEMORY_CELLS] += cells;
+
+    memory.bytes[DRAWIOStatistics::MEMORY_STYLES] +=
+      (long long)(sizeof(DRAWIOStyle) + sizeof(DRAWIOTextStyle))
+      + DRAWIOCollector::getStringSize(style_str)
+      + DRAWIOCollector::getStringSize(text_style.fontFamily);
+
+    // a deque keeps its points in 512 byte blocks, with at least one block
+    // and a map of eight block pointers even when empty
+    const size_t perBlock = 512 / sizeof(MXPoint);
+    const size_t blocks = geometry.points.size() / perBlock + 1;
+    memory.bytes[DRAWIOStatistics::MEMORY_POINTS] +=
+      (long long)(blocks * 512 + std::max<size_t>(8, blocks + 2) * sizeof(void *));
   }
 
   void MXCell::calculateBounds() {
     if (vertex)
       bounds = {0, 0, 21600, 21600};
     else {
-      int x = (int)std::min(geometry.sourcePoint.x, geometry.targetPoint.x);
-      int y = (int)std::min(geometry.sourcePoint.y, geometry.targetPoint.y);
+      int x = toInt(std::min(geometry.sourcePoint.x, geometry.targetPoint.x));
+      int y = toInt(std::min(geometry.sourcePoint.y, geometry.targetPoint.y));
       int width =
-        std::abs((int)(geometry.sourcePoint.x - geometry.targetPoint.x));
+        toInt(std::abs(geometry.sourcePoint.x - geometry.targetPoint.x));
       int height =
-        std::abs((int)(geometry.sourcePoint.y - geometry.targetPoint.y));
+        toInt(std::abs(geometry.sourcePoint.y - geometry.targetPoint.y));
       bounds = {x, y, width, height};
     }
   }
@@ -392,61 +233,27 @@ namespace libdrawio {
     return out.str();
   }
 
-  librevenge::RVNGPropertyListVector MXCell::getPath() {
-    librevenge::RVNGPropertyListVector out;
-    librevenge::RVNGPropertyList i;
+  DRAWIODisplayList::Path MXCell::getPath(DRAWIODisplayList &list) {
     if (style.edgeStyle == STRAIGHT) {
-      i.insert("librevenge:path-action", "M");
-      i.insert("svg:x", geometry.sourcePoint.x / 100.);
-      i.insert("svg:y", geometry.sourcePoint.y / 100.);
-      out.append(i); i.clear();
+      list.pathStep('M', {MXPoint(geometry.sourcePoint.x / 100., geometry.sourcePoint.y / 100.)});
       for (unsigned int j = 0; j < geometry.points.size(); j++) {
         MXPoint p = geometry.points.at(j);
-        i.insert("librevenge:path-action", "L");
-        i.insert("svg:x", p.x / 100.);
-        i.insert("svg:y", p.y / 100.);
-        out.append(i); i.clear();
+        list.pathStep('L', {MXPoint(p.x / 100., p.y / 100.)});
       }
-      i.insert("librevenge:path-action", "L");
-      i.insert("svg:x", geometry.targetPoint.x / 100.);
-      i.insert("svg:y", geometry.targetPoint.y / 100.);
-      out.append(i);
+      list.pathStep('L', {MXPoint(geometry.targetPoint.x / 100., geometry.targetPoint.y / 100.)});
     }
     else if (style.edgeStyle == ORTHOGONAL) {
-      i.insert("librevenge:path-action", "M");
-      i.insert("svg:x", geometry.sourcePoint.x / 100.);
-      i.insert("svg:y", geometry.sourcePoint.y / 100.);
-      out.append(i); i.clear();
+      list.pathStep('M', {MXPoint(geometry.sourcePoint.x / 100., geometry.sourcePoint.y / 100.)});
       for (unsigned int j = 0; j < geometry.points.size(); j++) {
         MXPoint p = geometry.points.at(j);
-        i.insert("librevenge:path-action", "L");
-        i.insert("svg:x", p.x / 100.);
-        i.insert("svg:y", p.y / 100.);
-        out.append(i); i.clear();
+        list.pathStep('L', {MXPoint(p.x / 100., p.y / 100.)});
       }
-      i.insert("librevenge:path-action", "L");
-      i.insert("svg:x", geometry.targetPoint.x / 100.);
-      i.insert("svg:y", geometry.targetPoint.y / 100.);
-      out.append(i); i.clear();
+      list.pathStep('L', {MXPoint(geometry.targetPoint.x / 100., geometry.targetPoint.y / 100.)});
     }
-    return out;
-  }
-
-  librevenge::RVNGPropertyList MXCell::getPoint(
-    double x, double y, double cx, double cy, double angle
-  )
-  {
-    librevenge::RVNGPropertyList point;
-    double r = sqrt(pow(x - cx, 2) + pow(y - cy, 2));
-    double old_angle = x != cx ?
-      atan((y-cy) / (x-cx)) + (x > cx ? 0 : boost::math::double_constants::pi) :
-      (y <= cy ? -1 : 1) * boost::math::double_constants::pi / 2;
-    point.insert("svg:x", cx + r*cos(old_angle - angle));
-    point.insert("svg:y", cy + r*sin(old_angle - angle));
-    return point;
+    return list.closePath();
   }
 
-  void MXCell::setStyle() {
+  void MXCell::setStyle(DRAWIOImageCache &images) {
     std::string style_s = style_str.cstr();
     std::vector<std::string> tokens;
     boost::algorithm::split(tokens, style_s, boost::is_any_of(";"));
@@ -493,32 +300,39 @@ namespace libdrawio {
       else if (it->second == "south") style.portConstraint = SOUTH;
       else if (it->second == "west") style.portConstraint = WEST;
     }
-    it = style_m.find("ellipse"); if (it != style_m.end()) {
-      style.shape = ELLIPSE;
-      style.perimeter = ELLIPSE_P;
+    // a base style, as in "ellipse;whiteSpace=wrap", brings its perimeter
+    for (const auto &entry : style_m) {
+      const ShapeDescriptor *descriptor = entry.second.empty() ? findShapeDescriptor(entry.first) : nullptr;
+      if (descriptor && descriptor->baseStyle) {
+        style.shape = descriptor->shape;
+        style.perimeter = descriptor->perimeter;
+      }
     }
-    it = style_m.find("triangle"); if (it != style_m.end()) {
-      style.shape = TRIANGLE;
-      style.perimeter = TRIANGLE_P;
+    it = style_m.find("shape"); if (it != style_m.end()) {
+      const ShapeDescriptor *descriptor = findShapeDescriptor(it->second);
+      if (descriptor) style.shape = descriptor->shape;
+      else if (!it->second.compare(0, 8, "stencil(") && it->second.back() == ')') {
+        style.stencil = getStencil(it->second.substr(8, it->second.size() - 9));
+        if (style.stencil) style.shape = STENCIL;
+      }
+      else {
+        style.stencil = getBuiltinStencil(it->second);
+        if (style.stencil) style.shape = STENCIL;
+      }
     }
-    it = style_m.find("rhombus"); if (it != style_m.end()) {
-      style.shape = RHOMBUS;
-      style.perimeter = RHOMBUS_P;
+    it = style_m.find("image"); if (it != style_m.end())
+      style.image = images.get(it->second);
+    it = style_m.find("imageAspect"); if (it != style_m.end())
+      style.imageAspect = xmlStringToBool((xmlChar*)(it->second.c_str()));
+    it = style_m.find("imageAlign"); if (it != style_m.end()) {
+      if (it->second == "left") style.imageAlign = LEFT;
+      else if (it->second == "center") style.imageAlign = CENTER;
+      else if (it->second == "right") style.imageAlign = RIGHT;
     }
-    it = style_m.find("shape"); if (it != style_m.end()) {
-      if (it->second == "callout") style.shape = CALLOUT;
-      else if (it->second == "process") style.shape = PROCESS;
-      else if (it->second == "parallelogram") style.shape = PARALLELOGRAM;
-      else if (it->second == "hexagon") style.shape = HEXAGON;
-      else if (it->second == "step") style.shape = STEP;
-      else if (it->second == "trapezoid") style.shape = TRAPEZOID;
-      else if (it->second == "card") style.shape = CARD;
-      else if (it->second == "internalStorage") style.shape = INTERNAL_STORAGE;
-      else if (it->second == "or") style.shape = OR;
-      else if (it->second == "xor") style.shape = XOR;
-      else if (it->second == "document") style.shape = DOCUMENT;
-      else if (it->second == "tape") style.shape = TAPE;
-      else if (it->second == "dataStorage") style.shape = DATA_STORAGE;
+    it = style_m.find("imageVerticalAlign"); if (it != style_m.end()) {
+      if (it->second == "top") style.imageVerticalAlign = TOP;
+      else if (it->second == "middle") style.imageVerticalAlign = MIDDLE;
+      else if (it->second == "bottom") style.imageVerticalAlign = BOTTOM;
     }
     it = style_m.find("perimeter"); if (it != style_m.end()) {
       if (it->second == "rectanglePerimeter") style.perimeter = RECTANGLE_P;
@@ -540,39 +354,16 @@ namespace libdrawio {
     it = style_m.find("fixedSize"); if (it != style_m.end()) {
       std::istringstream(it->second) >> style.fixedSize;
     }
-    it = style_m.find("size"); if (it != style_m.end()) {
-      if (style.shape == CALLOUT) style.calloutLength = std::stod(it->second);
-      else if (style.shape == PROCESS) style.processBarSize = std::stod(it->second);
-      else if (style.shape == PARALLELOGRAM)
-        style.parallelogramSize = std::stod(it->second);
-      else if (style.shape == HEXAGON) style.hexagonSize = std::stod(it->second);
-      else if (style.shape == STEP) {
-        style.stepSize = std::stod(it->second);
-        if (!style.fixedSize)
-          style.stepSize *=
+    const ShapeDescriptor &descriptor = getShapeDescriptor(style.shape);
+    for (const auto &parameter : descriptor.parameters) {
+      if (!parameter.key) break;
+      it = style_m.find(parameter.key); if (it != style_m.end()) {
+        style.*parameter.field = std::stod(it->second);
+        if (parameter.relative && !style.fixedSize)
+          style.*parameter.field *=
             (style.direction == NORTH || style.direction == SOUTH
              ? geometry.height : geometry.width);
       }
-      else if (style.shape == TRAPEZOID) style.trapezoidSize = std::stod(it->second);
-      else if (style.shape == CARD) style.cardSize = std::stod(it->second);
-      else if (style.shape == DOCUMENT) style.documentSize = std::stod(it->second);
-      else if (style.shape == TAPE) style.tapeSize = std::stod(it->second);
-      else if (style.shape == DATA_STORAGE) style.dataStorageSize = std::stod(it->second);
-    }
-    it = style_m.find("base"); if (it != style_m.end()) {
-      if (style.shape == CALLOUT) style.calloutWidth = std::stod(it->second);
-    }
-    it = style_m.find("position"); if (it != style_m.end()) {
-      if (style.shape == CALLOUT) style.calloutPosition = std::stod(it->second);
-    }
-    it = style_m.find("position2"); if (it != style_m.end()) {
-      if (style.shape == CALLOUT) style.calloutTipPosition = std::stod(it->second);
-    }
-    it = style_m.find("dx"); if (it != style_m.end()) {
-      if (style.shape == INTERNAL_STORAGE) style.storageX = std::stod(it->second);
-    }
-    it = style_m.find("dy"); if (it != style_m.end()) {
-      if (style.shape == INTERNAL_STORAGE) style.storageY = std::stod(it->second);
     }
     it = style_m.find("fillColor"); if (it != style_m.end()) {
       if (it->second == "none") style.fillColor = boost::none;
@@ -605,15 +396,17 @@ namespace libdrawio {
     it = style_m.find("edgeStyle"); if (it != style_m.end()) {
       if (it->second == "orthogonalEdgeStyle") style.edgeStyle = ORTHOGONAL;
     }
+    it = style_m.find("html"); if (it != style_m.end())
+      style.html = xmlStringToBool((xmlChar*)(it->second.c_str()));
     it = style_m.find("fontFamily"); if (it != style_m.end())
       text_style.fontFamily = it->second.c_str();
     it = style_m.find("fontSize"); if (it != style_m.end())
       text_style.fontSize = xmlStringToDouble((xmlChar*)(it->second.c_str()));
     it = style_m.find("fontStyle"); if (it != style_m.end()) {
-      int style = xmlStringToDouble((xmlChar*)(it->second.c_str()));
-      text_style.bold = style & 1;
-      text_style.italic = style & 2;
-      text_style.underline = style & 4;
+      int fontStyle = toInt(xmlStringToDouble((xmlChar*)(it->second.c_str())));
+      text_style.bold = fontStyle & 1;
+      text_style.italic = fontStyle & 2;
+      text_style.underline = fontStyle & 4;
     }
     it = style_m.find("fontColor"); if (it != style_m.end()) {
       if (it->second == "none") text_style.fontColor = boost::none;
@@ -652,18 +445,18 @@ namespace libdrawio {
     }
   }
 
-  void MXCell::setEndPoints(std::map<librevenge::RVNGString, MXCell> id_map) {
+  void MXCell::setEndPoints(DRAWIOConnectionCache &connections) {
     // calculates endpoints for an edge
     // necessary because draw.io doesn't store endpoint coordinates
     // if the edge is attached to a vertex.
     if (!edge) return;
     if (!source_id.empty() && style.startFixed) {
-      MXCell source = id_map[source_id];
+      const DRAWIOConnection &source = connections.get(source_id);
       setEndpointInShape(style.exitX.get(), style.exitY.get(), source,
                          geometry.sourcePoint, style.exitDx, style.exitDy);
     }
     if (!target_id.empty() && style.endFixed) {
-      MXCell target = id_map[target_id];
+      const DRAWIOConnection &target = connections.get(target_id);
       setEndpointInShape(style.entryX.get(), style.entryY.get(), target,
                          geometry.targetPoint, style.entryDx, style.entryDy);
     }
@@ -673,82 +466,55 @@ namespace libdrawio {
       if (style.startFixed) {
         startX = geometry.sourcePoint.x; startY = geometry.sourcePoint.y;
       } else {
-        MXCell source = id_map[source_id];
-        startX = source.geometry.x + source.geometry.width / 2;
-        startY = source.geometry.y + source.geometry.height / 2;
+        const DRAWIOConnection &source = connections.get(source_id);
+        startX = source.cx; startY = source.cy;
       }
       if (style.endFixed) {
         endX = geometry.targetPoint.x; endY = geometry.targetPoint.y;
       } else {
-        MXCell target = id_map[target_id];
-        endX = target.geometry.x + target.geometry.width / 2;
-        endY = target.geometry.y + target.geometry.height / 2;
+        const DRAWIOConnection &target = connections.get(target_id);
+        endX = target.cx; endY = target.cy;
       }
       if (!style.startFixed) {
-        MXCell source = id_map[source_id];
+        const DRAWIOConnection &source = connections.get(source_id);
         double inX, inY;
         if (geometry.points.empty()) {
           inX = endX; inY = endY;
         } else {
           inX = geometry.points[0].x; inY = geometry.points[0].y;
         }
-        double angle = std::atan2(inY - startY, inX - startX);
-        double facing_angle =
-          boost::math::double_constants::pi * ((int)source.style.direction - 1) / 2;
-        angle -= facing_angle;
-        angle -= source.style.rotation * boost::math::double_constants::pi / 180;
-        double m = std::tan(angle);
-        double outX, outY;
-        if (std::abs(m) > 1) {
-          outY = inY < startY ? 0  : 1;
-          outX = 0.5 + (inY < startY ? -0.5 : 0.5) / m;
-        } else {
-          outX = inX < startX ? 0 : 1;
-          outY = 0.5 + m * (inX < startX ? -0.5 : 0.5);
-        }
-        setEndpointInShape(outX, outY, source, geometry.sourcePoint);
+        MXPoint out = getBoxExit(inX - startX, inY - startY,
+                                 source.facingTurn);
+        setEndpointInShape(out.x, out.y, source, geometry.sourcePoint);
       }
       if (!style.endFixed) {
-        MXCell target = id_map[target_id];
+        const DRAWIOConnection &target = connections.get(target_id);
         double inX, inY;
         if (geometry.points.empty()) {
           inX = startX; inY = startY;
         } else {
           inX = geometry.points.back().x; inY = geometry.points.back().y;
         }
-        double angle = std::atan2(endY - inY, endX - inX);
-        double facing_angle =
-          boost::math::double_constants::pi * ((int)target.style.direction - 1) / 2;
-        angle += boost::math::double_constants::pi;
-        angle -= facing_angle;
-        angle -= target.style.rotation * boost::math::double_constants::pi / 180;
-        double m = std::tan(angle);
-        double outX, outY;
-        if (std::abs(m) > 1) {
-          outY = endY < inY ? 1  : 0;
-          outX = 0.5 + (endY < inY ? 0.5 : -0.5) / m;
-        } else {
-          outX = endX < inX ? 1 : 0;
-          outY = 0.5 + m * (endX < inX ? 0.5 : -0.5);
-        }
-        setEndpointInShape(outX, outY, target, geometry.targetPoint);
+        MXPoint out = getBoxExit(inX - endX, inY - endY,
+                                 target.facingTurn);
+        setEndpointInShape(out.x, out.y, target, geometry.targetPoint);
       }
     }
     else if (style.edgeStyle == ORTHOGONAL) {
       bool source_shape = !source_id.empty(); bool target_shape = !target_id.empty();
       double startX, startY, startWidth, startHeight, endX, endY, endWidth, endHeight;
       if (source_shape) {
-        MXCell source = id_map[source_id];
-        startX = source.geometry.x; startY = source.geometry.y;
-        startWidth = source.geometry.width; startHeight = source.geometry.height;
+        const DRAWIOConnection &source = connections.get(source_id);
+        startX = source.x; startY = source.y;
+        startWidth = source.width; startHeight = source.height;
       } else {
         startX = geometry.sourcePoint.x; startY = geometry.sourcePoint.y;
         startWidth = 0; startHeight = 0;
       }
       if (target_shape) {
-        MXCell target = id_map[target_id];
-        endX = target.geometry.x; endY = target.geometry.y;
-        endWidth = target.geometry.width; endHeight = target.geometry.height;
+        const DRAWIOConnection &target = connections.get(target_id);
+        endX = target.x; endY = target.y;
+        endWidth = target.width; endHeight = target.height;
       } else {
         endX = geometry.targetPoint.x; endY = geometry.targetPoint.y;
         endWidth = 0; endHeight = 0;
@@ -825,24 +591,10 @@ namespace libdrawio {
         }
       }
       if (!style.startFixed) {
-        MXCell source = id_map[source_id];
-        double angle =
-          boost::math::double_constants::pi * ((int)style.startDir.get() - 1) / 2;
-        double facing_angle =
-          boost::math::double_constants::pi * ((int)source.style.direction - 1) / 2;
-        angle -= facing_angle;
-        angle -= source.style.rotation * boost::math::double_constants::pi / 180;
-        double m = std::tan(angle);
-        double outX, outY;
-        if (std::abs(m) > 1) {
-          outY = style.startDir == NORTH ? 0 : 1;
-          outX = 0.5 + (style.startDir == NORTH ? -0.5 : 0.5) / m;
-        } else {
-          outX = style.startDir == WEST ? 0 : 1;
-          outY = 0.5 + m * (style.startDir == WEST ? -0.5 : 0.5);
-        }
-        setEndpointInShape(outX, outY, source, geometry.sourcePoint);
-        if (source.style.rotation == 0 && !geometry.points.empty()) {
+        const DRAWIOConnection &source = connections.get(source_id);
+        MXPoint out = getBoxExit(style.startDir.get(), source.facingTurn);
+        setEndpointInShape(out.x, out.y, source, geometry.sourcePoint);
+        if (source.rotation == 0 && !geometry.points.empty()) {
           MXPoint p = geometry.points.front();
           if (style.startDir == NORTH || style.startDir == SOUTH) {
             geometry.sourcePoint.x = p.x;
@@ -851,14 +603,14 @@ namespace libdrawio {
           }
         }
       } else if (!source_id.empty()) {
-        MXCell source = id_map[source_id];
-        if (std::fmod(source.style.rotation, 90) == 0) {
-          double rx = source.geometry.width / 2;
-          double ry = source.geometry.height / 2;
-          double cx = source.geometry.x + rx;
-          double cy = source.geometry.y + ry;
+        const DRAWIOConnection &source = connections.get(source_id);
+        if (std::fmod(source.rotation, 90) == 0) {
+          double rx = source.width / 2;
+          double ry = source.height / 2;
+          double cx = source.cx;
+          double cy = source.cy;
           MXPoint p = geometry.sourcePoint;
-          if (std::fmod(std::floor(source.style.rotation / 90), 2) == 1) {
+          if (std::fmod(std::floor(source.rotation / 90), 2) == 1) {
             double t = rx; rx = ry; ry = t;
           }
           if (p.y == cy + ry) {
@@ -873,24 +625,10 @@ namespace libdrawio {
         }
       }
       if (!style.endFixed) {
-        MXCell target = id_map[target_id];
-        double angle =
-          boost::math::double_constants::pi * ((int)style.endDir.get() - 1) / 2;
-        double facing_angle =
-          boost::math::double_constants::pi * ((int)target.style.direction - 1) / 2;
-        angle -= facing_angle;
-        angle -= target.style.rotation * boost::math::double_constants::pi / 180;
-        double m = std::tan(angle);
-        double outX, outY;
-        if (std::abs(m) > 1) {
-          outY = style.endDir == NORTH ? 0 : 1;
-          outX = 0.5 + (style.endDir == NORTH ? -0.5 : 0.5) / m;
-        } else {
-          outX = style.endDir == WEST ? 0 : 1;
-          outY = 0.5 + m * (style.endDir == WEST ? -0.5 : 0.5);
-        }
-        setEndpointInShape(outX, outY, target, geometry.targetPoint);
-        if (target.style.rotation == 0 && !geometry.points.empty()) {
+        const DRAWIOConnection &target = connections.get(target_id);
+        MXPoint out = getBoxExit(style.endDir.get(), target.facingTurn);
+        setEndpointInShape(out.x, out.y, target, geometry.targetPoint);
+        if (target.rotation == 0 && !geometry.points.empty()) {
           MXPoint p = geometry.points.back();
           if (style.endDir == NORTH || style.endDir == SOUTH) {
             geometry.targetPoint.x = p.x;
@@ -899,14 +637,14 @@ namespace libdrawio {
           }
         }
       } else if (!target_id.empty()) {
-        MXCell target = id_map[target_id];
-        if (std::fmod(target.style.rotation, 90) == 0) {
-          double rx = target.geometry.width / 2;
-          double ry = target.geometry.height / 2;
-          double cx = target.geometry.x + rx;
-          double cy = target.geometry.y + ry;
+        const DRAWIOConnection &target = connections.get(target_id);
+        if (std::fmod(target.rotation, 90) == 0) {
+          double rx = target.width / 2;
+          double ry = target.height / 2;
+          double cx = target.cx;
+          double cy = target.cy;
           MXPoint p = geometry.targetPoint;
-          if (std::fmod(std::floor(target.style.rotation / 90), 2) == 1) {
+          if (std::fmod(std::floor(target.rotation / 90), 2) == 1) {
             double t = rx; rx = ry; ry = t;
           }
           if (p.y == cy + ry) {
@@ -921,219 +659,83 @@ namespace libdrawio {
         }
       }
     }
-
-    if (!source_id.empty() && !id_map[source_id].parent_id.empty()) {
-      MXCell parent = id_map[id_map[source_id].parent_id];
-      geometry.sourcePoint.x += parent.geometry.x;
-      geometry.sourcePoint.y += parent.geometry.y;
-    }
-    if (!target_id.empty() && !id_map[target_id].parent_id.empty()) {
-      MXCell parent = id_map[id_map[target_id].parent_id];
-      geometry.targetPoint.x += parent.geometry.x;
-      geometry.targetPoint.y += parent.geometry.y;
-    }
   }
 
-  void MXCell::setEndpointInShape(double outX, double outY, const MXCell& shape,
+  void MXCell::setEndpointInShape(double outX, double outY, const DRAWIOConnection& shape,
                                   MXPoint& point, double dx, double dy)
   {
     bool perimeter = outX == 0 || outX == 1 || outY == 0 || outY == 1;
-    switch (shape.style.direction) {
+    switch (shape.direction) {
     case EAST:
     case WEST:
-      outX += dx / shape.geometry.width; outY += dy / shape.geometry.height;
+      outX += dx / shape.width; outY += dy / shape.height;
       break;
     case NORTH:
     case SOUTH:
-      outX += dx / shape.geometry.height; outY += dy / shape.geometry.width;
+      outX += dx / shape.height; outY += dy / shape.width;
       break;
     }
     if (perimeter) adjustEndpoint(outX, outY, shape);
     double x, y;
-    switch (shape.style.direction) {
+    switch (shape.direction) {
     case EAST:
-      x = (shape.geometry.x
-           + (outX * shape.geometry.width));
-      y = (shape.geometry.y
-           + (outY * shape.geometry.height));
+      x = (shape.x
+           + (outX * shape.width));
+      y = (shape.y
+           + (outY * shape.height));
       break;
     case WEST:
-      x = (shape.geometry.x
-           + ((1 - outX) * shape.geometry.width));
-      y = (shape.geometry.y
-           + ((1 - outY) * shape.geometry.height));
+      x = (shape.x
+           + ((1 - outX) * shape.width));
+      y = (shape.y
+           + ((1 - outY) * shape.height));
       break;
     case NORTH:
-      x = (shape.geometry.x
-           + (outY * shape.geometry.width));
-      y = (shape.geometry.y
-           + ((1 - outX) * shape.geometry.height));
+      x = (shape.x
+           + (outY * shape.width));
+      y = (shape.y
+           + ((1 - outX) * shape.height));
       break;
     case SOUTH:
-      x = (shape.geometry.x
-           + ((1 - outY) * shape.geometry.width));
-      y = (shape.geometry.y
-           + (outX * shape.geometry.height));
+      x = (shape.x
+           + ((1 - outY) * shape.width));
+      y = (shape.y
+           + (outX * shape.height));
       break;
     }
-    double cx = shape.geometry.x + shape.geometry.width / 2;
-    double cy = shape.geometry.y + shape.geometry.height / 2;
-    double angle = -shape.style.rotation * boost::math::double_constants::pi / 180;
-    librevenge::RVNGPropertyList p = getPoint(x, y, cx, cy, angle);
-    point.x = p["svg:x"]->getDouble();
-    point.y = p["svg:y"]->getDouble();
+    const ShapeTurn &turn = shape.rotationTurn;
+    point.x = shape.cx + (x - shape.cx) * turn.cosine - (y - shape.cy) * turn.sine;
+    point.y = shape.cy + (x - shape.cx) * turn.sine + (y - shape.cy) * turn.cosine;
   }
 
-  void MXCell::adjustEndpoint(double& outX, double& outY, const MXCell& shape)
+  void MXCell::adjustEndpoint(double& outX, double& outY, const DRAWIOConnection& shape)
   {
-    double x = outX; double y = outY;
-    if (0 < x && x < 1 && 0 < y && y < 1) {
+    if (0 < outX && outX < 1 && 0 < outY && outY < 1) {
       outX = 0.5; outY = 0.5;
-    } else if (shape.style.perimeter == TRIANGLE_P) {
-      // update exitX, exitY to connect with diagonal edges of triangle
-      if (y < 0.5 && x > 0) {
-        double m = (x - 0.5) / (y - 0.5);
-        outY = (0.5 - m/2) / (2 - m);
-        outX = 2 * outY;
-      } else if (y > 0.5 && x > 0) {
-        double m = (x - 0.5) / (y - 0.5);
-        outY = (1.5 + m/2) / (2 + m);
-        outX = 2 - 2 * outY;
-      }
-    } else if (shape.style.perimeter == ELLIPSE_P) {
-      if (x != 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        double t = atan(m) + (x < 0.5 ? boost::math::double_constants::pi : 0);
-        outX = 0.5 + 0.5*cos(t);
-        outY = 0.5 + 0.5*sin(t);
-      }
-    } else if (shape.style.perimeter == RHOMBUS_P) {
-      if (x < 0.5 && y < 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        outX = m / (2 + 2*m);
-        outY = -outX + 0.5;
-      } else if (x < 0.5 && y > 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        outX = m / (2*m - 2);
-        outY = outX + 0.5;
-      } else if (x > 0.5 && y < 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        outX = (m - 2) / (2*m - 2);
-        outY = outX - 0.5;
-      } else if (x > 0.5 && y > 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        outX = (m + 2) / (2*m + 2);
-        outY = -outX + 1.5;
-      }
-    } else if (shape.style.perimeter == PARALLELOGRAM_P) {
-      double c =
-        (shape.style.parallelogramSize
-         / (shape.style.direction == NORTH || shape.style.direction == SOUTH
-            ? shape.geometry.height : shape.geometry.width));
-      c = std::min(c, 0.5);
-      if (c != 0 && x != 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        if (x < c && y < 1) {
-          outX = (m*c + c) / (2*m*c + 2);
-          outY = 1 - outX/c;
-        } else if (x > 1 - c && y > 0) {
-          outX = (m*c - c + 2) / (2*m*c + 2);
-          outY = (1 - outX) / c;
-        }
-      }
-    } else if (shape.style.perimeter == HEXAGON_P) {
-      double c =
-        (shape.style.hexagonSize
-         / (shape.style.direction == NORTH || shape.style.direction == SOUTH
-            ? shape.geometry.height : shape.geometry.width));
-      c = std::min(c, 0.5);
-      if (c != 0 && x != 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        if (x < c && y < 0.5) {
-          outX = c * m / (2*c*m + 1);
-          outY = -outX/(2*c) + 0.5;
-        } else if (x > 1 - c && y < 0.5) {
-          outX = (m*c - 1) / (2*m*c - 1);
-          outY = (outX + c - 1) / (2*c);
-        } else if (x < c && y > 0.5) {
-          outX = m*c / (2*m*c - 1);
-          outY = outX/(2*c) + 0.5;
-        } else if (x > 1 - c && y > 0.5) {
-          outX = (m*c + 1) / (2*m*c + 1);
-          outY = (1 + c - outX) / (2*c);
-        }
-      }
-    } else if (shape.style.perimeter == STEP_P) {
-      double c =
-        (shape.style.stepSize
-         / (shape.style.direction == NORTH || shape.style.direction == SOUTH
-            ? shape.geometry.height : shape.geometry.width));
-      if (x == 0 && c > 0.5 && 0 < y && y < 1) {
-        outX = 0.5; outY = 0.5;
-      } else if (y == 0.5) {
-        outX = x == 0 ? c : 1;
-      } else {
-        double m = (x - 0.5) / (y - 0.5);
-        if (x == 0 && y < 0.5) {
-          outY = (1 - m) / (4*c - 2*m);
-          outX = 2*c*outY;
-        } else if (x == 0 && y > 0.5) {
-          outY = (4*c - 1 + m) / (4*c + 2*m);
-          outX = 2*c - 2*c*outY;
-        } else if (x > 1 - c && y < 0.5) {
-          outY = (1 - 2*c + m) / (2*m - 4*c);
-          outX = 2*c*outY + 1 - c;
-        } else if (x > 1 - c && y > 0.5) {
-          outY = (1 + 2*c + m) / (4*c + 2*m);
-          outX = 1 + c - 2*c*outY;
-        }
-      }
-    } else if (shape.style.perimeter == TRAPEZOID_P) {
-      double c =
-        (shape.style.trapezoidSize
-         / (shape.style.direction == NORTH || shape.style.direction == SOUTH
-            ? shape.geometry.height : shape.geometry.width));
-      c = std::min(c, 0.5);
-      if (c != 0 && x != 0.5) {
-        double m = (y - 0.5) / (x - 0.5);
-        if (x < c && y < 1) {
-          outX = (c + m*c) / (2*m*c + 2);
-          outY = 1 - outX/c;
-        } else if (x > 1 - c && y < 1) {
-          outX = (c + m*c - 2) / (2*m*c - 2);
-          outY = (outX + c - 1) / c;
-        }
-      }
+    } else {
+      MXPoint point = projectOnPerimeter(shape.perimeter, MXPoint(outX, outY));
+      outX = point.x; outY = point.y;
     }
   }
 
-  void MXCell::setWaypoints(std::map<librevenge::RVNGString, MXCell> id_map)
+  void MXCell::setWaypoints(DRAWIOConnectionCache &connections)
   {
     if (!edge) return;
     if (style.edgeStyle == ORTHOGONAL && geometry.points.empty()) {
       double sourceX, sourceY, sourceWidth, sourceHeight;
       double targetX, targetY, targetWidth, targetHeight;
       if (!source_id.empty()) {
-        MXCell source = id_map[source_id];
-        sourceX = source.geometry.x; sourceY = source.geometry.y;
-        if (!source.parent_id.empty()) {
-          MXCell parent = id_map[source.parent_id];
-          sourceX += parent.geometry.x; sourceY += parent.geometry.y;
-        }
-        sourceWidth = source.geometry.width; sourceHeight = source.geometry.height;
+        const DRAWIOConnection &source = connections.get(source_id);
+        sourceX = source.x; sourceY = source.y;
+        sourceWidth = source.width; sourceHeight = source.height;
       } else {
         sourceX = geometry.sourcePoint.x; sourceY = geometry.sourcePoint.y;
         sourceWidth = 0; sourceHeight = 0;
       }
       if (!target_id.empty()) {
-        MXCell target = id_map[target_id];
-        targetX = target.geometry.x; targetY = target.geometry.y;
-        if (!target.parent_id.empty()) {
-          MXCell parent = id_map[target.parent_id];
-          sourceX += parent.geometry.x;
-          sourceY += parent.geometry.y;
-        }
-        targetWidth = target.geometry.width; targetHeight = target.geometry.height;
+        const DRAWIOConnection &target = connections.get(target_id);
+        targetX = target.x; targetY = target.y;
+        targetWidth = target.width; targetHeight = target.height;
       } else {
         targetX = geometry.targetPoint.x; targetY = geometry.targetPoint.y;
         targetWidth = 0; targetHeight = 0;
@@ -1154,9 +756,14 @@ namespace libdrawio {
       }
       bool start = true;
       bool hugSource = true;
+      unsigned steps = 0;
       while (p_dir != opposite(q_dir) || !pointsTo(p, q, p_dir)
              || (p.x != q.x && vertical(p_dir))
              || (p.y != q.y && horizontal(p_dir))) {
+        if (++steps > MAX_ROUTE_STEPS) {
+          geometry.points.clear();
+          break;
+        }
         double& change = (vertical(p_dir) ? p.y : p.x);
         double x = hugSource ? sourceX : targetX;
         double y = hugSource ? sourceY : targetY;
@@ -1401,6 +1008,8 @@ namespace libdrawio {
         geometry.points.push_back(p);
         start = false;
       }
+      if (DRAWIOCollector *collector = DRAWIOCollector::get())
+        collector->statistics().routingIterations += steps;
     }
   }
 
@@ -1418,18 +1027,6 @@ namespace libdrawio {
     }
   }
 
-  librevenge::RVNGString MXCell::processText(librevenge::RVNGString input) {
-    librevenge::RVNGString out;
-    bool skipping = false;
-    for (unsigned long i = 0; i < input.size(); i++) {
-      char c = input.cstr()[i];
-      if (c == '<') skipping = true;
-      if (!skipping) out.append(c);
-      if (c == '>') skipping = false;
-    }
-    return out;
-  }
-
   std::string MXCell::getMarkerViewBox(MarkerType marker) {
     switch (marker) {
     case CLASSIC:
@@ -1444,57 +1041,40 @@ namespace libdrawio {
     }
   }
 
-  librevenge::RVNGPropertyList MXCell::getStyle() {
-    librevenge::RVNGPropertyList styleProps;
-    if (!style.fillColor.has_value()) styleProps.insert("draw:fill", "none");
+  void MXCell::insertStyle(DRAWIODisplayList &list) {
+    if (!style.fillColor.has_value()) list.insert("draw:fill", "none");
     else {
-      styleProps.insert("draw:fill", "solid");
-      styleProps.insert("draw:fill-color", style.fillColor->to_string().c_str());
+      list.insert("draw:fill", "solid");
+      list.insert("draw:fill-color", style.fillColor->to_string().c_str());
     }
-    if (!style.strokeColor.has_value()) styleProps.insert("draw:stroke", "none");
+    if (!style.strokeColor.has_value()) list.insert("draw:stroke", "none");
     else {
-      styleProps.insert("draw:stroke", "solid");
-      styleProps.insert("svg:stroke-color", style.strokeColor->to_string().c_str());
+      list.insert("draw:stroke", "solid");
+      list.insert("svg:stroke-color", style.strokeColor->to_string().c_str());
       if (edge && (style.endFill || style.startFill)) {
-        styleProps.remove("draw:fill"); styleProps.remove("draw:fill-color");
-        styleProps.insert("draw:fill", "solid");
-        styleProps.insert("draw:fill-color", styleProps["svg:stroke-color"]->getStr());
+        // later properties override earlier ones when replayed
+        list.insert("draw:fill", "solid");
+        list.insert("draw:fill-color", style.strokeColor->to_string().c_str());
       }
     }
     if (style.startArrow.has_value() && edge) {
-      styleProps.insert("draw:marker-start-viewbox",
-                        getMarkerViewBox(style.startArrow.get()).c_str());
-      styleProps.insert("draw:marker-start-path",
-                        getMarkerPath(style.startArrow.get()).c_str());
-      styleProps.insert("draw:marker-start-width", style.startSize / 100.);
+      list.insert("draw:marker-start-viewbox",
+                  getMarkerViewBox(style.startArrow.get()).c_str());
+      list.insert("draw:marker-start-path",
+                  getMarkerPath(style.startArrow.get()).c_str());
+      list.insert("draw:marker-start-width", style.startSize / 100.);
     }
     if (style.endArrow.has_value() && edge) {
-      styleProps.insert("draw:marker-end-viewbox",
-                        getMarkerViewBox(style.endArrow.get()).c_str());
-      styleProps.insert("draw:marker-end-path",
-                        getMarkerPath(style.endArrow.get()).c_str());
-      styleProps.insert("draw:marker-end-width", style.endSize / 100.);
+      list.insert("draw:marker-end-viewbox",
+                  getMarkerViewBox(style.endArrow.get()).c_str());
+      list.insert("draw:marker-end-path",
+                  getMarkerPath(style.endArrow.get()).c_str());
+      list.insert("draw:marker-end-width", style.endSize / 100.);
     }
-
-    return styleProps;
   }
 
-  librevenge::RVNGPropertyList MXCell::getTextStyle() {
-    librevenge::RVNGPropertyList styleProps;
-
-    styleProps.insert("style:font-name", text_style.fontFamily);
-    styleProps.insert("fo:font-size", text_style.fontSize * 0.75, librevenge::RVNG_POINT);
-    if (text_style.fontColor.has_value()) {
-      styleProps.insert("fo:color", text_style.fontColor->to_string().c_str());
-    }
-    if (text_style.backgroundColor.has_value()) {
-      styleProps.insert("fo:background-color", text_style.backgroundColor->to_string().c_str());
-    }
-    styleProps.insert("fo:font-weight", text_style.bold ? "bold" : "normal");
-    styleProps.insert("fo:font-style", text_style.italic ? "italic" : "normal");
-    styleProps.insert("style:text-underline-style", text_style.underline ? "solid" : "none");
-
-    return styleProps;
+  void MXCell::insertTextStyle(DRAWIODisplayList &list) {
+    libdrawio::insertTextStyle(list, text_style);
   }
 } // namespace libdrawio
 
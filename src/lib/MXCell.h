@@ -3,6 +3,9 @@
 #ifndef MXCELL_H
 #define MXCELL_H
 
+#include "DRAWIOCollector.h"
+#include "DRAWIODisplayList.h"
+#include "DRAWIOGeometryStore.h"
 #include "DRAWIOStyle.h"
 #include "DRAWIOTypes.h"
 #include "MXGeometry.h"
@@ -10,17 +13,21 @@
 #include "librevenge/RVNGPropertyList.h"
 #include "librevenge/RVNGString.h"
 #include "librevenge/librevenge.h"
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
 
 namespace libdrawio {
+  class DRAWIOConnectionCache;
+  struct DRAWIOConnection;
+
   struct MXCell {
     librevenge::RVNGString id;
     DRAWIOUserObject data;
     MXGeometry geometry;
     librevenge::RVNGString style_str;
-    void setStyle();
+    void setStyle(DRAWIOImageCache &images);
     DRAWIOStyle style;
     DRAWIOTextStyle text_style;
     bool vertex, edge, connectable, visible, collapsed;
@@ -33,11 +40,28 @@ namespace libdrawio {
         edges() {}
     MXCell(const MXCell &mxcell) = default;
     MXCell &operator=(const MXCell &mxcell) = default;
-    void draw(librevenge::RVNGDrawingInterface *painter,
-              std::map<librevenge::RVNGString, MXCell> id_map);
-    void setEndPoints(std::map<librevenge::RVNGString, MXCell> id_map);
-    librevenge::RVNGPropertyList getStyle();
-    librevenge::RVNGPropertyList getTextStyle();
+    /* frame is where the cell is drawn, from the geometry store of its
+     * page; number is its position in the document, which names its
+     * styles, so that the same document always gives the same names.
+     */
+    void draw(DRAWIODisplayList &list, const ShapeFrame &frame,
+              DRAWIOConnectionCache &connections, int number);
+    // renames the styles and spans of a list drawn for the cell numbered
+    // from to those of the cell numbered to, so that a kept layout can move
+    // within the document
+    static void renumber(DRAWIODisplayList &list, int from, int to);
+    void setEndPoints(DRAWIOConnectionCache &connections);
+    void setWaypoints(DRAWIOConnectionCache &connections);
+    void insertStyle(DRAWIODisplayList &list);
+    void insertTextStyle(DRAWIODisplayList &list);
+    // SHA-256 of the attributes read from the file, to spot changed cells;
+    // equal digests may be taken for equal cells
+    std::string contentDigest() const;
+    // SHA-256 of what setStyle reads: the style string, whether the ends
+    // are attached and the size that relative parameters scale with
+    std::string styleDigest() const;
+    // adds the estimated memory held by the cell
+    void getMemoryUsage(DRAWIOCollector::Memory &memory) const;
   private:
     struct Bounds {
       int x, y;
@@ -46,19 +70,13 @@ namespace libdrawio {
     void calculateBounds();
     Bounds bounds;
     std::string getViewBox();
-    librevenge::RVNGPropertyListVector getPath();
-    librevenge::RVNGString processText(librevenge::RVNGString input);
+    DRAWIODisplayList::Path getPath(DRAWIODisplayList &list);
     std::string getMarkerViewBox(MarkerType marker);
     std::string getMarkerPath(MarkerType marker);
-    librevenge::RVNGPropertyList getPoint(
-      double x, double y, double cx, double cy, double angle
-    );
-    void adjustEndpoint(double& outX, double& outY, const MXCell& shape);
-    void setEndpointInShape(double x, double y, const MXCell& shape, MXPoint& point,
+    void adjustEndpoint(double& outX, double& outY, const DRAWIOConnection& shape);
+    void setEndpointInShape(double x, double y, const DRAWIOConnection& shape, MXPoint& point,
                             double dx = 0, double dy = 0);
-    void setWaypoints(std::map<librevenge::RVNGString, MXCell> id_map);
     bool pointsTo(MXPoint p, MXPoint q, Direction dir);
-    static int draw_count;
   };
 }
 
@@ -3,6 +3,7 @@
 #ifndef MXGEOMETRY_H
 #define MXGEOMETRY_H
 
+#include "DRAWIOTypes.h"
 #include <deque>
 #include <cmath>
 
@@ -9,6 +9,9 @@
 
 #include "libdrawio_utils.h"
 
+#include <algorithm>
+#include <cstring>
+
 #ifdef DEBUG
 #include <cstdarg>
 #include <cstdio>
@@ -252,6 +255,17 @@ EndOfStreamException::EndOfStreamException()
   DRAWIO_DEBUG_MSG(("Throwing EndOfStreamException\n"));
 }
 
+LimitExceeded::LimitExceeded(const Limit limit)
+  : m_limit(limit)
+{
+  DRAWIO_DEBUG_MSG(("Throwing LimitExceeded %d\n", int(limit)));
+}
+
+LimitExceeded::Limit LimitExceeded::getLimit() const
+{
+  return m_limit;
+}
+
 void appendUCS4(librevenge::RVNGString &text, UChar32 ucs4Character)
 {
   // Convert carriage returns to new line characters
@@ -266,6 +280,235 @@ void appendUCS4(librevenge::RVNGString &text, UChar32 ucs4Character)
   text.append((char *)outbuf);
 }
 
+namespace
+{
+
+bool isContinuation(const unsigned char c)
+{
+  return (c & 0xc0) == 0x80;
+}
+
+// length of the valid UTF-8 sequence starting str, or 0
+unsigned getSequenceLength(const unsigned char *const str, const unsigned long size)
+{
+  const unsigned char c = str[0];
+  if (c < 0x80)
+    return 1;
+  if (c < 0xc2)
+    return 0;
+  if (c < 0xe0)
+    return size >= 2 && isContinuation(str[1]) ? 2 : 0;
+  if (c < 0xf0)
+  {
+    if (size < 3 || !isContinuation(str[1]) || !isContinuation(str[2]))
+      return 0;
+    // overlong forms and surrogates
+    if ((c == 0xe0 && str[1] < 0xa0) || (c == 0xed && str[1] >= 0xa0))
+      return 0;
+    return 3;
+  }
+  if (c < 0xf5)
+  {
+    if (size < 4 || !isContinuation(str[1]) || !isContinuation(str[2]) || !isContinuation(str[3]))
+      return 0;
+    // overlong forms and code points above U+10FFFF
+    if ((c == 0xf0 && str[1] < 0x90) || (c == 0xf4 && str[1] >= 0x90))
+      return 0;
+    return 4;
+  }
+  return 0;
+}
+
+}
+
+bool isValidUTF8(const char *const str, const unsigned long size)
+{
+  const unsigned char *const bytes = reinterpret_cast<const unsigned char *>(str);
+  unsigned long i = 0;
+  while (i < size)
+  {
+    // ASCII, which is nearly all of ids and styles, is checked a word at a time
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+      uint64_t word;
+      memcpy(&word, bytes + i, sizeof(word));
+      if (word & 0x8080808080808080ULL)
+        break;
+    }
+    for (; i < size && bytes[i] < 0x80; ++i)
+      ;
+    if (i == size)
+      break;
+    const unsigned length = getSequenceLength(bytes + i, size - i);
+    if (!length)
+      return false;
+    i += length;
+  }
+  return true;
+}
+
+void appendUTF8(librevenge::RVNGString &text, const char *const str)
+{
+  const unsigned long size = strlen(str);
+  if (isValidUTF8(str, size))
+  {
+    text.append(str);
+    return;
+  }
+
+  const unsigned char *const bytes = reinterpret_cast<const unsigned char *>(str);
+  for (unsigned long i = 0; i < size;)
+  {
+    const unsigned length = getSequenceLength(bytes + i, size - i);
+    if (!length)
+    {
+      appendUCS4(text, 0xfffd);
+      ++i;
+      continue;
+    }
+    for (unsigned j = 0; j < length; ++j)
+      text.append(str[i + j]);
+    i += length;
+  }
+}
+
+uint64_t hashBytes(const void *const data, const unsigned long size, const uint64_t seed)
+{
+  const unsigned char *const bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = seed;
+  for (unsigned long i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+namespace
+{
+
+const uint32_t SHA256_K[64] =
+{
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotateRight(const uint32_t value, const unsigned count)
+{
+  return (value >> count) | (value << (32 - count));
+}
+
+}
+
+SHA256::SHA256()
+  : m_state(), m_block(), m_blockSize(0), m_length(0)
+{
+  static const uint32_t INITIAL[8] =
+  {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  memcpy(m_state, INITIAL, sizeof(m_state));
+}
+
+void SHA256::update(const void *const data, const unsigned long size)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  unsigned long left = size;
+  m_length += size;
+  while (left)
+  {
+    // whole blocks are compressed in place
+    if (m_blockSize == 0 && left >= sizeof(m_block))
+    {
+      compress(bytes);
+      bytes += sizeof(m_block);
+      left -= sizeof(m_block);
+      continue;
+    }
+    const unsigned long count = std::min<unsigned long>(left, sizeof(m_block) - m_blockSize);
+    memcpy(m_block + m_blockSize, bytes, count);
+    m_blockSize += (unsigned)count;
+    bytes += count;
+    left -= count;
+    if (m_blockSize == sizeof(m_block))
+    {
+      compress(m_block);
+      m_blockSize = 0;
+    }
+  }
+}
+
+std::string SHA256::hexDigest()
+{
+  const uint64_t bits = m_length * 8;
+  const unsigned char one = 0x80;
+  update(&one, 1);
+  const unsigned char zero = 0;
+  while (m_blockSize != 56)
+    update(&zero, 1);
+  for (int shift = 56; shift >= 0; shift -= 8)
+  {
+    const unsigned char byte = (unsigned char)(bits >> shift);
+    update(&byte, 1);
+  }
+
+  static const char HEX[] = "0123456789abcdef";
+  std::string digest;
+  digest.reserve(64);
+  for (unsigned i = 0; i < 8; ++i)
+  {
+    for (int shift = 28; shift >= 0; shift -= 4)
+      digest += HEX[(m_state[i] >> shift) & 15];
+  }
+  return digest;
+}
+
+void SHA256::compress(const unsigned char *const block)
+{
+  uint32_t w[64];
+  for (unsigned i = 0; i < 16; ++i)
+    w[i] = uint32_t(block[4 * i]) << 24 | uint32_t(block[4 * i + 1]) << 16
+           | uint32_t(block[4 * i + 2]) << 8 | uint32_t(block[4 * i + 3]);
+  for (unsigned i = 16; i < 64; ++i)
+  {
+    const uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+  uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+  for (unsigned i = 0; i < 64; ++i)
+  {
+    const uint32_t t1 = h + (rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25))
+                        + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+    const uint32_t t2 = (rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22))
+                        + ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  m_state[0] += a;
+  m_state[1] += b;
+  m_state[2] += c;
+  m_state[3] += d;
+  m_state[4] += e;
+  m_state[5] += f;
+  m_state[6] += g;
+  m_state[7] += h;
+}
+
 }
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
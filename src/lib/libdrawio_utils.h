@@ -99,6 +99,35 @@ unsigned long getLength(std::shared_ptr<librevenge::RVNGInputStream> input);
 
 void appendUCS4(librevenge::RVNGString &text, UChar32 ucs4Character);
 
+bool isValidUTF8(const char *str, unsigned long size);
+// appends the NUL-terminated str as is if it is valid UTF-8, else with
+// U+FFFD for every byte that is not part of a valid sequence
+void appendUTF8(librevenge::RVNGString &text, const char *str);
+
+// 64-bit FNV-1a; pass the previous result as seed to hash data in pieces
+const uint64_t HASH_SEED = 0xcbf29ce484222325ULL;
+uint64_t hashBytes(const void *data, unsigned long size, uint64_t seed = HASH_SEED);
+
+/* SHA-256, for keys that must not collide even for crafted input, such as
+ * the names of cache entries shared between users.
+ */
+class SHA256
+{
+public:
+  SHA256();
+  void update(const void *data, unsigned long size);
+  // the digest in 64 lowercase hex digits; no more data may be added
+  std::string hexDigest();
+
+private:
+  void compress(const unsigned char *block);
+
+  uint32_t m_state[8];
+  unsigned char m_block[64];
+  unsigned m_blockSize;
+  uint64_t m_length;
+};
+
 class EndOfStreamException
 {
 public:
@@ -139,6 +168,26 @@ class UnsupportedFormat
 {
 };
 
+// one of DRAWIOLimits exceeded
+class LimitExceeded
+{
+public:
+  enum Limit
+  {
+    INPUT_BYTES,
+    CELLS_PER_PAGE,
+    POINTS_PER_ARRAY,
+    LABEL_BYTES,
+    TIME
+  };
+
+  explicit LimitExceeded(Limit limit);
+  Limit getLimit() const;
+
+private:
+  Limit m_limit;
+};
+
 } // namespace libdrawio
 
 #endif // INCLUDED_LIBDRAWIO_UTILS_H
@@ -1,6 +1,7 @@
 /* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
 
 #include "libdrawio_xml.h"
+#include "DRAWIOCollector.h"
 #include "libdrawio_utils.h"
 #include "librevenge-stream/RVNGStream.h"
 #include "libxml/xmlreader.h"
@@ -32,6 +33,8 @@ namespace {
 
       if (tmpBuffer && tmpNumBytesRead)
         memcpy(buffer, tmpBuffer, tmpNumBytesRead);
+      if (libdrawio::DRAWIOCollector *collector = libdrawio::DRAWIOCollector::get())
+        collector->statistics().bytesRead += tmpNumBytesRead;
       return tmpNumBytesRead;
     }
     
@@ -0,0 +1,135 @@
+#!/usr/bin/perl
+#
+# This file is part of the libdrawio project.
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Packs mxGraph stencil sets into a header to be compiled into the
+# library. Every shape is deflated on its own, so that it can be inflated
+# when it is first used, and is found by its style name, e.g.
+# mxgraph.flowchart.decision, through a minimal perfect hash.
+#
+# Usage: packstencils.pl SET.xml... > stencilblob.h
+
+use strict;
+use warnings;
+use Compress::Raw::Zlib;
+
+# FNV-1a with a seed; must match stencilHash in DRAWIOStencil.cpp
+sub stencilHash {
+    my ($name, $seed) = @_;
+    my $hash = 2166136261 ^ (($seed * 0x9e3779b9) & 0xffffffff);
+    for my $c (unpack('C*', $name)) {
+        $hash ^= $c;
+        $hash = ($hash * 16777619) & 0xffffffff;
+    }
+    return $hash;
+}
+
+sub deflateRaw {
+    my ($data) = @_;
+    my ($deflate, $status) = Compress::Raw::Zlib::Deflate->new(
+        -Level => Z_BEST_COMPRESSION, -WindowBits => -MAX_WBITS, -AppendOutput => 1);
+    die "cannot deflate\n" unless $status == Z_OK;
+    my $out = '';
+    $deflate->deflate($data, $out) == Z_OK or die "cannot deflate\n";
+    $deflate->flush($out) == Z_OK or die "cannot deflate\n";
+    return $out;
+}
+
+sub unescape {
+    my ($s) = @_;
+    $s =~ s/&lt;/</g;
+    $s =~ s/&gt;/>/g;
+    $s =~ s/&quot;/"/g;
+    $s =~ s/&apos;/'/g;
+    $s =~ s/&amp;/&/g;
+    return $s;
+}
+
+die "Usage: packstencils.pl SET.xml...\n" unless @ARGV;
+
+my @shapes;
+my %seen;
+for my $file (@ARGV) {
+    open(my $in, '<', $file) or die "cannot read $file: $!\n";
+    my $xml = do { local $/; <$in> };
+    close($in);
+    $xml =~ /<shapes\b[^>]*\bname="([^"]*)"/ or die "$file: no named shapes element\n";
+    my $package = lc(unescape($1));
+    # as mxStencilRegistry names them: lower case, spaces as underscores
+    while ($xml =~ /(<shape\b[^>]*?\bname="([^"]*)"[^>]*?(?:\/>|>.*?<\/shape>))/gs) {
+        my ($shape, $name) = ($1, lc(unescape($2)));
+        $name =~ s/ /_/g;
+        $name = "$package.$name";
+        die "$file: $name is defined twice\n" if $seen{$name}++;
+        push @shapes, {name => $name, size => length($shape), data => deflateRaw($shape)};
+    }
+}
+
+my $count = scalar @shapes;
+die "no shapes found\n" unless $count;
+
+# hash and displace: the shapes of each bucket get a seed that puts all of
+# them into free slots, the fullest buckets first
+my $bucketCount = int($count / 2) + 1;
+my @buckets = map { [] } 1 .. $bucketCount;
+push @{$buckets[stencilHash($_->{name}, 0) % $bucketCount]}, $_ for @shapes;
+my @seeds = (0) x $bucketCount;
+my @slots = (undef) x $count;
+for my $bucket (sort { scalar @{$buckets[$b]} <=> scalar @{$buckets[$a]} || $a <=> $b } 0 .. $bucketCount - 1) {
+    next unless @{$buckets[$bucket]};
+    SEED: for my $seed (1 .. 65535) {
+        my %taken;
+        for my $shape (@{$buckets[$bucket]}) {
+            my $slot = stencilHash($shape->{name}, $seed) % $count;
+            next SEED if defined $slots[$slot] || $taken{$slot}++;
+        }
+        $slots[stencilHash($_->{name}, $seed) % $count] = $_ for @{$buckets[$bucket]};
+        $seeds[$bucket] = $seed;
+        last;
+    }
+    die "no seed found for bucket $bucket\n" unless $seeds[$bucket];
+}
+
+print "/* Generated by packstencils.pl; do not edit. */\n";
+print "/* Command-line: packstencils.pl @ARGV */\n\n";
+print "namespace libdrawio {\n";
+print "  namespace stencilblob {\n";
+print "    const unsigned SHAPE_COUNT = $count;\n";
+print "    const unsigned BUCKET_COUNT = $bucketCount;\n\n";
+print "    // seed of the second hash of every bucket of the first one\n";
+print "    const unsigned short SEEDS[BUCKET_COUNT] = {\n";
+for (my $i = 0; $i < $bucketCount; $i += 12) {
+    my $last = $i + 11 < $bucketCount - 1 ? $i + 11 : $bucketCount - 1;
+    print "      ", join(', ', @seeds[$i .. $last]), ($last < $bucketCount - 1 ? ",\n" : "\n");
+}
+print "    };\n\n";
+
+my ($names, $nameOffset, $dataOffset) = ('', 0, 0);
+print "    // by slot: offset of the name, offset and size of the deflated XML,\n";
+print "    // size of the XML\n";
+print "    const unsigned RECORDS[SHAPE_COUNT][4] = {\n";
+for my $slot (0 .. $count - 1) {
+    my $shape = $slots[$slot];
+    my $size = length($shape->{data});
+    print "      {$nameOffset, $dataOffset, $size, $shape->{size}}", ($slot < $count - 1 ? ",\n" : "\n");
+    $names .= "      \"$shape->{name}\\0\"\n";
+    $nameOffset += length($shape->{name}) + 1;
+    $dataOffset += $size;
+}
+print "    };\n\n";
+print "    const char NAMES[] =\n$names      ;\n\n";
+print "    const unsigned char DATA[] = {\n";
+my $data = join('', map { $_->{data} } @slots);
+my @bytes = unpack('C*', $data);
+for (my $i = 0; $i < @bytes; $i += 16) {
+    my $last = $i + 15 < $#bytes ? $i + 15 : $#bytes;
+    print "      ", join(', ', map { sprintf('0x%02x', $_) } @bytes[$i .. $last]),
+        ($last < $#bytes ? ",\n" : "\n");
+}
+print "    };\n";
+print "  }\n";
+print "}\n";
@@ -0,0 +1,463 @@
+/* Generated by packstencils.pl; do not edit. */
+/* Command-line: packstencils.pl stencils/flowchart.xml */
+
+namespace libdrawio {
+  namespace stencilblob {
+    const unsigned SHAPE_COUNT = 34;
+    const unsigned BUCKET_COUNT = 18;
+
+    // seed of the second hash of every bucket of the first one
+    const unsigned short SEEDS[BUCKET_COUNT] = {
+      1, 2, 4, 15, 32, 1, 9, 2, 5, 4, 2, 18,
+      0, 2, 32, 1, 8, 4
+    };
+
+    // by slot: offset of the name, offset and size of the deflated XML,
+    // size of the XML
+    const unsigned RECORDS[SHAPE_COUNT][4] = {
+      {0, 0, 175, 360},
+      {37, 175, 185, 347},
+      {64, 360, 168, 343},
+      {87, 528, 136, 213},
+      {123, 664, 175, 358},
+      {158, 839, 135, 206},
+      {184, 974, 166, 316},
+      {213, 1140, 147, 266},
+      {245, 1287, 130, 203},
+      {271, 1417, 164, 262},
+      {306, 1581, 159, 274},
+      {333, 1740, 166, 269},
+      {374, 1906, 221, 482},
+      {404, 2127, 246, 797},
+      {437, 2373, 165, 344},
+      {458, 2538, 199, 378},
+      {482, 2737, 215, 458},
+      {516, 2952, 206, 385},
+      {545, 3158, 232, 643},
+      {575, 3390, 133, 203},
+      {601, 3523, 163, 277},
+      {632, 3686, 144, 224},
+      {661, 3830, 224, 613},
+      {688, 4054, 162, 291},
+      {711, 4216, 170, 318},
+      {741, 4386, 165, 279},
+      {764, 4551, 207, 409},
+      {790, 4758, 165, 303},
+      {827, 4923, 139, 233},
+      {858, 5062, 170, 285},
+      {893, 5232, 153, 271},
+      {919, 5385, 187, 384},
+      {954, 5572, 175, 397},
+      {981, 5747, 153, 311}
+    };
+
+    const char NAMES[] =
+      "mxgraph.flowchart.predefined_process\0"
+      "mxgraph.flowchart.document\0"
+      "mxgraph.flowchart.sort\0"
+      "mxgraph.flowchart.on-page_reference\0"
+      "mxgraph.flowchart.internal_storage\0"
+      "mxgraph.flowchart.start_2\0"
+      "mxgraph.flowchart.loop_limit\0"
+      "mxgraph.flowchart.parallel_mode\0"
+      "mxgraph.flowchart.start_1\0"
+      "mxgraph.flowchart.merge_or_storage\0"
+      "mxgraph.flowchart.decision\0"
+      "mxgraph.flowchart.extract_or_measurement\0"
+      "mxgraph.flowchart.stored_data\0"
+      "mxgraph.flowchart.multi-document\0"
+      "mxgraph.flowchart.or\0"
+      "mxgraph.flowchart.delay\0"
+      "mxgraph.flowchart.sequential_data\0"
+      "mxgraph.flowchart.paper_tape\0"
+      "mxgraph.flowchart.direct_data\0"
+      "mxgraph.flowchart.process\0"
+      "mxgraph.flowchart.manual_input\0"
+      "mxgraph.flowchart.terminator\0"
+      "mxgraph.flowchart.database\0"
+      "mxgraph.flowchart.card\0"
+      "mxgraph.flowchart.preparation\0"
+      "mxgraph.flowchart.data\0"
+      "mxgraph.flowchart.display\0"
+      "mxgraph.flowchart.off-page_reference\0"
+      "mxgraph.flowchart.annotation_1\0"
+      "mxgraph.flowchart.manual_operation\0"
+      "mxgraph.flowchart.collate\0"
+      "mxgraph.flowchart.summing_function\0"
+      "mxgraph.flowchart.transfer\0"
+      "mxgraph.flowchart.annotation_2\0"
+      ;
+
+    const unsigned char DATA[] = {
+      0x7d, 0x90, 0x5b, 0x0e, 0x83, 0x20, 0x10, 0x45, 0xff, 0xbb, 0x8a, 0xc9, 0x6c, 0x80, 0xf6, 0xc7,
+      0xd8, 0x04, 0x5c, 0x83, 0x5b, 0x40, 0x19, 0x0b, 0xf1, 0x81, 0x01, 0xaa, 0xed, 0xee, 0x8b, 0x68,
+      0x53, 0x4d, 0x13, 0x7f, 0x48, 0xe6, 0xe4, 0xde, 0x33, 0x13, 0xb8, 0xd7, 0x72, 0x24, 0x90, 0x7e,
+      0xa4, 0x3a, 0x08, 0x9c, 0xa4, 0x33, 0xb2, 0xea, 0x08, 0x41, 0x0b, 0xcc, 0xae, 0x08, 0x83, 0xec,
+      0x49, 0x60, 0xe9, 0x48, 0x51, 0x63, 0x06, 0x52, 0x50, 0x3a, 0x5b, 0x93, 0xf7, 0x08, 0x3e, 0x38,
+      0xdb, 0xd2, 0x6c, 0x54, 0x88, 0x51, 0x33, 0x68, 0x72, 0x26, 0x20, 0xcc, 0x02, 0xef, 0x39, 0x16,
+      0x17, 0x00, 0x5e, 0xc9, 0xba, 0x7d, 0x38, 0xfb, 0x1c, 0xd4, 0x32, 0x46, 0xe0, 0xe2, 0x8a, 0xaf,
+      0x77, 0xcd, 0xc1, 0x4b, 0x60, 0x1c, 0xde, 0xcb, 0xcb, 0x52, 0x89, 0x1d, 0x5b, 0xbc, 0xb1, 0x8e,
+      0x0e, 0x92, 0xc6, 0x74, 0xdd, 0xba, 0x9a, 0x6d, 0x64, 0x94, 0x41, 0x17, 0xbc, 0xb7, 0x13, 0x2d,
+      0xba, 0xdb, 0xcf, 0xc7, 0xbb, 0x78, 0xf1, 0x8e, 0x65, 0x09, 0xb2, 0x94, 0x5f, 0xab, 0x67, 0xa2,
+      0x3c, 0xff, 0x17, 0x6d, 0xec, 0x54, 0xc4, 0xd9, 0xfe, 0x66, 0xce, 0xd2, 0x07, 0x17, 0x1f, 0x85,
+      0x50, 0xcb, 0x0e, 0xc2, 0x20, 0x10, 0xbc, 0xfb, 0x15, 0x64, 0x7f, 0x00, 0x6b, 0xe3, 0x2b, 0x81,
+      0x9e, 0xfc, 0x11, 0x6c, 0x57, 0x21, 0x52, 0x68, 0x28, 0x7d, 0xf8, 0xf7, 0x2e, 0x45, 0x8d, 0x7a,
+      0xf1, 0xc2, 0x32, 0x33, 0x3b, 0x03, 0xbb, 0xa2, 0xd7, 0xaa, 0x43, 0xa6, 0xfa, 0x0e, 0xeb, 0x28,
+      0x61, 0x54, 0xc1, 0xa8, 0xb3, 0x45, 0x60, 0x5a, 0xc2, 0x6e, 0x0d, 0xcc, 0xa9, 0x16, 0x25, 0x9c,
+      0x7c, 0x3d, 0xb4, 0xe8, 0x22, 0xb0, 0x3e, 0x06, 0x7f, 0xc3, 0xc9, 0x34, 0x91, 0x1a, 0x8c, 0xd3,
+      0x18, 0x0c, 0xb1, 0x93, 0x84, 0xe3, 0x01, 0xaa, 0x15, 0x63, 0xe2, 0xac, 0xea, 0xdb, 0x35, 0xf8,
+      0xc1, 0x35, 0x09, 0x12, 0xd1, 0xa9, 0xa8, 0xf3, 0x95, 0x40, 0xeb, 0x47, 0x64, 0xb3, 0x04, 0x4a,
+      0xbe, 0xa7, 0x93, 0xbf, 0x15, 0x6b, 0xdc, 0xa2, 0x50, 0xce, 0x1f, 0x69, 0x5b, 0x7c, 0x68, 0xf5,
+      0x10, 0x52, 0x62, 0x21, 0x61, 0x5f, 0x00, 0x9b, 0x37, 0x12, 0x36, 0x7b, 0xaa, 0x65, 0x7e, 0x82,
+      0xe8, 0x32, 0x99, 0x88, 0xde, 0xa5, 0x5a, 0xfe, 0xba, 0xad, 0xef, 0xf1, 0x09, 0x05, 0x7f, 0xfd,
+      0x54, 0xf0, 0xef, 0x21, 0xc4, 0xc5, 0x07, 0xfc, 0x9a, 0xe9, 0x62, 0xac, 0xcd, 0x9b, 0xe0, 0xd9,
+      0xf0, 0xd9, 0x21, 0xf8, 0xb2, 0xd3, 0xea, 0x01, 0x8d, 0x90, 0x41, 0x0e, 0xc2, 0x20, 0x10, 0x45,
+      0xf7, 0x9e, 0x62, 0x32, 0x17, 0xa0, 0x0b, 0x17, 0x36, 0x01, 0x2e, 0xe1, 0x09, 0xb0, 0x9d, 0x0a,
+      0x29, 0x85, 0x86, 0x62, 0xab, 0xb7, 0x77, 0xc0, 0xc4, 0xb4, 0x0b, 0x13, 0x57, 0x64, 0xde, 0x0c,
+      0xbc, 0x3f, 0xc8, 0xc5, 0x9a, 0x99, 0xc0, 0x2c, 0x33, 0x75, 0x59, 0xe1, 0x6a, 0x92, 0x33, 0x37,
+      0x4f, 0x08, 0x56, 0x61, 0x7b, 0x41, 0x08, 0x66, 0x22, 0x85, 0xd7, 0x98, 0x32, 0xc2, 0x92, 0x53,
+      0x1c, 0x69, 0x73, 0x7d, 0xe6, 0xa6, 0x0b, 0x96, 0x92, 0x63, 0xba, 0xd5, 0x41, 0x7d, 0x02, 0x90,
+      0x37, 0xd3, 0x8d, 0xf7, 0x14, 0x1f, 0xa1, 0x2f, 0x25, 0x83, 0xd9, 0x64, 0xab, 0xe5, 0x14, 0x57,
+      0x82, 0xa7, 0xc2, 0x06, 0xe1, 0xa5, 0xf0, 0xdc, 0xa2, 0xd0, 0xd2, 0xbb, 0x50, 0x19, 0x57, 0x05,
+      0x36, 0x7b, 0x56, 0xbc, 0xbf, 0x06, 0xb9, 0xc7, 0xb0, 0xf3, 0x71, 0x21, 0x3e, 0x45, 0x15, 0x14,
+      0xb5, 0x38, 0xba, 0xe5, 0x10, 0x13, 0x1d, 0xa2, 0x0c, 0xce, 0xfb, 0xcf, 0x02, 0xe2, 0xef, 0x70,
+      0x87, 0x20, 0x5f, 0x17, 0x5f, 0xdd, 0x3d, 0x24, 0xc5, 0x5e, 0x25, 0x45, 0xfd, 0x4f, 0xfd, 0x06,
+      0x55, 0x8f, 0x4d, 0x0e, 0xc2, 0x20, 0x10, 0x85, 0xf7, 0x9e, 0x62, 0x32, 0x7b, 0x83, 0x2b, 0x57,
+      0xd0, 0x2b, 0x98, 0x78, 0x03, 0xa4, 0x8f, 0x42, 0x8a, 0x40, 0x00, 0xd3, 0x7a, 0x7b, 0xfb, 0xa3,
+      0x89, 0xdd, 0xbc, 0x64, 0x26, 0xdf, 0xf7, 0x26, 0x23, 0xab, 0xd3, 0x19, 0xa4, 0x6b, 0x86, 0x69,
+      0x8a, 0xad, 0x9f, 0xd1, 0x33, 0x39, 0xc5, 0xd7, 0x0b, 0x53, 0xd4, 0x4f, 0x28, 0xbe, 0xc5, 0x73,
+      0xd6, 0x03, 0xe8, 0x0e, 0x8b, 0x82, 0x68, 0xc0, 0x54, 0x5b, 0x49, 0x23, 0x26, 0xdf, 0xb7, 0x85,
+      0xf4, 0xd1, 0xa1, 0xf8, 0xc6, 0x34, 0x6d, 0x56, 0x77, 0x22, 0x92, 0x0f, 0x6d, 0xc6, 0xa1, 0xa4,
+      0x57, 0xec, 0xd7, 0x71, 0x59, 0x20, 0x04, 0x9f, 0x2b, 0x7e, 0xcd, 0x3b, 0x4a, 0xb3, 0xe2, 0x25,
+      0xdf, 0x6b, 0x8a, 0xcd, 0x13, 0x47, 0x51, 0xda, 0x54, 0x70, 0xe8, 0xb1, 0x3e, 0x84, 0xfd, 0xfa,
+      0x57, 0xf8, 0x27, 0xa4, 0xd8, 0xbe, 0xe9, 0x3e, 0x7d, 0x90, 0x31, 0x0e, 0xc2, 0x30, 0x0c, 0x45,
+      0x77, 0x4e, 0x61, 0xe5, 0x02, 0x81, 0x01, 0x75, 0x49, 0xba, 0x33, 0x73, 0x02, 0xb7, 0x75, 0x9b,
+      0xa8, 0x69, 0x52, 0xa5, 0xa1, 0x85, 0xdb, 0x93, 0x26, 0x80, 0xc2, 0x00, 0x8b, 0x25, 0x7f, 0xff,
+      0xff, 0x6c, 0x59, 0x2c, 0x0a, 0x67, 0x02, 0x5c, 0x66, 0x6a, 0x83, 0x64, 0x2b, 0x7a, 0x8d, 0x8d,
+      0x21, 0x06, 0x4a, 0xb2, 0xea, 0xc8, 0xc0, 0xe2, 0x44, 0x92, 0x5d, 0x6c, 0x20, 0x6f, 0xd1, 0xc0,
+      0x35, 0x38, 0x8f, 0x43, 0x1c, 0x2f, 0xc1, 0xbb, 0x91, 0x36, 0xdd, 0x85, 0x68, 0xd4, 0x56, 0x91,
+      0xd7, 0x81, 0xc1, 0x96, 0x42, 0xf5, 0x01, 0x40, 0x34, 0xd8, 0x8e, 0x83, 0x77, 0x37, 0xdb, 0xed,
+      0x6d, 0x14, 0x7c, 0x5c, 0xf0, 0xa6, 0x66, 0x1f, 0xdc, 0x25, 0x8b, 0xf5, 0xb1, 0x57, 0x9e, 0x42,
+      0xfc, 0x3b, 0x25, 0x7a, 0xe7, 0xe9, 0x0b, 0xd2, 0x6b, 0x63, 0xf2, 0x6a, 0xfe, 0x52, 0x66, 0x0c,
+      0xaa, 0x16, 0x93, 0x5b, 0x69, 0xc7, 0x9d, 0xce, 0x1f, 0x9e, 0x30, 0xda, 0x96, 0x5a, 0x95, 0x44,
+      0x9e, 0xfc, 0x39, 0xfa, 0x0f, 0x94, 0xef, 0x8a, 0xd1, 0x02, 0x54, 0x95, 0xe2, 0x0f, 0x90, 0xe0,
+      0xe5, 0xcd, 0x82, 0xa7, 0xf7, 0xd6, 0x4f, 0x55, 0x8f, 0xd1, 0x0d, 0xc2, 0x30, 0x0c, 0x44, 0xff,
+      0x99, 0xc2, 0xf2, 0x02, 0x41, 0x7c, 0x20, 0x55, 0x4a, 0xba, 0x04, 0x13, 0xb8, 0xad, 0x4b, 0xa2,
+      0x86, 0x24, 0x72, 0x42, 0x0b, 0xdb, 0x93, 0xb6, 0x20, 0xd1, 0x1f, 0x4b, 0x67, 0xdf, 0xbb, 0x93,
+      0x75, 0xb6, 0x94, 0x18, 0x28, 0x27, 0xee, 0x8b, 0xc1, 0x99, 0xc4, 0x51, 0xe7, 0x19, 0xc1, 0x1a,
+      0xbc, 0x9e, 0x11, 0x02, 0x3d, 0xd8, 0xe0, 0xad, 0x90, 0x14, 0xb8, 0x20, 0xe4, 0x22, 0x71, 0xe2,
+      0xc5, 0x0d, 0xa5, 0xde, 0x5d, 0xb0, 0x2c, 0xae, 0x20, 0x2c, 0x06, 0x9b, 0x06, 0xdb, 0x13, 0x80,
+      0xee, 0xa8, 0x9f, 0xee, 0x12, 0x9f, 0x61, 0x58, 0x65, 0x5d, 0xb0, 0xf7, 0x2e, 0x65, 0xfe, 0xe5,
+      0xed, 0x56, 0x78, 0x19, 0xac, 0xe2, 0xbd, 0x4e, 0xb5, 0x71, 0xea, 0x08, 0xea, 0x31, 0x0a, 0x1f,
+      0x72, 0x46, 0xe7, 0xfd, 0xde, 0xfe, 0x05, 0xfe, 0x1d, 0x5a, 0x6d, 0x6f, 0xb4, 0x1f, 0x75, 0x90,
+      0x51, 0x0e, 0x83, 0x20, 0x0c, 0x86, 0xdf, 0x77, 0x0a, 0xd2, 0x0b, 0x60, 0x7c, 0xd8, 0x34, 0x01,
+      0x4e, 0xe0, 0x25, 0x50, 0xeb, 0x20, 0x22, 0x10, 0x60, 0xba, 0xdd, 0x7e, 0x28, 0x2f, 0x33, 0xdb,
+      0x9e, 0x9a, 0x7e, 0xe9, 0xdf, 0x7c, 0x2d, 0x8b, 0x4a, 0x7a, 0x24, 0x32, 0x7a, 0x1c, 0x12, 0x87,
+      0x55, 0x06, 0x2d, 0x7b, 0x83, 0x40, 0x14, 0x87, 0x6b, 0x05, 0xc4, 0xca, 0x05, 0x39, 0x74, 0xce,
+      0x79, 0xd2, 0xe9, 0x45, 0x27, 0x20, 0x31, 0x05, 0x37, 0xe3, 0xa6, 0xc7, 0x94, 0x47, 0xb4, 0x55,
+      0x18, 0x76, 0xba, 0x71, 0x68, 0x1b, 0x10, 0x17, 0x42, 0x58, 0x2f, 0x87, 0xf9, 0x1e, 0xdc, 0xc3,
+      0x8e, 0x7b, 0x9b, 0x81, 0x97, 0x49, 0x09, 0xb6, 0xb8, 0x15, 0xc9, 0x93, 0x43, 0x9d, 0xb7, 0xbe,
+      0x38, 0x54, 0x40, 0x05, 0x33, 0xda, 0x1e, 0xec, 0xd6, 0x7c, 0xb3, 0xb6, 0xb0, 0xfa, 0x17, 0xbc,
+      0x9e, 0x60, 0xf5, 0x97, 0x95, 0xf0, 0x60, 0x5c, 0xc4, 0x5c, 0xe9, 0x21, 0xb2, 0x2b, 0xd2, 0xb3,
+      0x23, 0x9b, 0x5c, 0xc0, 0x93, 0xf2, 0xa4, 0x8d, 0x29, 0x87, 0xd2, 0x12, 0xf8, 0x9c, 0x60, 0xf4,
+      0x78, 0x9a, 0x78, 0x03, 0x7d, 0x90, 0x41, 0x0e, 0x02, 0x21, 0x0c, 0x45, 0xf7, 0x9e, 0xa2, 0xe9,
+      0x05, 0x70, 0x45, 0x34, 0x01, 0x6e, 0x60, 0xe2, 0x15, 0xaa, 0x54, 0x21, 0x32, 0x40, 0x18, 0x9c,
+      0xd1, 0xdb, 0xcb, 0x30, 0x89, 0x71, 0x61, 0x66, 0xd3, 0xa4, 0xbf, 0xff, 0xbf, 0x36, 0x55, 0xa3,
+      0xa3, 0xcc, 0x40, 0x63, 0xe6, 0x6b, 0xd5, 0x38, 0x51, 0xf1, 0x74, 0x09, 0x8c, 0xe0, 0x34, 0xca,
+      0x3d, 0x42, 0xa4, 0x81, 0x35, 0x9e, 0xa9, 0x50, 0x08, 0x1c, 0xe0, 0x94, 0x6c, 0x9b, 0x8d, 0xb5,
+      0xa4, 0x07, 0xcf, 0xde, 0xd6, 0xe6, 0xf2, 0xd1, 0x71, 0xf1, 0x15, 0x61, 0xd6, 0x78, 0x3c, 0xa0,
+      0xd9, 0x01, 0xa8, 0x5b, 0x2a, 0x7c, 0x2f, 0xe9, 0x19, 0xed, 0xd2, 0x36, 0x21, 0x53, 0x75, 0x46,
+      0x0d, 0x69, 0x62, 0x78, 0x69, 0x6c, 0xdc, 0xf7, 0x52, 0x85, 0x51, 0xc1, 0xc7, 0x2e, 0xb5, 0xe4,
+      0x57, 0x13, 0xdd, 0xbd, 0x06, 0xd7, 0x55, 0x62, 0x03, 0x23, 0xff, 0x71, 0xe4, 0x16, 0x48, 0x89,
+      0xdf, 0xfb, 0x94, 0xe8, 0x2f, 0x30, 0x1f, 0x55, 0x8f, 0x51, 0x0e, 0xc2, 0x20, 0x0c, 0x86, 0xdf,
+      0x3d, 0x45, 0xd3, 0x0b, 0xa0, 0x8f, 0x4b, 0x60, 0x97, 0xf0, 0x04, 0xb8, 0x15, 0x69, 0x86, 0x40,
+      0xa0, 0x66, 0xdb, 0xed, 0xdd, 0x98, 0x26, 0xee, 0xa5, 0x49, 0xdb, 0xef, 0xfb, 0x9b, 0xea, 0xea,
+      0x6d, 0x26, 0xb0, 0x35, 0xd3, 0x20, 0x06, 0x1d, 0x2f, 0x34, 0x22, 0x78, 0x83, 0x5d, 0x87, 0x10,
+      0xed, 0x8b, 0x0c, 0xde, 0xc5, 0x16, 0x81, 0x1b, 0x42, 0x95, 0x92, 0x26, 0x9a, 0x79, 0x94, 0x6d,
+      0xcf, 0xd1, 0x53, 0x61, 0x41, 0x98, 0x1b, 0xdb, 0x5f, 0x00, 0xf4, 0xc3, 0x0e, 0xd3, 0xb3, 0xa4,
+      0x77, 0x1c, 0xf7, 0x76, 0x1b, 0x50, 0x08, 0x9c, 0x2b, 0xfd, 0xf2, 0x0e, 0x14, 0x16, 0x83, 0x57,
+      0x84, 0x75, 0xaf, 0xaa, 0x79, 0xea, 0x2c, 0x6a, 0x97, 0x0a, 0x9d, 0x72, 0x1c, 0x87, 0x70, 0x5c,
+      0xff, 0x0a, 0xff, 0x84, 0x56, 0xed, 0x87, 0xfe, 0x03, 0x65, 0x8f, 0x41, 0x12, 0x82, 0x30, 0x0c,
+      0x45, 0xf7, 0x9e, 0x22, 0x93, 0x03, 0x58, 0x17, 0x8a, 0xe3, 0x4c, 0xdb, 0x1b, 0xb8, 0xf2, 0x04,
+      0x01, 0x02, 0xed, 0x50, 0x29, 0xd3, 0x56, 0xd0, 0xdb, 0x5b, 0xca, 0x46, 0xc6, 0x4d, 0x32, 0x79,
+      0x49, 0xfe, 0x4f, 0x64, 0x34, 0x34, 0x31, 0x50, 0x9c, 0xb8, 0x49, 0x0a, 0x67, 0x0a, 0x96, 0x6a,
+      0xc7, 0x08, 0x46, 0x61, 0x75, 0x42, 0x18, 0xe9, 0xc9, 0x0a, 0xef, 0x1c, 0x7a, 0x06, 0x1f, 0xe0,
+      0x91, 0x7c, 0xa0, 0x3e, 0xb7, 0x63, 0x0a, 0x7e, 0xe0, 0xc5, 0xb6, 0x29, 0x0f, 0xda, 0xd1, 0x70,
+      0xb0, 0x09, 0x61, 0x51, 0x78, 0xbb, 0xa0, 0x3e, 0x00, 0xc8, 0x9a, 0x9a, 0xa1, 0x0f, 0xfe, 0x35,
+      0xb6, 0x6b, 0x99, 0xc1, 0x44, 0xc9, 0x68, 0xf9, 0xf4, 0x33, 0xc3, 0x5b, 0x61, 0x96, 0xfe, 0xac,
+      0x51, 0x68, 0xe9, 0xec, 0x58, 0x50, 0xde, 0xfc, 0x63, 0xe7, 0xeb, 0x71, 0xa3, 0x55, 0xc1, 0x8d,
+      0xf3, 0x91, 0x73, 0x16, 0x45, 0x6c, 0xb5, 0x11, 0x7b, 0x1f, 0xd9, 0xf9, 0xc0, 0x3b, 0xdb, 0xce,
+      0x3a, 0xb7, 0x1d, 0x2b, 0xb6, 0x85, 0xdf, 0x09, 0x29, 0xca, 0xfb, 0xfa, 0x0b, 0x75, 0x90, 0x31,
+      0x0e, 0xc3, 0x20, 0x0c, 0x45, 0xf7, 0x9e, 0xc2, 0xf2, 0x05, 0xc8, 0xd0, 0xa1, 0x91, 0x80, 0xa9,
+      0x17, 0x21, 0xc4, 0x29, 0x28, 0x04, 0x22, 0xa0, 0x49, 0x7b, 0xfb, 0x02, 0x59, 0x92, 0xa1, 0x93,
+      0xf5, 0x9f, 0xbf, 0xf5, 0x6d, 0xf3, 0x64, 0xd4, 0x4a, 0xa0, 0xd2, 0x4a, 0x3a, 0x0b, 0xdc, 0x54,
+      0xb4, 0x6a, 0x70, 0x84, 0x60, 0x04, 0xf6, 0x0f, 0x04, 0xaf, 0x16, 0x12, 0xf8, 0x24, 0x6d, 0x93,
+      0x0d, 0x1e, 0x21, 0xe5, 0x18, 0x66, 0xda, 0xed, 0x98, 0x8b, 0xc1, 0x7a, 0x43, 0xd1, 0x66, 0x84,
+      0xbd, 0x99, 0xe5, 0x0d, 0x80, 0x0f, 0x4a, 0xcf, 0xaf, 0x18, 0xde, 0x7e, 0xac, 0xb2, 0x80, 0x55,
+      0x65, 0x23, 0xf9, 0x12, 0x36, 0x82, 0x8f, 0xc0, 0x0e, 0xe1, 0x2b, 0xf0, 0xde, 0x23, 0x93, 0xdc,
+      0x59, 0xdf, 0x58, 0x51, 0x15, 0x76, 0x67, 0x56, 0xb3, 0xff, 0x19, 0x4b, 0xaf, 0x40, 0xed, 0x42,
+      0xa2, 0x52, 0x59, 0x0b, 0xa8, 0xd1, 0xec, 0x9a, 0xcd, 0xa7, 0x10, 0xe9, 0xb2, 0xca, 0x64, 0x9d,
+      0x3b, 0x0e, 0x60, 0xc7, 0xc0, 0xd9, 0xc1, 0x59, 0x7b, 0x85, 0xfc, 0x01, 0x55, 0x90, 0x3d, 0x0e,
+      0x83, 0x30, 0x0c, 0x46, 0xf7, 0x9e, 0xc2, 0xf2, 0x01, 0x9a, 0x0e, 0xa5, 0x15, 0x52, 0xc2, 0xd6,
+      0xb1, 0x87, 0x30, 0x60, 0x4a, 0x44, 0x48, 0x50, 0x12, 0x7e, 0x7a, 0xfb, 0x86, 0xb0, 0x94, 0xc9,
+      0xf2, 0xd3, 0x67, 0x3f, 0xcb, 0x32, 0xf4, 0x34, 0x31, 0x50, 0x98, 0xb8, 0x89, 0x0a, 0x17, 0xf2,
+      0x9a, 0x6a, 0xc3, 0x08, 0xbd, 0xc2, 0xc7, 0x0d, 0xc1, 0xd2, 0xc8, 0x0a, 0x5f, 0x5b, 0xf4, 0xd4,
+      0x44, 0x70, 0x1e, 0xde, 0x4c, 0x61, 0xf6, 0x3c, 0xb2, 0x8d, 0x08, 0x21, 0x7a, 0x37, 0xf0, 0xaa,
+      0xdb, 0x98, 0xe2, 0xda, 0xf6, 0xec, 0x75, 0xa2, 0xab, 0xc2, 0xb2, 0xc0, 0xea, 0x02, 0x20, 0x6b,
+      0x6a, 0x86, 0x8f, 0x77, 0xb3, 0x6d, 0xf7, 0x36, 0x81, 0x89, 0x62, 0x5f, 0xc9, 0xd1, 0x2d, 0x0c,
+      0x9b, 0xc2, 0x24, 0xf8, 0x66, 0x8f, 0xa8, 0xa4, 0xd1, 0x36, 0xb3, 0xfb, 0xf3, 0x5a, 0x64, 0x7c,
+      0xa2, 0x65, 0xf1, 0x17, 0x6d, 0x8c, 0x0b, 0x9c, 0xaa, 0xc8, 0xdb, 0x76, 0x8f, 0x38, 0x8b, 0x64,
+      0xe7, 0x3c, 0x9f, 0xbc, 0x9d, 0x36, 0xe6, 0xb8, 0x56, 0x1c, 0x03, 0xff, 0x09, 0x29, 0xf2, 0x17,
+      0xaa, 0x1f, 0xa5, 0x51, 0xcb, 0x6e, 0xc2, 0x30, 0x10, 0xbc, 0xf7, 0x2b, 0x56, 0x7b, 0x8f, 0x0c,
+      0x6a, 0x85, 0xa8, 0x64, 0x73, 0xe2, 0x0f, 0xfa, 0x05, 0x4b, 0xb2, 0x49, 0x2c, 0x8c, 0x1d, 0xad,
+      0x5d, 0x12, 0xfe, 0x1e, 0x93, 0x84, 0x57, 0x11, 0xa7, 0xde, 0x76, 0x3c, 0xeb, 0x19, 0x7b, 0x46,
+      0xc7, 0x96, 0x3a, 0x06, 0x8a, 0x1d, 0x97, 0xc9, 0xe0, 0x91, 0xc4, 0xd2, 0xce, 0x31, 0x42, 0x6b,
+      0x70, 0xb5, 0x40, 0xf0, 0x74, 0x60, 0x83, 0x3f, 0x29, 0x08, 0x57, 0xb0, 0xa5, 0x44, 0x08, 0x31,
+      0x49, 0xd8, 0x73, 0x6f, 0xab, 0x94, 0x77, 0xac, 0x6f, 0x59, 0x6c, 0x42, 0xe8, 0x0d, 0x7e, 0xaf,
+      0x71, 0xf3, 0x01, 0xa0, 0x77, 0x54, 0xee, 0x1b, 0x09, 0xbf, 0xbe, 0xba, 0xc0, 0x7c, 0xd0, 0x51,
+      0x6a, 0xa7, 0x31, 0x83, 0x43, 0x38, 0x32, 0x0c, 0x06, 0x97, 0x5f, 0x08, 0x27, 0x83, 0x0b, 0x54,
+      0x37, 0xca, 0x59, 0x3f, 0x52, 0x59, 0xe8, 0x2f, 0x45, 0x52, 0x82, 0x23, 0x69, 0xb8, 0xc8, 0x53,
+      0x51, 0x3b, 0x6a, 0x2e, 0x3c, 0xc8, 0x2c, 0x24, 0x79, 0xfd, 0x33, 0xe3, 0xd8, 0x33, 0x77, 0x77,
+      0x7a, 0xd6, 0x1a, 0x0a, 0x1a, 0x6c, 0x2c, 0x24, 0x24, 0x4a, 0x36, 0xf8, 0x91, 0x3a, 0x8d, 0xff,
+      0x7b, 0xf5, 0x9e, 0x9f, 0xb5, 0xfa, 0xa7, 0xf9, 0x12, 0xaf, 0x62, 0x6f, 0xcc, 0x1f, 0xf5, 0x4b,
+      0x17, 0x22, 0xcf, 0x50, 0xab, 0x6b, 0x5a, 0x5a, 0x3d, 0x07, 0xa9, 0xeb, 0x5c, 0xc2, 0x53, 0xae,
+      0xb5, 0x75, 0x6e, 0x6a, 0x43, 0x4d, 0x17, 0x1e, 0x37, 0xb4, 0x1a, 0xab, 0xdd, 0x9c, 0x01, 0x8d,
+      0x93, 0xcb, 0x72, 0xc3, 0x20, 0x0c, 0x45, 0xf7, 0xfd, 0x0a, 0x46, 0xfb, 0x0e, 0x7e, 0x37, 0x0b,
+      0xc8, 0xaa, 0xdb, 0x7e, 0x04, 0x21, 0xa4, 0x66, 0x82, 0xc1, 0x83, 0x71, 0x1e, 0x7f, 0x5f, 0xf9,
+      0x91, 0x4c, 0xdc, 0xd2, 0x38, 0x2b, 0xd0, 0x3d, 0x20, 0x71, 0xa5, 0x81, 0x75, 0xb5, 0x68, 0x15,
+      0x11, 0x5d, 0xab, 0x64, 0xe0, 0x70, 0x12, 0x5e, 0x8b, 0x9d, 0x51, 0x40, 0x6a, 0x0e, 0x55, 0x02,
+      0xc4, 0x8a, 0x46, 0x71, 0xf8, 0xea, 0x4d, 0xd0, 0xef, 0x9f, 0x4e, 0xf6, 0x8d, 0xb2, 0x01, 0x48,
+      0x17, 0xbc, 0x3b, 0xaa, 0xb3, 0xde, 0x07, 0x3c, 0xa6, 0x6d, 0xad, 0xbc, 0x46, 0xf5, 0xcc, 0x61,
+      0xb3, 0x81, 0xed, 0x1b, 0x21, 0x6c, 0x27, 0xe4, 0xf1, 0xdb, 0xbb, 0xde, 0xee, 0x87, 0x10, 0x85,
+      0x56, 0x84, 0x7a, 0xda, 0x62, 0xd0, 0xb8, 0x93, 0x22, 0x17, 0x0e, 0x29, 0x16, 0xb8, 0x72, 0x48,
+      0x80, 0xde, 0x91, 0xd1, 0x76, 0x44, 0x98, 0x68, 0x05, 0x15, 0x69, 0x84, 0x7d, 0xac, 0xb3, 0x34,
+      0x96, 0x73, 0x7e, 0xc9, 0x82, 0x49, 0xe3, 0x3a, 0x35, 0x87, 0x8c, 0xde, 0x0c, 0x30, 0xba, 0xf4,
+      0xc6, 0x0e, 0xce, 0xab, 0x85, 0xd5, 0x83, 0x36, 0x66, 0x6a, 0x10, 0x7d, 0x66, 0xbe, 0x1c, 0x2b,
+      0x96, 0x31, 0x83, 0xf9, 0x1a, 0x2a, 0xaa, 0x98, 0xbf, 0x75, 0x96, 0xc6, 0x72, 0x96, 0x7f, 0x51,
+      0xdc, 0xfa, 0xeb, 0xde, 0x92, 0xff, 0x3b, 0xfd, 0x6c, 0x0a, 0x33, 0x2b, 0x1f, 0xa7, 0x27, 0x7b,
+      0x3f, 0xe4, 0x4c, 0x51, 0xae, 0x80, 0x5c, 0x32, 0x0e, 0x59, 0x86, 0x6b, 0x3e, 0x15, 0x41, 0xb9,
+      0x18, 0x56, 0x94, 0x2b, 0xc4, 0xd7, 0xfc, 0xf7, 0xed, 0x17, 0x8d, 0x30, 0xfa, 0x38, 0x46, 0x46,
+      0xc7, 0x5f, 0xb1, 0xfd, 0x01, 0x7d, 0x90, 0x41, 0x0e, 0xc2, 0x20, 0x10, 0x45, 0xf7, 0x9e, 0x62,
+      0x32, 0x17, 0xc0, 0xc4, 0x98, 0x6e, 0xa0, 0x57, 0xf0, 0x0c, 0xd8, 0x4e, 0x85, 0x94, 0x02, 0xa1,
+      0x68, 0xeb, 0xed, 0xa5, 0xa0, 0x86, 0x2e, 0x74, 0x33, 0x09, 0x8f, 0xff, 0x1f, 0x13, 0xf8, 0xac,
+      0xa4, 0x27, 0x90, 0xb3, 0xa7, 0x2e, 0x0a, 0x1c, 0xf4, 0x4a, 0x3d, 0x82, 0x12, 0xd8, 0x1c, 0x11,
+      0xac, 0x9c, 0x48, 0xe0, 0x25, 0x20, 0xcc, 0x31, 0xb8, 0x91, 0x16, 0xdd, 0xc7, 0x74, 0xa5, 0xad,
+      0xa2, 0xa0, 0x23, 0xc2, 0x92, 0x63, 0xed, 0x01, 0x80, 0x5f, 0x65, 0x37, 0xde, 0x82, 0xbb, 0xdb,
+      0x7e, 0x3b, 0x26, 0x40, 0xc6, 0x68, 0x3f, 0xd3, 0x47, 0x55, 0xa2, 0xb0, 0x0a, 0x4c, 0xf3, 0xb9,
+      0x4d, 0x96, 0x7b, 0x6c, 0x5f, 0xe4, 0x83, 0x0b, 0xb4, 0xf3, 0x0c, 0xda, 0x98, 0xf2, 0x3a, 0x7b,
+      0x13, 0x2f, 0xa3, 0x6a, 0xf9, 0xe4, 0x1e, 0xb4, 0xe9, 0x4e, 0xe7, 0xaf, 0x8f, 0x1b, 0x6d, 0x6b,
+      0xd6, 0x64, 0xc8, 0x72, 0xbe, 0x54, 0xff, 0x89, 0xca, 0x5e, 0xa9, 0x5a, 0x89, 0x9a, 0x1a, 0xfe,
+      0x10, 0x71, 0x56, 0xef, 0xcc, 0x59, 0xfe, 0xd0, 0xf6, 0x05, 0x6d, 0x90, 0xd1, 0xae, 0x82, 0x30,
+      0x0c, 0x86, 0xef, 0x7d, 0x8a, 0xa6, 0xf7, 0x64, 0x9a, 0x93, 0x10, 0x4d, 0x36, 0xaf, 0x7c, 0x91,
+      0x82, 0x05, 0x16, 0xe7, 0x46, 0xba, 0x29, 0xf0, 0xf6, 0x67, 0x80, 0x9c, 0x1c, 0xa3, 0x37, 0x6b,
+      0xff, 0x7d, 0xed, 0xdf, 0xb4, 0x3a, 0x76, 0xd4, 0x33, 0x50, 0xec, 0xb9, 0x4e, 0x06, 0x9f, 0x24,
+      0x96, 0x2a, 0xc7, 0x08, 0x9d, 0xc1, 0x72, 0x8f, 0xe0, 0xe9, 0xce, 0x06, 0x2f, 0xec, 0x68, 0x42,
+      0x88, 0x49, 0xc2, 0x8d, 0x07, 0x7b, 0x4d, 0x99, 0x5a, 0xdf, 0xb1, 0xd8, 0x84, 0x30, 0x18, 0x3c,
+      0x1d, 0xf1, 0xbc, 0x03, 0xd0, 0x15, 0xd5, 0xb7, 0x56, 0xc2, 0xc3, 0x5f, 0x67, 0x99, 0x3f, 0x7a,
+      0x4a, 0xdd, 0x9a, 0x66, 0x71, 0x0f, 0x4f, 0x86, 0xd1, 0x60, 0xb6, 0x9d, 0xe6, 0x57, 0xfd, 0x11,
+      0x67, 0xfd, 0x42, 0xca, 0xe3, 0x07, 0x22, 0xa9, 0xc1, 0x91, 0xb4, 0x5c, 0xe4, 0xac, 0x68, 0x1c,
+      0xb5, 0x8b, 0x81, 0xe4, 0xea, 0x9f, 0x39, 0x4e, 0x6b, 0x8c, 0x03, 0x73, 0xff, 0xc2, 0x07, 0xdc,
+      0xbc, 0xc6, 0x82, 0x46, 0x1b, 0x0b, 0x09, 0x89, 0x92, 0x0d, 0x7e, 0x1b, 0x5d, 0x7e, 0x9b, 0xfd,
+      0x05, 0xd5, 0x2e, 0x44, 0x7e, 0x49, 0xad, 0xb6, 0x5d, 0xb4, 0x7a, 0x5f, 0x53, 0x37, 0x41, 0xf8,
+      0x6d, 0xeb, 0xc6, 0x3a, 0xb7, 0xde, 0x4a, 0xad, 0x0d, 0xff, 0x2b, 0xb4, 0x5a, 0x4e, 0x7e, 0xfe,
+      0x05, 0x8d, 0x51, 0xc1, 0x4e, 0xc3, 0x30, 0x0c, 0xbd, 0xf3, 0x15, 0x96, 0xef, 0x55, 0x8a, 0x10,
+      0xda, 0x25, 0xd9, 0x89, 0x3f, 0xe0, 0x0b, 0x4c, 0xeb, 0xb6, 0xd1, 0xb2, 0xa4, 0x38, 0x19, 0xcd,
+      0xfe, 0x7e, 0x59, 0xb3, 0x01, 0x45, 0x02, 0x71, 0x8a, 0x9f, 0x9f, 0x9f, 0x9e, 0xfd, 0xa2, 0xe3,
+      0x44, 0x33, 0x03, 0xc5, 0x99, 0xbb, 0x64, 0x70, 0xb0, 0x99, 0x7b, 0x84, 0xc9, 0xe0, 0xae, 0x45,
+      0xf0, 0x74, 0x64, 0x83, 0xaf, 0xfc, 0x7e, 0x62, 0x9f, 0x2c, 0x39, 0x78, 0xa1, 0x44, 0x08, 0x31,
+      0x49, 0x38, 0xf0, 0x62, 0xfb, 0x54, 0xe6, 0xac, 0x9f, 0x58, 0x6c, 0x42, 0x58, 0x56, 0xcd, 0xfe,
+      0x01, 0x40, 0xbf, 0x51, 0x77, 0x18, 0x25, 0x9c, 0x7c, 0x7f, 0x85, 0xa5, 0x31, 0x53, 0x9a, 0x6a,
+      0x59, 0xc0, 0x31, 0x7c, 0x30, 0x64, 0x83, 0x4f, 0xcf, 0x08, 0xe7, 0x55, 0xa4, 0x3e, 0x39, 0x92,
+      0x0e, 0x1c, 0xc9, 0xc8, 0x4d, 0xa9, 0x9a, 0xc1, 0xd1, 0x68, 0xf0, 0x11, 0x41, 0x6e, 0xe3, 0x72,
+      0xae, 0x6f, 0x5c, 0x98, 0xe7, 0x2f, 0x3a, 0xd7, 0x75, 0x73, 0x43, 0xd9, 0xc6, 0x46, 0x42, 0xa2,
+      0x64, 0x83, 0x37, 0xd8, 0xae, 0x06, 0x45, 0xf0, 0xb7, 0x41, 0xfb, 0x1f, 0x83, 0x6b, 0xf7, 0x17,
+      0x83, 0xcd, 0x05, 0xce, 0x7a, 0xbe, 0x2f, 0xf4, 0x93, 0xeb, 0x5c, 0x88, 0x7c, 0x83, 0x5a, 0xdd,
+      0x43, 0xd1, 0x6a, 0x9b, 0x97, 0x1e, 0x82, 0xf0, 0x26, 0xbe, 0xc1, 0x3a, 0x57, 0x43, 0x57, 0x55,
+      0xf0, 0x7d, 0x42, 0xab, 0xf5, 0x0b, 0xf7, 0x17, 0x6d, 0x90, 0xdb, 0x0e, 0xc2, 0x20, 0x0c, 0x86,
+      0xef, 0x7d, 0x8a, 0xa6, 0xf7, 0x06, 0xc7, 0x3c, 0x26, 0xe0, 0x33, 0x78, 0xe1, 0x0b, 0xe0, 0xac,
+      0x8e, 0x88, 0x63, 0x61, 0x78, 0x7a, 0x7b, 0x3b, 0x98, 0xc6, 0x25, 0xde, 0x50, 0xda, 0xfe, 0xff,
+      0x57, 0x8a, 0xea, 0x6a, 0xd3, 0x12, 0x98, 0xae, 0xa5, 0x2a, 0x6a, 0xbc, 0x9b, 0x60, 0xcd, 0xc1,
+      0x11, 0x42, 0xad, 0x71, 0x39, 0x43, 0x68, 0xcc, 0x95, 0x34, 0xee, 0x58, 0x13, 0x60, 0xcf, 0x27,
+      0x42, 0x17, 0x83, 0xbf, 0xd0, 0xc3, 0x1e, 0x23, 0x4b, 0x6c, 0x53, 0x53, 0xb0, 0x11, 0xe1, 0xa1,
+      0x71, 0xb3, 0xc6, 0xed, 0x04, 0x40, 0x1d, 0x4c, 0x75, 0x39, 0x07, 0x7f, 0x6b, 0x8e, 0x7d, 0xca,
+      0x85, 0xd6, 0xc4, 0x3a, 0x5f, 0x39, 0xb9, 0xfa, 0x3b, 0xc1, 0x53, 0x23, 0xb3, 0x5f, 0x3c, 0x02,
+      0xc5, 0xb7, 0x53, 0xdd, 0x42, 0xdf, 0x2a, 0x34, 0xca, 0x15, 0xc2, 0x53, 0x6a, 0x5c, 0x15, 0x1c,
+      0xcb, 0x44, 0x86, 0x17, 0xd7, 0xa7, 0x45, 0xef, 0xe2, 0x86, 0x94, 0x1c, 0xcb, 0xb1, 0xdd, 0xd9,
+      0x26, 0x81, 0x93, 0x58, 0xe3, 0x62, 0xfe, 0x17, 0x9d, 0x90, 0x72, 0x18, 0x51, 0xe6, 0x67, 0xf4,
+      0xe5, 0x01, 0x5c, 0xae, 0x33, 0x78, 0xec, 0x76, 0xbe, 0xa3, 0x21, 0x55, 0xe2, 0xb3, 0x8d, 0x12,
+      0xe3, 0x45, 0xd5, 0xc9, 0x07, 0x1a, 0xed, 0x7d, 0xb2, 0xce, 0xe5, 0xdf, 0x12, 0xd9, 0xf0, 0xab,
+      0x50, 0x22, 0xfd, 0xfc, 0xf6, 0x0d, 0xad, 0x52, 0xc1, 0x6e, 0xc2, 0x30, 0x0c, 0xbd, 0xef, 0x2b,
+      0x2c, 0xdf, 0xab, 0xb4, 0xda, 0x84, 0x98, 0x94, 0x70, 0xe2, 0x47, 0x4c, 0x71, 0xdb, 0x88, 0x90,
+      0x54, 0x4e, 0xa0, 0xe5, 0xef, 0x17, 0x4a, 0xd9, 0x8a, 0xd0, 0xa6, 0x1d, 0xb8, 0xf9, 0xe5, 0x39,
+      0x7e, 0x7e, 0x2f, 0xd1, 0xb1, 0xa3, 0x9e, 0x81, 0x62, 0xcf, 0x75, 0x32, 0x78, 0x26, 0xb1, 0xb4,
+      0x73, 0x8c, 0xd0, 0x19, 0x5c, 0x95, 0x08, 0x9e, 0x8e, 0x6c, 0x70, 0x6b, 0x25, 0xd3, 0xb0, 0xa5,
+      0x44, 0x08, 0x31, 0x49, 0x38, 0xf0, 0x60, 0xf7, 0x29, 0xf7, 0x58, 0xdf, 0xb1, 0xd8, 0x84, 0x30,
+      0x18, 0xfc, 0x5c, 0xe3, 0xe6, 0x0d, 0x40, 0xef, 0xa8, 0x3e, 0xb4, 0x12, 0x4e, 0x7e, 0x7f, 0x85,
+      0xf9, 0xa0, 0xa7, 0xd4, 0xdd, 0xca, 0x0c, 0x8e, 0xe1, 0xcc, 0x30, 0x1a, 0xac, 0x3e, 0x10, 0x2e,
+      0x06, 0x4b, 0x54, 0xdf, 0x94, 0xb3, 0x7e, 0xa2, 0xd6, 0xcf, 0x14, 0x49, 0x0d, 0x8e, 0xa4, 0xe5,
+      0x22, 0x57, 0x45, 0xe3, 0xa8, 0xbd, 0xf2, 0x20, 0xf3, 0x20, 0xc9, 0xed, 0xef, 0x19, 0xc7, 0x81,
+      0xb9, 0x9f, 0xe9, 0x0a, 0xef, 0xb3, 0xc6, 0x82, 0x46, 0x1b, 0x0b, 0x09, 0x89, 0x92, 0x0d, 0x7e,
+      0xba, 0x79, 0x99, 0xfc, 0x3d, 0x6b, 0xcf, 0x6b, 0xad, 0x5e, 0x22, 0x5e, 0xfd, 0x2e, 0xbe, 0x9c,
+      0x5f, 0xbb, 0x10, 0x79, 0x86, 0x5a, 0xdd, 0xd3, 0xd2, 0xea, 0x31, 0x48, 0xdd, 0x04, 0xe1, 0x87,
+      0x5c, 0x1b, 0xeb, 0xdc, 0xed, 0x35, 0xd4, 0x5f, 0x49, 0xbf, 0x26, 0xce, 0xf2, 0xff, 0x71, 0xfe,
+      0x78, 0xc8, 0xf5, 0x62, 0x41, 0xad, 0x96, 0x16, 0xb4, 0x9a, 0xfe, 0xde, 0xe6, 0x0b, 0x55, 0x8f,
+      0xd1, 0x0d, 0xc2, 0x30, 0x0c, 0x44, 0xff, 0x99, 0xc2, 0xf2, 0x02, 0xe1, 0x0b, 0x81, 0x94, 0x74,
+      0x06, 0x56, 0x70, 0x53, 0xb7, 0x89, 0x1a, 0x92, 0xca, 0x09, 0x14, 0xb6, 0x6f, 0xda, 0x82, 0x44,
+      0x7f, 0x2c, 0x9d, 0x7d, 0xef, 0x4e, 0xd6, 0xd9, 0xd1, 0xc4, 0x40, 0x79, 0x62, 0x5b, 0x0c, 0xbe,
+      0x48, 0x3c, 0xb5, 0x81, 0x11, 0x9c, 0xc1, 0xcb, 0x19, 0x21, 0xd2, 0x83, 0x0d, 0xde, 0x25, 0x59,
+      0xce, 0x19, 0x21, 0x17, 0x49, 0x23, 0xcf, 0xbe, 0x2b, 0xf5, 0xee, 0xa3, 0x63, 0xf1, 0x05, 0x61,
+      0x36, 0x78, 0xbb, 0x62, 0x73, 0x02, 0xd0, 0x2d, 0xd9, 0x71, 0x90, 0xf4, 0x8c, 0xdd, 0x2a, 0xeb,
+      0x42, 0x6a, 0xee, 0x2f, 0x6c, 0xf7, 0xc1, 0xdb, 0x60, 0x15, 0x9f, 0x75, 0xaa, 0x0d, 0x52, 0x47,
+      0x4a, 0xf7, 0x49, 0xf8, 0x10, 0xd2, 0xfb, 0x10, 0xf6, 0xea, 0x2f, 0xf0, 0xef, 0xd0, 0x6a, 0xfb,
+      0xa1, 0x59, 0x00, 0x6d, 0x90, 0x4b, 0x0e, 0x83, 0x20, 0x10, 0x86, 0xf7, 0x3d, 0x05, 0x99, 0x0b,
+      0x60, 0x17, 0x35, 0x6d, 0x02, 0xec, 0xbb, 0xe8, 0x21, 0x46, 0x1d, 0x0b, 0x11, 0x81, 0x00, 0x6a,
+      0x7b, 0xfb, 0xa2, 0x6e, 0x34, 0xe9, 0x6a, 0x32, 0x5f, 0xfe, 0xc7, 0x64, 0x44, 0xd2, 0x18, 0x88,
+      0x61, 0x0a, 0xd4, 0x66, 0x09, 0x33, 0x46, 0x83, 0x8d, 0x25, 0x60, 0x5a, 0x42, 0x5d, 0x01, 0x73,
+      0x38, 0x92, 0x84, 0x17, 0xba, 0x09, 0x2d, 0x7b, 0xba, 0x30, 0x65, 0x60, 0x29, 0x47, 0x3f, 0xd0,
+      0x62, 0xba, 0x5c, 0x44, 0xc6, 0x69, 0x8a, 0xa6, 0xd0, 0x45, 0xc2, 0xe3, 0x0e, 0xea, 0xc2, 0x98,
+      0x68, 0xb0, 0x1d, 0xde, 0xd1, 0x4f, 0xae, 0x5b, 0xd7, 0x02, 0x02, 0x66, 0xad, 0xc4, 0xe8, 0x67,
+      0x62, 0x1f, 0x09, 0x25, 0xf6, 0x2b, 0xe1, 0x7a, 0x03, 0xae, 0x84, 0x35, 0x6e, 0x63, 0xc5, 0xba,
+      0xc2, 0xea, 0x0f, 0xab, 0x4f, 0xb0, 0x3a, 0xb0, 0xd6, 0xfa, 0x44, 0x65, 0xf2, 0x2d, 0x7f, 0x6d,
+      0xe6, 0xe7, 0x6a, 0xd1, 0xfb, 0x48, 0xa7, 0x4b, 0x7a, 0x63, 0xed, 0x7e, 0x3f, 0xdf, 0x0d, 0x47,
+      0x85, 0xe0, 0xdb, 0x37, 0xd4, 0x0f, 0x55, 0x8f, 0x51, 0x0e, 0x82, 0x30, 0x0c, 0x86, 0xdf, 0x3d,
+      0x45, 0xd3, 0x0b, 0x8c, 0x17, 0x8d, 0x26, 0x1b, 0xa7, 0xf0, 0x02, 0x05, 0x8a, 0x34, 0xc0, 0x46,
+      0xba, 0x29, 0xea, 0xe9, 0x1d, 0x60, 0x8c, 0xbc, 0x34, 0xfd, 0x9b, 0xff, 0xff, 0xda, 0xda, 0xd8,
+      0xd1, 0xc4, 0x40, 0x71, 0xe2, 0x3a, 0x39, 0x7c, 0x90, 0x0a, 0x55, 0x03, 0x23, 0x74, 0x0e, 0x4f,
+      0x05, 0x82, 0xa7, 0x91, 0x1d, 0x5e, 0x59, 0x47, 0xf1, 0x94, 0x82, 0x22, 0xc4, 0xa4, 0xa1, 0xe7,
+      0x59, 0x9a, 0x94, 0x2d, 0xe2, 0x3b, 0x56, 0x49, 0x08, 0xb3, 0xc3, 0xcb, 0x19, 0xcb, 0x03, 0x80,
+      0xad, 0xa8, 0xee, 0x6f, 0x1a, 0xee, 0xbe, 0x59, 0x64, 0x1e, 0xac, 0xbd, 0x66, 0x3e, 0x90, 0xd6,
+      0x51, 0xde, 0x19, 0x78, 0x2c, 0x7e, 0x1b, 0xb6, 0x24, 0x3c, 0x1d, 0x66, 0xf1, 0x5a, 0xaa, 0x59,
+      0x31, 0x66, 0xcf, 0xb1, 0x6d, 0x50, 0xde, 0x61, 0x5b, 0x19, 0x86, 0xed, 0x98, 0x6f, 0xe0, 0xdf,
+      0x61, 0xcd, 0xfa, 0x58, 0xf9, 0x01, 0xb5, 0x52, 0xc1, 0x6e, 0xc2, 0x30, 0x0c, 0xbd, 0xf3, 0x15,
+      0x96, 0xef, 0x55, 0xca, 0xd0, 0xa6, 0x4d, 0x4a, 0x38, 0xf1, 0x23, 0x6e, 0x71, 0xdb, 0x88, 0x90,
+      0x54, 0x4e, 0x46, 0xbb, 0xbf, 0x5f, 0x4a, 0x61, 0xa3, 0xd2, 0x90, 0x38, 0x8c, 0x53, 0x9e, 0xfd,
+      0x9e, 0xfc, 0xec, 0xa7, 0xe8, 0xd8, 0x51, 0xcf, 0x40, 0xb1, 0xe7, 0x3a, 0x19, 0x3c, 0x91, 0x58,
+      0xaa, 0x1c, 0x23, 0x74, 0x06, 0x3f, 0x5e, 0x11, 0x3c, 0x1d, 0xd9, 0xe0, 0x8e, 0x12, 0x55, 0x14,
+      0x73, 0x3b, 0x26, 0x09, 0x07, 0x1e, 0xec, 0x3e, 0x65, 0x81, 0xf5, 0x1d, 0x8b, 0x4d, 0x08, 0x83,
+      0xc1, 0xb7, 0x12, 0xb7, 0x2b, 0x00, 0x5d, 0x51, 0x7d, 0x68, 0x25, 0x7c, 0xfa, 0xfd, 0x54, 0xe6,
+      0x46, 0x4f, 0xa9, 0x9b, 0x61, 0x2e, 0x8e, 0xe1, 0xc4, 0x30, 0x1a, 0x2c, 0x11, 0xbe, 0x0c, 0xae,
+      0x5f, 0x50, 0xfd, 0x50, 0x24, 0x35, 0x38, 0x92, 0x96, 0x8b, 0x8c, 0x8a, 0xc6, 0x51, 0x7b, 0x96,
+      0x49, 0x56, 0x6f, 0xa6, 0x77, 0xd6, 0x43, 0x1c, 0x98, 0xfb, 0x0b, 0xbd, 0xc6, 0x69, 0x56, 0x76,
+      0x86, 0xb1, 0xa0, 0xd1, 0xc6, 0x42, 0x42, 0xa2, 0x64, 0x83, 0xff, 0xd3, 0xc0, 0x59, 0xcf, 0x57,
+      0x7d, 0xe6, 0xde, 0x37, 0xff, 0x61, 0x7e, 0xdf, 0x7b, 0x31, 0xbf, 0x76, 0x21, 0xf2, 0xa5, 0xd4,
+      0xea, 0x1a, 0x89, 0x56, 0xcb, 0xb4, 0x74, 0x13, 0x84, 0x17, 0xe1, 0x35, 0xd6, 0xb9, 0x39, 0x72,
+      0xf5, 0xfc, 0x38, 0xcb, 0xc7, 0xe3, 0xfc, 0xbd, 0x21, 0xe3, 0x9b, 0x05, 0xb5, 0xba, 0x3d, 0x41,
+      0xab, 0xf3, 0xef, 0xda, 0x7e, 0x03, 0x75, 0x90, 0xc1, 0x0e, 0x82, 0x30, 0x0c, 0x86, 0xef, 0x3e,
+      0x45, 0xd3, 0x07, 0x70, 0x68, 0x84, 0x68, 0xb2, 0xed, 0xe2, 0x93, 0x0c, 0x28, 0x6e, 0x61, 0x6c,
+      0x64, 0x9b, 0xa0, 0x6f, 0xef, 0x80, 0x8b, 0x1c, 0x38, 0x35, 0xfd, 0xfe, 0xfe, 0xe9, 0xdf, 0xf2,
+      0xa8, 0xd5, 0x48, 0xa0, 0xe2, 0x48, 0x4d, 0x12, 0x38, 0xa9, 0x60, 0x54, 0x6d, 0x09, 0x41, 0x0b,
+      0xac, 0x0a, 0x04, 0xa7, 0x06, 0x12, 0xf8, 0x54, 0xa1, 0x45, 0x88, 0x29, 0xf8, 0x9e, 0x66, 0xd3,
+      0xa6, 0x2c, 0x1a, 0xa7, 0x29, 0x98, 0x84, 0x30, 0x0b, 0x7c, 0xdc, 0x51, 0x9e, 0x00, 0x78, 0xad,
+      0x9a, 0xfe, 0x15, 0xfc, 0xdb, 0xb5, 0x4b, 0x9b, 0xc1, 0xa8, 0x92, 0x96, 0x7c, 0xf0, 0x13, 0xc1,
+      0x47, 0xe0, 0xf5, 0x76, 0x2e, 0x11, 0xbe, 0x02, 0x0b, 0x64, 0x92, 0x5b, 0xe3, 0x56, 0x9a, 0xcd,
+      0x47, 0xac, 0xda, 0xc1, 0xe2, 0x90, 0x5d, 0xca, 0x85, 0x35, 0xd6, 0x47, 0xca, 0x95, 0xad, 0x5b,
+      0x97, 0x3c, 0x6c, 0x1f, 0x88, 0x77, 0x3e, 0xd0, 0x2e, 0x5f, 0x67, 0xac, 0xdd, 0xae, 0x62, 0x9b,
+      0xe1, 0x7f, 0x82, 0xb3, 0xf5, 0x37, 0xf2, 0x07, 0x6d, 0x90, 0x4b, 0x0e, 0x83, 0x30, 0x0c, 0x44,
+      0xf7, 0x3d, 0x85, 0xe5, 0x0b, 0x04, 0xb5, 0x12, 0x08, 0x29, 0xc9, 0x19, 0x7a, 0x05, 0x03, 0xa6,
+      0x44, 0x84, 0x24, 0x0a, 0x29, 0xb4, 0xb7, 0x2f, 0x9f, 0x2e, 0x8a, 0xca, 0xca, 0xf2, 0xd3, 0xcc,
+      0x68, 0x6c, 0x39, 0x76, 0x14, 0x18, 0x68, 0x0c, 0x5c, 0x27, 0x85, 0x13, 0x45, 0x43, 0x95, 0x65,
+      0x84, 0x4e, 0x61, 0x9e, 0x21, 0x38, 0x1a, 0x58, 0xe1, 0x3d, 0x72, 0xa0, 0x48, 0xc9, 0x78, 0x87,
+      0x30, 0xa6, 0xe8, 0x7b, 0x9e, 0x4d, 0x93, 0x16, 0x8d, 0x71, 0x1d, 0x47, 0x93, 0x10, 0x66, 0x85,
+      0x65, 0x81, 0xfa, 0x02, 0x20, 0x2b, 0xaa, 0xfb, 0x47, 0xf4, 0x4f, 0xd7, 0xac, 0xeb, 0x02, 0x02,
+      0xa5, 0x4e, 0xcb, 0xc1, 0x4f, 0x0c, 0x2f, 0x85, 0x4b, 0xea, 0x5b, 0xe1, 0x2d, 0x43, 0xa1, 0xa5,
+      0x35, 0x6e, 0x63, 0xd7, 0x1d, 0x1e, 0x58, 0x51, 0xfc, 0xb3, 0xb2, 0x38, 0x31, 0x7f, 0x85, 0xf9,
+      0x59, 0xe2, 0x0e, 0x6b, 0xeb, 0x47, 0x5e, 0xa6, 0xd8, 0x9a, 0xac, 0x1d, 0xc5, 0xb1, 0xa4, 0x6c,
+      0x7d, 0xe4, 0x43, 0xe7, 0xd6, 0x58, 0xbb, 0x5f, 0x2a, 0x76, 0xc3, 0xaf, 0x42, 0x8a, 0xed, 0x6d,
+      0xfa, 0x03, 0x65, 0x90, 0x41, 0x0e, 0x83, 0x30, 0x0c, 0x04, 0xef, 0x7d, 0x85, 0xe5, 0x07, 0x10,
+      0x2a, 0xb5, 0x14, 0xa4, 0x24, 0xa7, 0x7e, 0xc4, 0x80, 0x29, 0x11, 0x81, 0xa0, 0x90, 0x42, 0xfb,
+      0xfb, 0x42, 0xb8, 0x80, 0x7a, 0xb2, 0x3c, 0xeb, 0x95, 0xd7, 0x96, 0x53, 0x4b, 0x23, 0x03, 0x4d,
+      0x23, 0x57, 0x41, 0xe1, 0x4c, 0xde, 0x50, 0x69, 0x19, 0xa1, 0x55, 0x98, 0xa5, 0xc9, 0x1d, 0x61,
+      0xa0, 0x9e, 0x15, 0x3e, 0x29, 0x10, 0xc2, 0x14, 0xbc, 0xeb, 0x78, 0x31, 0x75, 0x58, 0x65, 0x33,
+      0xb4, 0xec, 0x4d, 0x40, 0x58, 0x14, 0x16, 0x39, 0xea, 0x0b, 0x80, 0x2c, 0xa9, 0xea, 0x5e, 0xde,
+      0xbd, 0x87, 0x7a, 0x6b, 0x57, 0x30, 0x52, 0x68, 0xb5, 0xec, 0xdd, 0xcc, 0xf0, 0x51, 0x78, 0x2d,
+      0x92, 0x0c, 0xe1, 0xab, 0x30, 0x45, 0xa1, 0xa5, 0x35, 0x43, 0xa4, 0xab, 0xf9, 0x8f, 0x3d, 0xf2,
+      0xe4, 0x16, 0x69, 0x0c, 0x71, 0x10, 0xd2, 0x13, 0xad, 0xac, 0x9b, 0x78, 0xad, 0x22, 0xee, 0xd9,
+      0x12, 0x88, 0x73, 0x04, 0xd9, 0x38, 0xcf, 0xa7, 0x44, 0x8d, 0xb1, 0x76, 0xbf, 0x43, 0xec, 0x86,
+      0xe3, 0x84, 0x14, 0xf1, 0x1f, 0xfa, 0x07, 0x7d, 0x91, 0xdd, 0x6e, 0xc3, 0x20, 0x0c, 0x85, 0xef,
+      0xf7, 0x14, 0x96, 0xef, 0x23, 0x52, 0x4d, 0xaa, 0x32, 0x09, 0x7a, 0xb5, 0x17, 0x71, 0x53, 0x27,
+      0x41, 0xa5, 0x80, 0x0c, 0x6b, 0xd2, 0xb7, 0x1f, 0xcb, 0x4f, 0xd5, 0x68, 0xd3, 0xee, 0x7c, 0xf8,
+      0xcc, 0xc1, 0x1c, 0xeb, 0x34, 0x50, 0x64, 0xa0, 0x14, 0xb9, 0xcd, 0x06, 0xef, 0x24, 0x96, 0xce,
+      0x8e, 0x11, 0x06, 0x83, 0xc7, 0x1a, 0xc1, 0xd3, 0x8d, 0x0d, 0x7e, 0xda, 0x14, 0x1d, 0x3d, 0x10,
+      0x52, 0x96, 0x70, 0xe5, 0xd1, 0x5e, 0x72, 0xe1, 0xd6, 0x0f, 0x2c, 0x36, 0x23, 0x8c, 0x06, 0x3f,
+      0x1a, 0x3c, 0xbd, 0x01, 0xe8, 0x33, 0xb5, 0xd7, 0x5e, 0xc2, 0x97, 0xbf, 0xfc, 0xc8, 0x72, 0x10,
+      0x29, 0x0f, 0x4b, 0x59, 0xc4, 0x2d, 0xdc, 0x19, 0x26, 0x83, 0xc5, 0xf8, 0x61, 0xf0, 0xbd, 0x46,
+      0xf5, 0x44, 0xce, 0xfa, 0x19, 0x1d, 0x9a, 0x99, 0xfd, 0x85, 0x9a, 0xfa, 0x17, 0x22, 0x69, 0xc1,
+      0x91, 0xf4, 0x5c, 0x95, 0xaa, 0xea, 0x1c, 0xf5, 0xb3, 0xb9, 0xac, 0x46, 0xb2, 0xbc, 0x02, 0x69,
+      0x64, 0x8e, 0x2b, 0x3e, 0xe0, 0xe6, 0x35, 0x55, 0x34, 0xd9, 0x54, 0x49, 0xc8, 0x94, 0x6d, 0xf0,
+      0xdb, 0x58, 0xc7, 0x7f, 0xc6, 0xda, 0xb1, 0xd6, 0x85, 0xc4, 0xab, 0xd4, 0x6a, 0xfb, 0xa8, 0x56,
+      0xfb, 0x0c, 0x74, 0x17, 0x84, 0x77, 0x91, 0x74, 0xd6, 0xb9, 0x25, 0x48, 0xb5, 0x5c, 0x78, 0xed,
+      0xd0, 0x6a, 0xde, 0xc8, 0xe9, 0x1b, 0x75, 0x90, 0x31, 0x0e, 0xc3, 0x20, 0x0c, 0x45, 0xf7, 0x9e,
+      0x02, 0xb1, 0x57, 0x54, 0x8a, 0x94, 0x09, 0xb8, 0x42, 0xa5, 0xde, 0xc0, 0x21, 0x26, 0xa0, 0x10,
+      0x40, 0x40, 0x93, 0xf6, 0xf6, 0x25, 0x64, 0x49, 0x86, 0x2e, 0xb6, 0xfc, 0xf4, 0x6d, 0x7f, 0x9b,
+      0x67, 0x03, 0x11, 0x09, 0xe4, 0x88, 0xaa, 0x08, 0xba, 0x42, 0xb2, 0x30, 0x38, 0xa4, 0xc4, 0x08,
+      0xda, 0x3f, 0x28, 0xf1, 0xb0, 0xa0, 0xa0, 0x4f, 0xad, 0xef, 0x11, 0x26, 0x24, 0x2f, 0xd4, 0x98,
+      0xd0, 0xab, 0x2a, 0xc8, 0x25, 0x85, 0x19, 0x37, 0x3b, 0x96, 0x2a, 0xb5, 0xde, 0x60, 0xb2, 0x85,
+      0x92, 0xad, 0xb5, 0xc9, 0x1b, 0x21, 0x7c, 0x00, 0x35, 0x4f, 0x29, 0xbc, 0xfd, 0xb8, 0x97, 0x15,
+      0x44, 0x28, 0x46, 0xf2, 0x25, 0xac, 0x48, 0x3e, 0x82, 0xd6, 0xe1, 0xdf, 0x3d, 0x32, 0xc9, 0x9d,
+      0xf5, 0x0d, 0xf5, 0xff, 0x59, 0x77, 0x81, 0xdd, 0x01, 0xfb, 0x0b, 0x3c, 0x0b, 0x95, 0x0b, 0x19,
+      0x6b, 0x66, 0x6d, 0xe7, 0xee, 0x86, 0x5d, 0xed, 0x70, 0x1d, 0x12, 0x5e, 0xdc, 0x69, 0xeb, 0xdc,
+      0x71, 0x13, 0x3b, 0x1a, 0xce, 0x0a, 0xce, 0xda, 0x9f, 0xe4, 0x0f, 0x75, 0x8f, 0x31, 0x0e, 0xc2,
+      0x30, 0x0c, 0x45, 0x77, 0x4e, 0x61, 0xf9, 0x02, 0x09, 0x43, 0x3b, 0x25, 0x91, 0x38, 0x8a, 0xa1,
+      0x86, 0x44, 0xb4, 0x4e, 0x95, 0x9a, 0xb6, 0xdc, 0x9e, 0x92, 0x2e, 0x65, 0x60, 0xfc, 0x4f, 0x5f,
+      0x7e, 0xfe, 0x6e, 0x8a, 0x34, 0x32, 0xd0, 0x34, 0xf2, 0x4d, 0x3d, 0xce, 0x54, 0x12, 0x5d, 0x7b,
+      0x46, 0x88, 0x1e, 0x5b, 0x8b, 0x20, 0x34, 0xb0, 0xc7, 0x8b, 0x48, 0x56, 0xd2, 0x94, 0x05, 0xce,
+      0x08, 0x93, 0x96, 0xfc, 0xe4, 0x25, 0x75, 0xba, 0x95, 0x92, 0x44, 0x2e, 0x49, 0x11, 0x16, 0x8f,
+      0x8d, 0xc5, 0x70, 0x02, 0x70, 0xf7, 0x5c, 0xf8, 0x51, 0xf2, 0x4b, 0xba, 0x6f, 0xdc, 0xc0, 0x48,
+      0x1a, 0x83, 0x1b, 0xf2, 0xcc, 0xb0, 0xd6, 0x1a, 0xbc, 0x3d, 0x5a, 0x34, 0xc1, 0xf5, 0x49, 0x2a,
+      0xfb, 0x8b, 0xda, 0x1f, 0xd6, 0x1c, 0xa1, 0xa9, 0x67, 0x77, 0xc3, 0xfe, 0x93, 0xa9, 0x7a, 0x73,
+      0xf4, 0x3b, 0x53, 0x17, 0x86, 0x0f, 0x65, 0x90, 0x51, 0x0e, 0x83, 0x30, 0x08, 0x86, 0xdf, 0x77,
+      0x0a, 0xc2, 0x01, 0xec, 0x96, 0x2c, 0x4e, 0x93, 0xd6, 0x1b, 0x2c, 0x3b, 0x03, 0x2a, 0xce, 0xc6,
+      0xda, 0x9a, 0x5a, 0x75, 0xbb, 0xfd, 0xaa, 0xbe, 0x68, 0xf6, 0x02, 0xe1, 0x0b, 0x3f, 0x3f, 0x20,
+      0xc7, 0x96, 0x06, 0x06, 0x1a, 0x07, 0xae, 0x82, 0xc2, 0x99, 0xbc, 0xa6, 0xd2, 0x30, 0x42, 0xab,
+      0x30, 0xbd, 0x22, 0x58, 0xea, 0x59, 0xe1, 0x93, 0xec, 0x44, 0x06, 0x5e, 0x03, 0x7b, 0x0a, 0xda,
+      0x59, 0x84, 0x31, 0x78, 0xd7, 0xf1, 0xa2, 0xeb, 0x10, 0x1b, 0xb5, 0x6d, 0xd9, 0xeb, 0x80, 0xb0,
+      0x28, 0xcc, 0x33, 0x2c, 0x2e, 0x00, 0xb2, 0xa4, 0xaa, 0x7b, 0x7b, 0x37, 0xd9, 0x7a, 0x2d, 0x23,
+      0x18, 0x28, 0xb4, 0x85, 0xec, 0xdd, 0xcc, 0xf0, 0x51, 0x18, 0x47, 0x7f, 0xd7, 0x28, 0x0a, 0x69,
+      0xb4, 0xdd, 0x50, 0x54, 0xfe, 0xb1, 0x47, 0x96, 0xdc, 0x37, 0x9a, 0x9e, 0xf0, 0x2d, 0x4f, 0xd2,
+      0x03, 0xae, 0x8c, 0x1b, 0x39, 0x66, 0xb1, 0x79, 0xac, 0xee, 0xe2, 0x6c, 0x2f, 0x1b, 0xe7, 0xf9,
+      0xb4, 0x4d, 0xa3, 0x8d, 0xd9, 0x6f, 0x10, 0xbb, 0xe0, 0xd8, 0x21, 0xc5, 0xf6, 0x95, 0xe2, 0x07,
+      0x65, 0x90, 0x4d, 0x12, 0xc2, 0x20, 0x0c, 0x85, 0xf7, 0x9e, 0x22, 0x93, 0x0b, 0xe0, 0x52, 0x67,
+      0x80, 0x8d, 0x27, 0x49, 0xdb, 0x54, 0x18, 0x29, 0x74, 0x00, 0x5b, 0xbd, 0xbd, 0xfc, 0x6c, 0xac,
+      0x6e, 0x92, 0xc9, 0x97, 0x97, 0xbc, 0x4c, 0x64, 0x32, 0xb4, 0x32, 0x50, 0x5a, 0x79, 0xcc, 0x0a,
+      0x37, 0x8a, 0x96, 0x06, 0xc7, 0x08, 0x46, 0xe1, 0xf5, 0x82, 0xe0, 0x69, 0x61, 0x85, 0xb7, 0xe0,
+      0x1c, 0xe5, 0x42, 0x53, 0x8e, 0xe1, 0xc1, 0xbb, 0x9d, 0x72, 0xe9, 0x5b, 0x6f, 0x38, 0xda, 0x8c,
+      0xb0, 0x37, 0xad, 0x3e, 0x01, 0xc8, 0x81, 0xc6, 0xc7, 0x3d, 0x86, 0xa7, 0x9f, 0x6a, 0x59, 0xc0,
+      0x4a, 0xd9, 0x68, 0xb9, 0x84, 0x8d, 0xe1, 0xa5, 0xf0, 0x8c, 0xf0, 0xae, 0x51, 0x68, 0xe9, 0xac,
+      0x6f, 0xa8, 0xba, 0xfc, 0xb2, 0x2e, 0x2b, 0x9d, 0x7f, 0x5d, 0x87, 0xa3, 0x0b, 0x89, 0x4b, 0x16,
+      0x6d, 0x7d, 0x35, 0x16, 0x47, 0x67, 0x39, 0x87, 0xc8, 0x87, 0x43, 0x66, 0xeb, 0x5c, 0x3f, 0x5f,
+      0xf4, 0x81, 0x6f, 0x85, 0x14, 0xed, 0x0f, 0xfa, 0x03, 0x85, 0x90, 0x51, 0x0e, 0x82, 0x30, 0x0c,
+      0x86, 0xdf, 0x3d, 0x45, 0xb3, 0x03, 0x30, 0x34, 0x21, 0xc4, 0x64, 0xf0, 0xe8, 0x05, 0x3c, 0xc1,
+      0x84, 0x02, 0x0d, 0x63, 0x23, 0x63, 0x08, 0xde, 0x5e, 0xd8, 0x34, 0x48, 0x4c, 0xf4, 0xa5, 0x69,
+      0xfb, 0xf7, 0xff, 0x9a, 0x56, 0x0c, 0x8d, 0xec, 0x11, 0xe4, 0xd0, 0x63, 0xe1, 0x32, 0x56, 0xd1,
+      0x8c, 0x25, 0x83, 0x26, 0x63, 0x69, 0xcc, 0x40, 0xcb, 0x0e, 0x33, 0x76, 0x1d, 0xbb, 0x8e, 0x74,
+      0x0d, 0x97, 0x51, 0x17, 0x8e, 0x8c, 0x66, 0x30, 0x38, 0x6b, 0x5a, 0x9c, 0xa8, 0x74, 0xcb, 0x20,
+      0xe9, 0x06, 0x2d, 0x39, 0x06, 0x93, 0x37, 0xe5, 0x07, 0x00, 0x71, 0x93, 0x45, 0x5b, 0x5b, 0x33,
+      0xea, 0x72, 0x2d, 0x97, 0x06, 0x2a, 0x45, 0xfd, 0x80, 0x6f, 0x70, 0x18, 0x85, 0x39, 0x63, 0x4b,
+      0x7c, 0xac, 0x91, 0x7b, 0x1f, 0xdf, 0x1b, 0x45, 0x65, 0x2c, 0xee, 0x38, 0x15, 0x29, 0x15, 0xb6,
+      0xf3, 0x57, 0xa7, 0x97, 0xae, 0xc9, 0x45, 0x67, 0xee, 0xb8, 0xe2, 0x8e, 0x71, 0x74, 0x4a, 0x3c,
+      0x32, 0x64, 0x3c, 0x17, 0x8a, 0xb4, 0x97, 0x92, 0x73, 0x94, 0x06, 0x29, 0x64, 0x8b, 0xc4, 0xbd,
+      0x39, 0x70, 0x7e, 0x51, 0x37, 0xeb, 0x17, 0x75, 0x5b, 0xf8, 0x8f, 0x2a, 0xf8, 0xe7, 0x35, 0x82,
+      0xfb, 0xc7, 0xe7, 0x4f, 0x85, 0x91, 0x6d, 0x0e, 0x82, 0x30, 0x0c, 0x86, 0xff, 0x7b, 0x8a, 0xa5,
+      0x17, 0x18, 0x46, 0x25, 0x90, 0x6c, 0x9c, 0xc2, 0x0b, 0x0c, 0x28, 0x6e, 0x61, 0x6c, 0x64, 0x9b,
+      0xa0, 0xb7, 0x17, 0x99, 0x1a, 0x89, 0xa8, 0xff, 0xfa, 0xf6, 0xe9, 0x47, 0xfa, 0x96, 0x79, 0x29,
+      0x7a, 0x24, 0xc2, 0xf7, 0x58, 0x05, 0x0e, 0x83, 0x70, 0x4a, 0x94, 0x1a, 0x81, 0x48, 0x0e, 0x69,
+      0x02, 0xc4, 0x88, 0x0e, 0x39, 0x1c, 0x9d, 0x30, 0xbe, 0x41, 0x07, 0xc4, 0x07, 0x67, 0x5b, 0x1c,
+      0x55, 0x1d, 0xa6, 0x02, 0x65, 0x24, 0x3a, 0x15, 0x80, 0x8c, 0x1c, 0xf2, 0x0c, 0x8a, 0x0d, 0x21,
+      0xac, 0x14, 0x55, 0x7b, 0x72, 0xf6, 0x6c, 0xea, 0xbb, 0x9c, 0x12, 0xbd, 0x08, 0x32, 0x86, 0x93,
+      0xe8, 0xec, 0x80, 0xe4, 0xc2, 0x61, 0x9a, 0x7c, 0xe5, 0xb0, 0x3d, 0x00, 0x7d, 0x21, 0xad, 0xcc,
+      0x8c, 0xd2, 0xec, 0x2f, 0x4b, 0x56, 0x50, 0x1e, 0xd1, 0x2e, 0xf9, 0xde, 0x96, 0xfe, 0x60, 0xfb,
+      0xb5, 0x75, 0xc9, 0x27, 0xaa, 0xb4, 0xf5, 0xf8, 0x90, 0x8c, 0x3e, 0x6f, 0x63, 0x74, 0x79, 0x36,
+      0x6b, 0xac, 0xc3, 0x85, 0x0b, 0x8d, 0xd2, 0x3a, 0x7a, 0x47, 0x63, 0xc3, 0x7b, 0x05, 0xa3, 0xf3,
+      0x17, 0x8a, 0x1b, 0x7d, 0x90, 0xcd, 0x0e, 0xc2, 0x20, 0x0c, 0xc7, 0xef, 0x3e, 0x45, 0xd3, 0x17,
+      0x00, 0x97, 0x70, 0x03, 0x12, 0x1f, 0xa5, 0xba, 0x2a, 0xc4, 0x0d, 0x16, 0x86, 0x9b, 0xbe, 0xbd,
+      0x1b, 0xec, 0xb0, 0xc3, 0xf4, 0xd8, 0x5f, 0xfa, 0xff, 0x68, 0xf5, 0xe8, 0x68, 0x60, 0xa0, 0x71,
+      0xe0, 0x5b, 0x36, 0x38, 0x51, 0xf2, 0x74, 0xed, 0x18, 0xc1, 0x19, 0x3c, 0x4b, 0x89, 0x10, 0xa8,
+      0x67, 0x83, 0x97, 0x10, 0x62, 0xa6, 0xec, 0x63, 0x80, 0x06, 0x61, 0xcc, 0x29, 0x3e, 0x79, 0xf6,
+      0x6d, 0x5e, 0xb6, 0x7c, 0x70, 0x9c, 0x7c, 0x46, 0x98, 0x0d, 0x2a, 0x89, 0xf6, 0x04, 0xa0, 0xef,
+      0x31, 0xf1, 0x23, 0xc5, 0x57, 0x68, 0xd7, 0x71, 0x01, 0x03, 0x65, 0x67, 0x75, 0x1f, 0x27, 0x86,
+      0x77, 0x59, 0x83, 0x8f, 0x41, 0x89, 0xc2, 0xea, 0xce, 0x87, 0xc2, 0x1a, 0xf5, 0x93, 0xad, 0x3d,
+      0x76, 0x74, 0x53, 0x6f, 0x54, 0x14, 0xeb, 0x9a, 0x52, 0x7b, 0x89, 0xc3, 0xcc, 0x2a, 0x52, 0x47,
+      0xfe, 0xea, 0x9f, 0x91, 0x16, 0xfb, 0x63, 0xb4, 0x28, 0xff, 0xb2, 0x5f
+    };
+  }
+}
@@ -0,0 +1,122 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <map>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "DRAWIOGeometryStore.h"
+#include "MXCell.h"
+
+namespace test
+{
+
+using libdrawio::MXCell;
+using libdrawio::ShapeFrame;
+using librevenge::RVNGString;
+
+namespace
+{
+
+const double EPSILON = 1e-9;
+
+// reads the cell into the store and the map, as the parser does
+void read(libdrawio::DRAWIOGeometryStore &store, std::map<RVNGString, MXCell> &cells,
+          const char *id, const char *parent, const double x, const double y)
+{
+  MXCell cell;
+  cell.id = id;
+  cell.parent_id = parent;
+  cell.vertex = true;
+  cell.geometry.x = x;
+  cell.geometry.y = y;
+  cell.geometry.width = 40;
+  cell.geometry.height = 20;
+  store.append(cell, cells);
+  cells[id] = cell;
+}
+
+void assertFrame(const ShapeFrame &frame, const double expectedX, const double expectedY)
+{
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedX, frame.x, EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedY, frame.y, EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, frame.width, EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, frame.height, EPSILON);
+}
+
+}
+
+class GeometryStoreTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp() override;
+  virtual void tearDown() override;
+
+private:
+  CPPUNIT_TEST_SUITE(GeometryStoreTest);
+  CPPUNIT_TEST(testParentFirst);
+  CPPUNIT_TEST(testChildFirst);
+  CPPUNIT_TEST(testMissingParent);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testParentFirst();
+  void testChildFirst();
+  void testMissingParent();
+};
+
+void GeometryStoreTest::setUp()
+{
+}
+
+void GeometryStoreTest::tearDown()
+{
+}
+
+void GeometryStoreTest::testParentFirst()
+{
+  libdrawio::DRAWIOGeometryStore store;
+  std::map<RVNGString, MXCell> cells;
+  read(store, cells, "p", "1", 100, 200);
+  read(store, cells, "a", "p", 10, 20);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), store.size());
+  assertFrame(store.getFrame(0), 1, 2);
+  assertFrame(store.getFrame(1), 1.1, 2.2);
+}
+
+void GeometryStoreTest::testChildFirst()
+{
+  // other tools need not write a container before its children
+  libdrawio::DRAWIOGeometryStore store;
+  std::map<RVNGString, MXCell> cells;
+  read(store, cells, "a", "p", 10, 20);
+  read(store, cells, "b", "p", 30, 40);
+  read(store, cells, "c", "1", 50, 60);
+  read(store, cells, "p", "1", 100, 200);
+  CPPUNIT_ASSERT_EQUAL(size_t(4), store.size());
+  assertFrame(store.getFrame(0), 1.1, 2.2);
+  assertFrame(store.getFrame(1), 1.3, 2.4);
+  assertFrame(store.getFrame(2), 0.5, 0.6);
+  assertFrame(store.getFrame(3), 1, 2);
+}
+
+void GeometryStoreTest::testMissingParent()
+{
+  libdrawio::DRAWIOGeometryStore store;
+  std::map<RVNGString, MXCell> cells;
+  read(store, cells, "a", "p", 10, 20);
+  assertFrame(store.getFrame(0), 0.1, 0.2);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GeometryStoreTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,209 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmath>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "DRAWIOPerimeter.h"
+
+namespace test
+{
+
+using libdrawio::MXPoint;
+using libdrawio::PerimeterShape;
+using libdrawio::ShapeTurn;
+
+namespace
+{
+
+const double EPSILON = 1e-9;
+
+void assertProjection(const libdrawio::Perimeter perimeter, const double size,
+                      const double x, const double y, const double expectedX, const double expectedY)
+{
+  const PerimeterShape shape = { perimeter, size };
+  const MXPoint point = libdrawio::projectOnPerimeter(shape, MXPoint(x, y));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedX, point.x, EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedY, point.y, EPSILON);
+}
+
+void assertExit(const MXPoint &point, const double expectedX, const double expectedY)
+{
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedX, point.x, EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedY, point.y, EPSILON);
+}
+
+}
+
+class PerimeterTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp() override;
+  virtual void tearDown() override;
+
+private:
+  CPPUNIT_TEST_SUITE(PerimeterTest);
+  CPPUNIT_TEST(testRectangle);
+  CPPUNIT_TEST(testEllipse);
+  CPPUNIT_TEST(testTriangle);
+  CPPUNIT_TEST(testCallout);
+  CPPUNIT_TEST(testRhombus);
+  CPPUNIT_TEST(testParallelogram);
+  CPPUNIT_TEST(testHexagon);
+  CPPUNIT_TEST(testStep);
+  CPPUNIT_TEST(testTrapezoid);
+  CPPUNIT_TEST(testBatch);
+  CPPUNIT_TEST(testBoxExit);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testRectangle();
+  void testEllipse();
+  void testTriangle();
+  void testCallout();
+  void testRhombus();
+  void testParallelogram();
+  void testHexagon();
+  void testStep();
+  void testTrapezoid();
+  void testBatch();
+  void testBoxExit();
+};
+
+void PerimeterTest::setUp()
+{
+}
+
+void PerimeterTest::tearDown()
+{
+}
+
+void PerimeterTest::testRectangle()
+{
+  assertProjection(libdrawio::RECTANGLE_P, 0, 1, 0.3, 1, 0.3);
+  assertProjection(libdrawio::RECTANGLE_P, 0, 0, 0, 0, 0);
+}
+
+void PerimeterTest::testEllipse()
+{
+  const double d = 0.5 / std::sqrt(2.);
+  assertProjection(libdrawio::ELLIPSE_P, 0, 1, 1, 0.5 + d, 0.5 + d);
+  assertProjection(libdrawio::ELLIPSE_P, 0, 0, 0, 0.5 - d, 0.5 - d);
+  assertProjection(libdrawio::ELLIPSE_P, 0, 0.5, 0, 0.5, 0);
+  assertProjection(libdrawio::ELLIPSE_P, 0, 1, 0.5, 1, 0.5);
+}
+
+void PerimeterTest::testTriangle()
+{
+  assertProjection(libdrawio::TRIANGLE_P, 0, 1, 0, 2. / 3, 1. / 3);
+  assertProjection(libdrawio::TRIANGLE_P, 0, 1, 1, 2. / 3, 2. / 3);
+  assertProjection(libdrawio::TRIANGLE_P, 0, 0, 0.2, 0, 0.2);
+  assertProjection(libdrawio::TRIANGLE_P, 0, 1, 0.5, 1, 0.5);
+}
+
+void PerimeterTest::testCallout()
+{
+  // on the box above the pointer, seen from its center
+  assertProjection(libdrawio::CALLOUT_P, 0.2, 0.5, 1, 0.5, 0.8);
+  assertProjection(libdrawio::CALLOUT_P, 0.2, 1, 1, 5. / 6, 0.8);
+  assertProjection(libdrawio::CALLOUT_P, 0.2, 1, 0.4, 1, 0.4);
+  assertProjection(libdrawio::CALLOUT_P, 0.2, 0, 0, 0, 0);
+  // with no pointer the box is the outline
+  assertProjection(libdrawio::CALLOUT_P, 0, 1, 1, 1, 1);
+}
+
+void PerimeterTest::testRhombus()
+{
+  assertProjection(libdrawio::RHOMBUS_P, 0, 1, 0, 0.75, 0.25);
+  assertProjection(libdrawio::RHOMBUS_P, 0, 0, 0, 0.25, 0.25);
+  assertProjection(libdrawio::RHOMBUS_P, 0, 0.5, 1, 0.5, 1);
+}
+
+void PerimeterTest::testParallelogram()
+{
+  assertProjection(libdrawio::PARALLELOGRAM_P, 0.2, 0, 0, 1. / 6, 1. / 6);
+  assertProjection(libdrawio::PARALLELOGRAM_P, 0.2, 1, 1, 5. / 6, 5. / 6);
+  assertProjection(libdrawio::PARALLELOGRAM_P, 0.2, 0.7, 0, 0.7, 0);
+  assertProjection(libdrawio::PARALLELOGRAM_P, 0, 0, 0, 0, 0);
+}
+
+void PerimeterTest::testHexagon()
+{
+  assertProjection(libdrawio::HEXAGON_P, 0.25, 0, 0, 1. / 6, 1. / 6);
+  assertProjection(libdrawio::HEXAGON_P, 0.25, 1, 1, 5. / 6, 5. / 6);
+  assertProjection(libdrawio::HEXAGON_P, 0.25, 0, 0.5, 0, 0.5);
+  assertProjection(libdrawio::HEXAGON_P, 0.25, 0.5, 0, 0.5, 0);
+}
+
+void PerimeterTest::testStep()
+{
+  assertProjection(libdrawio::STEP_P, 0.25, 0, 0.5, 0.25, 0.5);
+  assertProjection(libdrawio::STEP_P, 0.25, 1, 0.5, 1, 0.5);
+  assertProjection(libdrawio::STEP_P, 0.25, 0, 0.25, 1. / 6, 1. / 3);
+  assertProjection(libdrawio::STEP_P, 0.25, 0, 0, 0, 0);
+  // the notch holds the center
+  assertProjection(libdrawio::STEP_P, 0.75, 0, 0.3, 0.5, 0.5);
+}
+
+void PerimeterTest::testTrapezoid()
+{
+  assertProjection(libdrawio::TRAPEZOID_P, 0.2, 0, 0, 1. / 6, 1. / 6);
+  assertProjection(libdrawio::TRAPEZOID_P, 0.2, 1, 0, 5. / 6, 1. / 6);
+  assertProjection(libdrawio::TRAPEZOID_P, 0.2, 0.3, 1, 0.3, 1);
+}
+
+void PerimeterTest::testBatch()
+{
+  const PerimeterShape shapes[] =
+  {
+    { libdrawio::ELLIPSE_P, 0 },
+    { libdrawio::TRIANGLE_P, 0 },
+    { libdrawio::STEP_P, 0.25 },
+    { libdrawio::HEXAGON_P, 0.25 }
+  };
+  MXPoint points[] = { MXPoint(1, 1), MXPoint(1, 0), MXPoint(0, 0.25), MXPoint(0, 0) };
+  const size_t count = sizeof(points) / sizeof(points[0]);
+  MXPoint expected[count];
+  for (size_t i = 0; i < count; ++i)
+    expected[i] = libdrawio::projectOnPerimeter(shapes[i], points[i]);
+  libdrawio::projectOnPerimeters(shapes, points, count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected[i].x, points[i].x);
+    CPPUNIT_ASSERT_EQUAL(expected[i].y, points[i].y);
+  }
+}
+
+void PerimeterTest::testBoxExit()
+{
+  assertExit(libdrawio::getBoxExit(1, 0, ShapeTurn(libdrawio::EAST, 0)), 1, 0.5);
+  assertExit(libdrawio::getBoxExit(0, -1, ShapeTurn(libdrawio::EAST, 0)), 0.5, 0);
+  assertExit(libdrawio::getBoxExit(2, 1, ShapeTurn(libdrawio::EAST, 0)), 1, 0.75);
+  assertExit(libdrawio::getBoxExit(-1, -3, ShapeTurn(libdrawio::EAST, 0)), 1. / 3, 0);
+  assertExit(libdrawio::getBoxExit(1, 1, ShapeTurn(libdrawio::EAST, 0)), 1, 1);
+  assertExit(libdrawio::getBoxExit(0, 0, ShapeTurn(libdrawio::EAST, 0)), 1, 0.5);
+  // a shape facing south has its front down and its left side east
+  assertExit(libdrawio::getBoxExit(1, 0, ShapeTurn(libdrawio::SOUTH, 0)), 0.5, 0);
+  assertExit(libdrawio::getBoxExit(1, 0, ShapeTurn(libdrawio::EAST, 90)), 0.5, 0);
+  assertExit(libdrawio::getBoxExit(1, 0, ShapeTurn(libdrawio::WEST, 0)), 0, 0.5);
+  assertExit(libdrawio::getBoxExit(1, 0, ShapeTurn(libdrawio::EAST, 45)), 1, 0);
+  // the side is the one the ray heads to in the frame of the shape, so a
+  // ray turned away by the rotation leaves on the far side of the box
+  assertExit(libdrawio::getBoxExit(-1, 0.2, ShapeTurn(libdrawio::EAST, 180)), 1, 0.4);
+  assertExit(libdrawio::getBoxExit(libdrawio::NORTH, ShapeTurn(libdrawio::EAST, 0)), 0.5, 0);
+  assertExit(libdrawio::getBoxExit(libdrawio::WEST, ShapeTurn(libdrawio::NORTH, 0)), 0.5, 0);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PerimeterTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,135 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <map>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "DRAWIOConnections.h"
+#include "MXCell.h"
+
+namespace test
+{
+
+using libdrawio::MXCell;
+using librevenge::RVNGString;
+
+namespace
+{
+
+const double EPSILON = 1e-9;
+
+void addVertex(std::map<RVNGString, MXCell> &cells, const char *id, const char *parent,
+               const double x, const double y, const double width, const double height)
+{
+  MXCell &cell = cells[id];
+  cell.id = id;
+  cell.parent_id = parent;
+  cell.vertex = true;
+  cell.geometry.x = x;
+  cell.geometry.y = y;
+  cell.geometry.width = width;
+  cell.geometry.height = height;
+}
+
+MXCell makeEdge(const char *source, const char *target)
+{
+  MXCell edge;
+  edge.id = "e";
+  edge.parent_id = "1";
+  edge.edge = true;
+  edge.source_id = source;
+  edge.target_id = target;
+  return edge;
+}
+
+void assertPoint(const libdrawio::MXPoint &point, const double expectedX, const double expectedY)
+{
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedX, point.x, EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedY, point.y, EPSILON);
+}
+
+}
+
+class RoutingTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp() override;
+  virtual void tearDown() override;
+
+private:
+  CPPUNIT_TEST_SUITE(RoutingTest);
+  CPPUNIT_TEST(testSameParent);
+  CPPUNIT_TEST(testNested);
+  CPPUNIT_TEST(testNestedFixed);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testSameParent();
+  void testNested();
+  void testNestedFixed();
+
+  std::map<RVNGString, MXCell> m_cells;
+};
+
+void RoutingTest::setUp()
+{
+  // a container at (100, 100) holding a, and b beside it on the page
+  addVertex(m_cells, "p", "1", 100, 100, 200, 100);
+  addVertex(m_cells, "a", "p", 10, 10, 40, 40);
+  addVertex(m_cells, "c", "p", 110, 10, 40, 40);
+  addVertex(m_cells, "b", "1", 300, 0, 40, 40);
+}
+
+void RoutingTest::tearDown()
+{
+  m_cells.clear();
+}
+
+void RoutingTest::testSameParent()
+{
+  libdrawio::DRAWIOConnectionCache connections(m_cells);
+  MXCell edge = makeEdge("a", "c");
+  edge.setEndPoints(connections);
+  assertPoint(edge.geometry.sourcePoint, 150, 130);
+  assertPoint(edge.geometry.targetPoint, 210, 130);
+}
+
+void RoutingTest::testNested()
+{
+  // the slope is taken between the centers on the page, (130, 130) and
+  // (320, 20), not between a in its container and b on the page
+  libdrawio::DRAWIOConnectionCache connections(m_cells);
+  MXCell edge = makeEdge("a", "b");
+  edge.setEndPoints(connections);
+  assertPoint(edge.geometry.sourcePoint, 150, 130 - 20. * 110 / 190);
+  assertPoint(edge.geometry.targetPoint, 300, 20 + 20. * 110 / 190);
+}
+
+void RoutingTest::testNestedFixed()
+{
+  libdrawio::DRAWIOConnectionCache connections(m_cells);
+  MXCell edge = makeEdge("a", "b");
+  edge.style.startFixed = true;
+  edge.style.exitX = 1.;
+  edge.style.exitY = 0.5;
+  edge.style.endFixed = true;
+  edge.style.entryX = 0.;
+  edge.style.entryY = 0.5;
+  edge.setEndPoints(connections);
+  assertPoint(edge.geometry.sourcePoint, 150, 130);
+  assertPoint(edge.geometry.targetPoint, 300, 20);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RoutingTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,181 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libdrawio project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libdrawio/libdrawio.h>
+
+#include "DiagramGenerator.h"
+#include "NullPainter.h"
+
+namespace
+{
+
+// counts every allocation of the test program
+unsigned long allocations = 0;
+unsigned long long allocatedBytes = 0;
+
+}
+
+void *operator new(std::size_t size)
+{
+  ++allocations;
+  allocatedBytes += size;
+  if (void *const ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+namespace test
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+// growth faster than this is taken as a quadratic path creeping in
+const double MAX_EXPONENT = 1.2;
+
+const unsigned SIZES[] = { 1000, 4000, 16000, 64000 };
+const unsigned RUNS = 3;
+
+struct Sample
+{
+  double cells;
+  double time; //< best of the runs, in seconds
+  double allocations;
+  double bytes;
+};
+
+// least squares slope of log(y) over log(x)
+double fitExponent(const std::vector<Sample> &samples, double Sample::*y)
+{
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (const auto &sample : samples)
+  {
+    const double lx = std::log(sample.cells);
+    const double ly = std::log(sample.*y);
+    sx += lx;
+    sy += ly;
+    sxx += lx * lx;
+    sxy += lx * ly;
+  }
+  const double n = double(samples.size());
+  return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+Sample convert(const unsigned cells)
+{
+  bench::GeneratorOptions options;
+  options.vertices = cells / 2;
+  options.edges = cells / 2;
+  const std::string data = bench::generateDiagram(options);
+  const unsigned char *const bytes = reinterpret_cast<const unsigned char *>(data.data());
+
+  Sample sample;
+  sample.cells = cells;
+  sample.time = HUGE_VAL;
+  for (unsigned run = 0; run < RUNS; ++run)
+  {
+    bench::NullPainter painter;
+    librevenge::RVNGStringStream input(bytes, unsigned(data.size()));
+    const unsigned long allocationsBefore = allocations;
+    const unsigned long long bytesBefore = allocatedBytes;
+    const Clock::time_point start = Clock::now();
+    const libdrawio::DRAWIODocument::Result result = libdrawio::DRAWIODocument::parse(&input, &painter);
+    const double time = std::chrono::duration<double>(Clock::now() - start).count();
+    CPPUNIT_ASSERT_EQUAL(libdrawio::DRAWIODocument::RESULT_OK, result);
+    sample.time = std::min(sample.time, time);
+    // the conversion is deterministic, so any run gives the same counts
+    sample.allocations = double(allocations - allocationsBefore);
+    sample.bytes = double(allocatedBytes - bytesBefore);
+  }
+  return sample;
+}
+
+}
+
+class ScalingTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp() override;
+  virtual void tearDown() override;
+
+private:
+  CPPUNIT_TEST_SUITE(ScalingTest);
+  CPPUNIT_TEST(testGrowth);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testGrowth();
+};
+
+void ScalingTest::setUp()
+{
+}
+
+void ScalingTest::tearDown()
+{
+}
+
+void ScalingTest::testGrowth()
+{
+  std::vector<Sample> samples;
+  for (const unsigned cells : SIZES)
+  {
+    samples.push_back(convert(cells));
+    const Sample &sample = samples.back();
+    fprintf(stderr, "%6.0f cells: %9.3f ms %10.0f allocations %12.0f bytes\n",
+            sample.cells, sample.time * 1e3, sample.allocations, sample.bytes);
+  }
+
+  const double timeExponent = fitExponent(samples, &Sample::time);
+  const double allocationExponent = fitExponent(samples, &Sample::allocations);
+  const double byteExponent = fitExponent(samples, &Sample::bytes);
+  fprintf(stderr, "growth exponents: time %.3f, allocations %.3f, bytes %.3f\n",
+          timeExponent, allocationExponent, byteExponent);
+
+  CPPUNIT_ASSERT_MESSAGE("conversion time grows super-linearly", timeExponent <= MAX_EXPONENT);
+  CPPUNIT_ASSERT_MESSAGE("allocation count grows super-linearly", allocationExponent <= MAX_EXPONENT);
+  CPPUNIT_ASSERT_MESSAGE("allocated bytes grow super-linearly", byteExponent <= MAX_EXPONENT);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ScalingTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */